@@ -0,0 +1,115 @@
+#include "Cli/BatchOptions.h"
+#include "Utils/Config.h"
+
+namespace {
+juce::File resolvePath(const juce::String &path) {
+    return juce::File::getCurrentWorkingDirectory().getChildFile(path.unquoted());
+}
+
+bool parseThreshold(const juce::String &text, float &threshold) {
+    if (!text.containsOnly("0123456789.") || text.isEmpty())
+        return false;
+
+    threshold = text.getFloatValue();
+    return threshold >= 0.0f && threshold <= 1.0f;
+}
+} // namespace
+
+BatchOptions::BatchOptions()
+    : thresholdIn(Config::Audio::silenceThresholdIn),
+      thresholdOut(Config::Audio::silenceThresholdOut),
+      numThreads(juce::SystemStats::getNumCpus()) {
+}
+
+juce::Result BatchOptions::parse(const juce::StringArray &args, BatchOptions &options) {
+    for (int i = 0; i < args.size(); ++i) {
+        const juce::String &arg = args[i];
+
+        // Every value-taking option reads the next argument.
+        const auto nextValue = [&](juce::String &value) {
+            if (i + 1 >= args.size())
+                return false;
+            value = args[++i];
+            return true;
+        };
+        juce::String value;
+
+        if (arg == "-h" || arg == "--help") {
+            options.showHelp = true;
+        } else if (arg == "-r" || arg == "--recursive") {
+            options.recursive = true;
+        } else if (arg == "--no-in") {
+            options.detectIn = false;
+        } else if (arg == "--no-out") {
+            options.detectOut = false;
+        } else if (arg == "--threshold-in") {
+            if (!nextValue(value) || !parseThreshold(value, options.thresholdIn))
+                return juce::Result::fail("--threshold-in expects a value between 0 and 1");
+        } else if (arg == "--threshold-out") {
+            if (!nextValue(value) || !parseThreshold(value, options.thresholdOut))
+                return juce::Result::fail("--threshold-out expects a value between 0 and 1");
+        } else if (arg == "--format") {
+            if (!nextValue(value))
+                return juce::Result::fail("--format expects json or csv");
+            if (value.equalsIgnoreCase("json"))
+                options.format = Format::Json;
+            else if (value.equalsIgnoreCase("csv"))
+                options.format = Format::Csv;
+            else
+                return juce::Result::fail("Unknown format: " + value);
+        } else if (arg == "-o" || arg == "--output") {
+            if (!nextValue(value))
+                return juce::Result::fail(arg + " expects a file");
+            options.outputFile = resolvePath(value);
+        } else if (arg == "--trim-dir") {
+            if (!nextValue(value))
+                return juce::Result::fail("--trim-dir expects a directory");
+            options.trimDirectory = resolvePath(value);
+        } else if (arg == "-j" || arg == "--threads") {
+            if (!nextValue(value) || !value.containsOnly("0123456789") || value.getIntValue() < 1)
+                return juce::Result::fail(arg + " expects a positive number");
+            options.numThreads = value.getIntValue();
+        } else if (arg == "--list") {
+            if (!nextValue(value))
+                return juce::Result::fail("--list expects a file");
+
+            const juce::File listFile = resolvePath(value);
+            if (!listFile.existsAsFile())
+                return juce::Result::fail("Cannot read list file: " + listFile.getFullPathName());
+
+            juce::StringArray lines;
+            listFile.readLines(lines);
+            for (const auto &line : lines)
+                if (line.trim().isNotEmpty())
+                    options.inputs.add(resolvePath(line.trim()));
+        } else if (arg.startsWith("-")) {
+            return juce::Result::fail("Unknown option: " + arg);
+        } else {
+            options.inputs.add(resolvePath(arg));
+        }
+    }
+
+    if (!options.detectIn && !options.detectOut)
+        return juce::Result::fail("--no-in and --no-out leave nothing to detect");
+    if (options.inputs.isEmpty() && !options.showHelp)
+        return juce::Result::fail("No input files or directories given");
+
+    return juce::Result::ok();
+}
+
+juce::String BatchOptions::getUsage() {
+    return "Usage: audiofiler-cli [options] <file-or-directory>...\n"
+           "\n"
+           "Detects silence boundaries (cut in/out) of every audio file and reports them.\n"
+           "\n"
+           "  --list <file>           Read further inputs from a file, one path per line\n"
+           "  -r, --recursive         Descend into subdirectories\n"
+           "  --threshold-in <v>      Cut-in threshold, 0..1\n"
+           "  --threshold-out <v>     Cut-out threshold, 0..1\n"
+           "  --no-in, --no-out       Skip one of the two detections\n"
+           "  --format json|csv       Report format (default json)\n"
+           "  -o, --output <file>     Write the report to a file instead of stdout\n"
+           "  --trim-dir <dir>        Also write a WAV copy of every file trimmed to its cuts\n"
+           "  -j, --threads <n>       Files analysed in parallel (default: CPU count)\n"
+           "  -h, --help              Show this text\n";
+}
@@ -0,0 +1,53 @@
+#ifndef AUDIOFILER_BATCHOPTIONS_H
+#define AUDIOFILER_BATCHOPTIONS_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+/**
+ * @file BatchOptions.h
+ * @ingroup Helpers
+ * @brief Command-line settings of the `audiofiler-cli` batch tool.
+ * @details Parsed from the raw argument list, so the tool stays a thin `main()` and the parsing
+ *          can be tested headless. Defaults match the GUI's auto-cut defaults in `Config`.
+ *
+ * @see BatchProcessor
+ * @see BatchReport
+ */
+struct BatchOptions {
+    enum class Format { Json, Csv };
+
+    /** Files and directories given on the command line or via `--list`. */
+    juce::Array<juce::File> inputs;
+    bool recursive{false};
+
+    bool detectIn{true};
+    bool detectOut{true};
+    float thresholdIn;
+    float thresholdOut;
+
+    Format format{Format::Json};
+    /** Report destination; empty means standard output. */
+    juce::File outputFile;
+    /** Directory for trimmed copies; empty means no trimming. */
+    juce::File trimDirectory;
+
+    int numThreads;
+    bool showHelp{false};
+
+    BatchOptions();
+
+    /**
+     * @brief Parses the arguments that follow the executable name.
+     * @return An error naming the offending argument, or `juce::Result::ok()`.
+     */
+    static juce::Result parse(const juce::StringArray &args, BatchOptions &options);
+
+    /** @brief The usage text printed for `--help` and after a parse error. */
+    static juce::String getUsage();
+};
+
+#endif
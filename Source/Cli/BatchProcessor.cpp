@@ -0,0 +1,157 @@
+#include "Cli/BatchProcessor.h"
+#include "Core/AudioReaderFactory.h"
+#include "Core/FileMetadata.h"
+#include "Core/SessionState.h"
+#include "Utils/ContentFingerprint.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+/** Serialises picking unique names for trimmed copies across worker threads. */
+juce::CriticalSection trimNameLock;
+} // namespace
+
+BatchProcessor::BatchProcessor(juce::AudioFormatManager &manager, SessionState &state,
+                               const BatchOptions &optionsIn)
+    : formatManager(manager), sessionState(state), options(optionsIn),
+      renderer(manager, optionsIn.numThreads) {
+}
+
+juce::Array<juce::File> BatchProcessor::collectFiles() const {
+    juce::Array<juce::File> files;
+    const juce::String wildcard = formatManager.getWildcardForAllFormats();
+
+    for (const auto &input : options.inputs) {
+        if (input.isDirectory())
+            files.addArray(input.findChildFiles(juce::File::findFiles, options.recursive,
+                                                wildcard));
+        else
+            files.add(input); // Missing files are reported per file, not dropped.
+    }
+
+    std::sort(files.begin(), files.end());
+    files.removeRange((int)(std::unique(files.begin(), files.end()) - files.begin()),
+                      files.size());
+    return files;
+}
+
+std::vector<BatchProcessor::FileResult>
+BatchProcessor::run(const juce::Array<juce::File> &files, const ProgressCallback &onProgress) {
+    const int total = files.size();
+    std::vector<FileResult> results((size_t)total);
+    if (total == 0)
+        return results;
+
+    juce::ThreadPool pool(juce::ThreadPoolOptions()
+                              .withThreadName("BatchCut")
+                              .withNumberOfThreads(juce::jmin(options.numThreads, total)));
+    std::atomic<int> numDone{0};
+    juce::WaitableEvent finished(true);
+
+    for (int i = 0; i < total; ++i) {
+        pool.addJob([this, &files, &results, &numDone, &finished, &onProgress, total, i] {
+            FileResult &result = results[(size_t)i];
+            result = processFile(files[i]);
+
+            const int done = ++numDone;
+            if (onProgress != nullptr)
+                onProgress(result, done, total);
+            if (done == total)
+                finished.signal();
+        });
+    }
+
+    finished.wait(-1);
+    return results;
+}
+
+BatchProcessor::FileResult BatchProcessor::processFile(const juce::File &file) const {
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    FileResult result;
+    result.file = file;
+
+    auto reader = AudioReaderFactory::createReader(formatManager, file);
+    if (reader == nullptr) {
+        result.error = file.existsAsFile() ? "Unsupported or unreadable audio file"
+                                           : "File not found";
+    } else if (reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0) {
+        result.error = "Audio file has zero length";
+    } else {
+        result.sampleRate = reader->sampleRate;
+        result.lengthInSamples = reader->lengthInSamples;
+        result.cutOutSample = reader->lengthInSamples;
+
+        if (options.detectIn) {
+            const juce::int64 hit =
+                SilenceAnalysisAlgorithms::findSilenceIn(*reader, options.thresholdIn);
+            result.inFound = hit >= 0;
+            if (result.inFound)
+                result.cutInSample = hit;
+        }
+
+        if (options.detectOut) {
+            const juce::int64 hit =
+                SilenceAnalysisAlgorithms::findSilenceOut(*reader, options.thresholdOut);
+            result.outFound = hit >= 0;
+            if (result.outFound)
+                result.cutOutSample = SilenceAnalysisAlgorithms::cutOutWithTail(
+                    hit, result.sampleRate, result.lengthInSamples);
+        }
+
+        result.contentKey = ContentFingerprint::compute(file);
+
+        FileMetadata metadata;
+        metadata.cutIn = (double)result.cutInSample / result.sampleRate;
+        metadata.cutOut = (double)result.cutOutSample / result.sampleRate;
+        metadata.isAnalyzed = true;
+        metadata.hash = result.contentKey;
+        sessionState.setMetadataForFile(file.getFullPathName(), metadata);
+
+        if (options.trimDirectory != juce::File()) {
+            const juce::Result trimmed = writeTrimmedCopy(result);
+            if (trimmed.failed())
+                result.error = trimmed.getErrorMessage();
+        }
+    }
+
+    result.latencyMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    return result;
+}
+
+juce::Result BatchProcessor::writeTrimmedCopy(FileResult &result) const {
+    const juce::int64 numSamples = result.cutOutSample - result.cutInSample;
+    if (numSamples <= 0)
+        return juce::Result::fail("Nothing left to write after trimming");
+
+    juce::File target;
+    {
+        const juce::ScopedLock lock(trimNameLock);
+        if (options.trimDirectory.createDirectory().failed())
+            return juce::Result::fail("Cannot create " + options.trimDirectory.getFullPathName());
+
+        // Same-named files from different folders get numbered instead of overwritten.
+        target = options.trimDirectory.getNonexistentChildFile(
+            result.file.getFileNameWithoutExtension(), ".wav", false);
+        if (target.create().failed())
+            return juce::Result::fail("Cannot create " + target.getFullPathName());
+    }
+
+    RegionRenderer::Request request;
+    request.source = result.file;
+    request.destination = target;
+    request.startSample = result.cutInSample;
+    request.endSample = result.cutOutSample;
+
+    // WAV sources take the renderer's byte-copy path; nothing is decoded or re-encoded.
+    const juce::Result rendered = renderer.render(request);
+    if (rendered.failed()) {
+        target.deleteFile();
+        return rendered;
+    }
+
+    result.trimmedFile = target;
+    return juce::Result::ok();
+}
@@ -0,0 +1,85 @@
+#ifndef AUDIOFILER_BATCHPROCESSOR_H
+#define AUDIOFILER_BATCHPROCESSOR_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Cli/BatchOptions.h"
+#include "Core/RegionRenderer.h"
+#include <functional>
+#include <vector>
+
+class SessionState;
+
+/**
+ * @file BatchProcessor.h
+ * @ingroup Threading
+ * @brief Runs cut-point detection over many files on a thread pool.
+ * @details Each file is one job with its own reader from `AudioReaderFactory`, scanned with
+ *          `SilenceAnalysisAlgorithms` exactly as the GUI does, so a batch cut matches the one
+ *          the app would set. Parallelism is across files rather than within one, which keeps
+ *          every core busy on large batches without per-file coordination. Finished cuts are
+ *          written to `SessionState`'s metadata pool, the same place the GUI keeps them.
+ *
+ * @see BatchOptions
+ * @see BatchReport
+ * @see SilenceAnalysisAlgorithms
+ */
+class BatchProcessor {
+  public:
+    struct FileResult {
+        juce::File file;
+        /** Empty on success. */
+        juce::String error;
+        juce::String contentKey;
+
+        double sampleRate{0.0};
+        juce::int64 lengthInSamples{0};
+
+        /** Cut positions in samples; the whole file when nothing audible was found. */
+        juce::int64 cutInSample{0};
+        juce::int64 cutOutSample{0};
+        bool inFound{false};
+        bool outFound{false};
+
+        juce::File trimmedFile;
+        /** Wall time spent on this file, including the optional trim. */
+        double latencyMs{0.0};
+
+        bool succeeded() const {
+            return error.isEmpty();
+        }
+    };
+
+    /** @brief Called on a worker thread after every file, e.g. for progress output. */
+    using ProgressCallback = std::function<void(const FileResult &result, int numDone, int total)>;
+
+    BatchProcessor(juce::AudioFormatManager &formatManager, SessionState &sessionState,
+                   const BatchOptions &options);
+
+    /** @brief Expands the option inputs into a sorted, duplicate-free list of audio files. */
+    juce::Array<juce::File> collectFiles() const;
+
+    /** @brief Processes every file and returns the results in input order. Blocks. */
+    std::vector<FileResult> run(const juce::Array<juce::File> &files,
+                                const ProgressCallback &onProgress = {});
+
+    /** @brief Processes one file on the calling thread. */
+    FileResult processFile(const juce::File &file) const;
+
+  private:
+    juce::Result writeTrimmedCopy(FileResult &result) const;
+
+    juce::AudioFormatManager &formatManager;
+    SessionState &sessionState;
+    const BatchOptions &options;
+    RegionRenderer renderer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchProcessor)
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "Cli/BatchReport.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+double toSeconds(juce::int64 sample, double sampleRate) {
+    return sampleRate > 0.0 ? (double)sample / sampleRate : 0.0;
+}
+
+juce::String csvField(const juce::String &text) {
+    if (!text.containsAnyOf(",\"\r\n"))
+        return text;
+    return "\"" + text.replace("\"", "\"\"") + "\"";
+}
+
+/** Nearest-rank percentile of an ascending list. */
+double percentile(const std::vector<double> &sorted, double fraction) {
+    const size_t rank = (size_t)std::ceil(fraction * (double)sorted.size());
+    return sorted[juce::jlimit((size_t)1, sorted.size(), rank) - 1];
+}
+} // namespace
+
+juce::String BatchReport::toJson(const Results &results) {
+    juce::Array<juce::var> entries;
+
+    for (const auto &result : results) {
+        auto *entry = new juce::DynamicObject();
+        entry->setProperty("file", result.file.getFullPathName());
+        entry->setProperty("ok", result.succeeded());
+
+        if (result.succeeded()) {
+            entry->setProperty("contentKey", result.contentKey);
+            entry->setProperty("sampleRate", result.sampleRate);
+            entry->setProperty("lengthInSamples", result.lengthInSamples);
+            entry->setProperty("cutInSample", result.cutInSample);
+            entry->setProperty("cutOutSample", result.cutOutSample);
+            entry->setProperty("cutIn", toSeconds(result.cutInSample, result.sampleRate));
+            entry->setProperty("cutOut", toSeconds(result.cutOutSample, result.sampleRate));
+            entry->setProperty("inFound", result.inFound);
+            entry->setProperty("outFound", result.outFound);
+            if (result.trimmedFile != juce::File())
+                entry->setProperty("trimmedFile", result.trimmedFile.getFullPathName());
+        } else {
+            entry->setProperty("error", result.error);
+        }
+
+        entry->setProperty("latencyMs", result.latencyMs);
+        entries.add(juce::var(entry));
+    }
+
+    return juce::JSON::toString(juce::var(entries));
+}
+
+juce::String BatchReport::toCsv(const Results &results) {
+    juce::String csv = "file,ok,content_key,sample_rate,length_samples,cut_in_sample,"
+                       "cut_out_sample,cut_in_seconds,cut_out_seconds,in_found,out_found,"
+                       "trimmed_file,latency_ms,error\r\n";
+
+    for (const auto &result : results) {
+        const bool ok = result.succeeded();
+        juce::StringArray fields;
+        fields.add(csvField(result.file.getFullPathName()));
+        fields.add(ok ? "1" : "0");
+        fields.add(result.contentKey);
+        fields.add(ok ? juce::String(result.sampleRate) : juce::String());
+        fields.add(ok ? juce::String(result.lengthInSamples) : juce::String());
+        fields.add(ok ? juce::String(result.cutInSample) : juce::String());
+        fields.add(ok ? juce::String(result.cutOutSample) : juce::String());
+        fields.add(ok ? juce::String(toSeconds(result.cutInSample, result.sampleRate), 6)
+                      : juce::String());
+        fields.add(ok ? juce::String(toSeconds(result.cutOutSample, result.sampleRate), 6)
+                      : juce::String());
+        fields.add(ok ? juce::String((int)result.inFound) : juce::String());
+        fields.add(ok ? juce::String((int)result.outFound) : juce::String());
+        fields.add(result.trimmedFile != juce::File()
+                       ? csvField(result.trimmedFile.getFullPathName())
+                       : juce::String());
+        fields.add(juce::String(result.latencyMs, 3));
+        fields.add(csvField(result.error));
+        csv << fields.joinIntoString(",") << "\r\n";
+    }
+
+    return csv;
+}
+
+juce::String BatchReport::summarise(const Results &results, double wallTimeMs) {
+    std::vector<double> latencies;
+    int numFailed = 0;
+    for (const auto &result : results) {
+        latencies.push_back(result.latencyMs);
+        if (!result.succeeded())
+            ++numFailed;
+    }
+
+    juce::String text;
+    text << "Files: " << (int)results.size() << " (" << numFailed << " failed)\n";
+    text << "Wall time: " << juce::String(wallTimeMs / 1000.0, 3) << " s\n";
+
+    if (latencies.empty())
+        return text;
+
+    const double filesPerSecond =
+        wallTimeMs > 0.0 ? (double)results.size() / (wallTimeMs / 1000.0) : 0.0;
+    std::sort(latencies.begin(), latencies.end());
+    double totalMs = 0.0;
+    for (const double latency : latencies)
+        totalMs += latency;
+
+    text << "Throughput: " << juce::String(filesPerSecond, 2) << " files/s\n";
+    text << "Latency per file (ms): mean " << juce::String(totalMs / (double)latencies.size(), 2)
+         << ", p50 " << juce::String(percentile(latencies, 0.50), 2) << ", p95 "
+         << juce::String(percentile(latencies, 0.95), 2) << ", max "
+         << juce::String(latencies.back(), 2) << "\n";
+    return text;
+}
@@ -0,0 +1,39 @@
+#ifndef AUDIOFILER_BATCHREPORT_H
+#define AUDIOFILER_BATCHREPORT_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Cli/BatchProcessor.h"
+#include <vector>
+
+/**
+ * @file BatchReport.h
+ * @ingroup Helpers
+ * @brief Formats the results of a batch run as JSON, CSV and a throughput summary.
+ * @details Pure string formatting with no I/O, so every format is unit-testable. Cut points
+ *          are reported both in samples (exact) and in seconds (what the GUI displays).
+ *
+ * @see BatchProcessor
+ */
+class BatchReport {
+  public:
+    using Results = std::vector<BatchProcessor::FileResult>;
+
+    /** @brief A JSON array with one object per file. */
+    static juce::String toJson(const Results &results);
+
+    /** @brief RFC 4180 CSV with a header row and one row per file. */
+    static juce::String toCsv(const Results &results);
+
+    /**
+     * @brief Human-readable totals: files per second and per-file latency percentiles.
+     * @param wallTimeMs Elapsed time of the whole run, which overlaps the per-file latencies.
+     */
+    static juce::String summarise(const Results &results, double wallTimeMs);
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "Cli/BatchOptions.h"
+#include "Cli/BatchProcessor.h"
+#include "Cli/BatchReport.h"
+#include "Core/AudioPlayer.h"
+#include "Core/SessionState.h"
+
+#include <iostream>
+#include <mutex>
+
+int main(int argc, char *argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::CharPointer_UTF8(argv[i]));
+
+    BatchOptions options;
+    const juce::Result parsed = BatchOptions::parse(args, options);
+    if (parsed.failed()) {
+        std::cerr << parsed.getErrorMessage().toStdString() << "\n\n"
+                  << BatchOptions::getUsage().toStdString();
+        return 2;
+    }
+    if (options.showHelp) {
+        std::cout << BatchOptions::getUsage().toStdString();
+        return 0;
+    }
+
+    // The player is never started; it supplies the same registered formats the app reads.
+    SessionState sessionState;
+    AudioPlayer audioPlayer(sessionState);
+    BatchProcessor processor(audioPlayer.getFormatManager(), sessionState, options);
+
+    const juce::Array<juce::File> files = processor.collectFiles();
+    std::mutex progressMutex;
+
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    const auto results =
+        processor.run(files, [&progressMutex](const BatchProcessor::FileResult &result,
+                                              int numDone, int total) {
+            const std::lock_guard<std::mutex> lock(progressMutex);
+            std::cerr << "[" << numDone << "/" << total << "] "
+                      << result.file.getFullPathName().toStdString();
+            if (!result.succeeded())
+                std::cerr << "  FAILED: " << result.error.toStdString();
+            std::cerr << "\n";
+        });
+    const double wallTimeMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+
+    const juce::String report = options.format == BatchOptions::Format::Json
+                                    ? BatchReport::toJson(results)
+                                    : BatchReport::toCsv(results);
+
+    if (options.outputFile != juce::File()) {
+        if (!options.outputFile.replaceWithText(report)) {
+            std::cerr << "Cannot write " << options.outputFile.getFullPathName().toStdString()
+                      << "\n";
+            return 1;
+        }
+    } else {
+        std::cout << report.toStdString() << "\n";
+    }
+
+    std::cerr << BatchReport::summarise(results, wallTimeMs).toStdString();
+
+    for (const auto &result : results)
+        if (!result.succeeded())
+            return 1;
+    return 0;
+}
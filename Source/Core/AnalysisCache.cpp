@@ -0,0 +1,196 @@
+#include "Core/AnalysisCache.h"
+#include "Utils/Config.h"
+
+#include <cstring>
+
+namespace {
+constexpr char kMagic[4] = {'A', 'F', 'A', 'C'};
+constexpr juce::uint32 kVersion = 1;
+constexpr juce::uint32 kFlagHasEnvelope = 1u << 0;
+constexpr juce::uint32 kFlagAnalyzed = 1u << 1;
+constexpr int kHashCapacity = 48;
+
+/** On-disk header, written in native byte order; a foreign byte order fails the version check. */
+struct CacheHeader {
+    char magic[4];
+    juce::uint32 version;
+    juce::uint32 headerSize;
+    juce::uint32 flags;
+    juce::int64 lengthInSamples;
+    double sampleRate;
+    juce::int32 numChannels;
+    juce::int32 baseBlockSize;
+    juce::int32 levelRatio;
+    juce::int32 numLevels;
+    double cutIn;
+    double cutOut;
+    juce::uint64 envelopeFloats;
+    char hash[kHashCapacity];
+    char reserved[8];
+};
+
+static_assert(sizeof(CacheHeader) == 128, "Cache header layout must stay fixed");
+
+CacheHeader makeHeader(const juce::String &key, const FileMetadata &metadata,
+                       const EnvelopeIndex *envelope) {
+    CacheHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.headerSize = (juce::uint32)sizeof(CacheHeader);
+    header.flags = metadata.isAnalyzed ? kFlagAnalyzed : 0u;
+    header.baseBlockSize = Config::Audio::envelopeBaseBlockSize;
+    header.levelRatio = Config::Audio::envelopeLevelRatio;
+    header.numLevels = Config::Audio::envelopeNumLevels;
+    header.cutIn = metadata.cutIn;
+    header.cutOut = metadata.cutOut;
+    key.copyToUTF8(header.hash, (size_t)kHashCapacity);
+
+    if (envelope != nullptr && envelope->isComplete()) {
+        header.flags |= kFlagHasEnvelope;
+        header.lengthInSamples = envelope->getLengthInSamples();
+        header.sampleRate = envelope->getSampleRate();
+        header.numChannels = envelope->getNumChannels();
+        header.envelopeFloats = (juce::uint64)envelope->getRawDataSize();
+    }
+    return header;
+}
+
+bool isHeaderValid(const CacheHeader &header, const juce::String &key, size_t fileSize) {
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.headerSize != sizeof(CacheHeader))
+        return false;
+
+    if (juce::String::fromUTF8(header.hash, (int)strnlen(header.hash, kHashCapacity)) != key)
+        return false;
+
+    if ((header.flags & kFlagHasEnvelope) == 0)
+        return true;
+
+    return header.baseBlockSize == Config::Audio::envelopeBaseBlockSize &&
+           header.levelRatio == Config::Audio::envelopeLevelRatio &&
+           header.numLevels == Config::Audio::envelopeNumLevels && header.numChannels > 0 &&
+           header.lengthInSamples > 0 &&
+           fileSize >= sizeof(CacheHeader) + header.envelopeFloats * sizeof(float);
+}
+
+bool writeAtomically(const juce::File &target, const void *headerData, size_t headerSize,
+                     const void *payload, size_t payloadSize) {
+    juce::TemporaryFile temp(target);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return false;
+        if (!out.write(headerData, headerSize))
+            return false;
+        if (payloadSize > 0 && !out.write(payload, payloadSize))
+            return false;
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+    return temp.overwriteTargetFileWithTemporary();
+}
+} // namespace
+
+AnalysisCache::AnalysisCache(const juce::File &directoryIn) : directory(directoryIn) {
+}
+
+juce::File AnalysisCache::getDefaultDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("audiofiler")
+        .getChildFile("AnalysisCache");
+}
+
+juce::File AnalysisCache::getEntryFile(const juce::String &key) const {
+    return directory.getChildFile(key + ".afcache");
+}
+
+bool AnalysisCache::load(const juce::String &key, Entry &entryOut) const {
+    const juce::File file = getEntryFile(key);
+    if (key.isEmpty() || !file.existsAsFile())
+        return false;
+
+    auto mapping =
+        std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (mapping->getData() == nullptr || mapping->getSize() < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader header;
+    std::memcpy(&header, mapping->getData(), sizeof(CacheHeader));
+    if (!isHeaderValid(header, key, mapping->getSize()))
+        return false;
+
+    Entry entry;
+    entry.metadata.cutIn = header.cutIn;
+    entry.metadata.cutOut = header.cutOut;
+    entry.metadata.isAnalyzed = (header.flags & kFlagAnalyzed) != 0;
+    entry.metadata.hash = key;
+
+    if ((header.flags & kFlagHasEnvelope) != 0) {
+        auto envelope = EnvelopeIndex::fromMappedFile(std::move(mapping), sizeof(CacheHeader),
+                                                      header.numChannels, header.lengthInSamples,
+                                                      header.sampleRate);
+        if (envelope == nullptr || envelope->getRawDataSize() != header.envelopeFloats)
+            return false;
+        entry.envelope = std::move(envelope);
+    }
+
+    entryOut = std::move(entry);
+    return true;
+}
+
+bool AnalysisCache::store(const juce::String &key, const FileMetadata &metadata,
+                          const EnvelopeIndex *envelope) const {
+    if (key.isEmpty() || !directory.createDirectory().wasOk())
+        return false;
+
+    const CacheHeader header = makeHeader(key, metadata, envelope);
+    const bool withEnvelope = (header.flags & kFlagHasEnvelope) != 0;
+    return writeAtomically(getEntryFile(key), &header, sizeof(header),
+                           withEnvelope ? envelope->getRawData() : nullptr,
+                           withEnvelope ? envelope->getRawDataSize() * sizeof(float) : 0);
+}
+
+bool AnalysisCache::storeMetadata(const juce::String &key, const FileMetadata &metadata) const {
+    const juce::File file = getEntryFile(key);
+    if (key.isEmpty())
+        return false;
+
+    CacheHeader header{};
+    bool patchInPlace = false;
+    if (auto in = file.createInputStream()) {
+        patchInPlace = in->read(&header, (int)sizeof(header)) == (int)sizeof(header) &&
+                       isHeaderValid(header, key, (size_t)file.getSize());
+    }
+
+    if (!patchInPlace)
+        return store(key, metadata, nullptr);
+
+    header.cutIn = metadata.cutIn;
+    header.cutOut = metadata.cutOut;
+    header.flags = metadata.isAnalyzed ? (header.flags | kFlagAnalyzed)
+                                       : (header.flags & ~kFlagAnalyzed);
+
+    // Only the header changes; the envelope bytes (possibly mapped elsewhere) are untouched.
+    juce::FileOutputStream out(file);
+    if (!out.openedOk() || !out.setPosition(0))
+        return false;
+    out.write(&header, sizeof(header));
+    out.flush();
+    return out.getStatus().wasOk();
+}
+
+bool AnalysisCache::storeThumbnailData(const juce::String &key,
+                                       const juce::MemoryBlock &data) const {
+    if (key.isEmpty() || !directory.createDirectory().wasOk())
+        return false;
+
+    return writeAtomically(directory.getChildFile(key + ".afthumb"), data.getData(),
+                           data.getSize(), nullptr, 0);
+}
+
+bool AnalysisCache::loadThumbnailData(const juce::String &key, juce::MemoryBlock &dataOut) const {
+    const juce::File file = directory.getChildFile(key + ".afthumb");
+    return key.isNotEmpty() && file.existsAsFile() && file.loadFileAsData(dataOut) &&
+           dataOut.getSize() > 0;
+}
@@ -0,0 +1,72 @@
+#ifndef AUDIOFILER_ANALYSISCACHE_H
+#define AUDIOFILER_ANALYSISCACHE_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/EnvelopeIndex.h"
+#include "Core/FileMetadata.h"
+#include <memory>
+
+/**
+ * @file AnalysisCache.h
+ * @ingroup State
+ * @brief Persistent, memory-mappable sidecar cache of per-file analysis results.
+ * @details One binary file per audio file, named after its `ContentFingerprint` key (also
+ *          stored in `FileMetadata::hash`), so entries survive renames and moves. Each holds a
+ *          fixed-size header (cut points, analysis flag, envelope geometry) followed by the raw
+ *          `EnvelopeIndex` data. Loading maps the file and wraps the envelope in place, so
+ *          re-opening a processed file costs an mmap instead of a decode.
+ *
+ *          Files are written through a temporary file and renamed into place, so a reader never
+ *          observes a half-written entry. Entries whose geometry does not match the current
+ *          `Config::Audio` envelope settings are treated as misses.
+ *
+ * @see EnvelopeIndex
+ * @see FileMetadata
+ * @see ContentFingerprint
+ */
+class AnalysisCache {
+  public:
+    /** @brief A cache hit: the stored metadata and, if present, the mapped envelope. */
+    struct Entry {
+        FileMetadata metadata;
+        std::shared_ptr<const EnvelopeIndex> envelope;
+    };
+
+    explicit AnalysisCache(const juce::File &directory = getDefaultDirectory());
+
+    /** @brief `<user application data>/audiofiler/AnalysisCache`. */
+    static juce::File getDefaultDirectory();
+
+    /** @brief Looks up an entry; returns false on a miss or an invalid/stale file. */
+    bool load(const juce::String &key, Entry &entryOut) const;
+
+    /** @brief Writes metadata and (optionally) the envelope, replacing any existing entry. */
+    bool store(const juce::String &key, const FileMetadata &metadata,
+               const EnvelopeIndex *envelope) const;
+
+    /**
+     * @brief Updates only the metadata of an entry.
+     * @details Patches the header in place when an entry exists, keeping its envelope;
+     *          otherwise writes a metadata-only entry.
+     */
+    bool storeMetadata(const juce::String &key, const FileMetadata &metadata) const;
+
+    /** @brief Stores an opaque waveform-thumbnail blob next to the entry. */
+    bool storeThumbnailData(const juce::String &key, const juce::MemoryBlock &data) const;
+
+    /** @brief Loads the thumbnail blob stored by storeThumbnailData(). */
+    bool loadThumbnailData(const juce::String &key, juce::MemoryBlock &dataOut) const;
+
+    /** @brief Path of the entry file for a key. */
+    juce::File getEntryFile(const juce::String &key) const;
+
+  private:
+    juce::File directory;
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include "Core/AnalysisService.h"
+#include "Core/EnvelopeIndex.h"
+#include "Utils/Config.h"
+#include "Workers/ParallelSilenceScanner.h"
+#include "Workers/ScanScheduler.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+AnalysisService::AnalysisService(ReaderFactory readerFactory, EnvelopeProvider provider,
+                                 Delivery deliveryMode)
+    : createReader(std::move(readerFactory)), envelopeProvider(std::move(provider)),
+      delivery(deliveryMode),
+      scanPool(juce::ThreadPoolOptions()
+                   .withThreadName("SilenceScan")
+                   .withNumberOfThreads(juce::SystemStats::getNumCpus())
+                   .withDesiredThreadPriority(juce::Thread::Priority::low)),
+      inJobs(jobPoolOptions("AnalysisIn")), outJobs(jobPoolOptions("AnalysisOut")) {
+    lifeToken = std::make_shared<bool>(true);
+}
+
+AnalysisService::~AnalysisService() {
+    lifeToken.reset();
+    cancelAll();
+    inJobs.removeAllJobs(true, 4000);
+    outJobs.removeAllJobs(true, 4000);
+}
+
+juce::ThreadPoolOptions AnalysisService::jobPoolOptions(const juce::String &threadName) {
+    return juce::ThreadPoolOptions()
+        .withThreadName(threadName)
+        .withNumberOfThreads(1)
+        .withDesiredThreadPriority(ScanScheduler::priorityFor(AppEnums::ScanPolicy::Background));
+}
+
+bool AnalysisService::submit(const Request &request, ResultCallback onResult) {
+    const size_t index = slotIndex(request.kind);
+    juce::uint32 generation;
+    {
+        const juce::ScopedLock lock(slotLock);
+        Slot &slot = slots[index];
+        if (slot.pending && slot.request.file == request.file &&
+            slot.request.threshold == request.threshold)
+            return false;
+
+        // Latest wins: the running scan of this kind sees the new generation and stops.
+        generation = ++generations[index];
+        slot = {request, generation, true};
+    }
+
+    const AppEnums::ScanPolicy policy = scanPolicy.load();
+    jobPoolFor(request.kind)
+        .addJob([this, request, generation, policy, onResult = std::move(onResult)] {
+            runJob(request, generation, policy, onResult);
+        });
+    return true;
+}
+
+void AnalysisService::cancel(Kind kind) {
+    const size_t index = slotIndex(kind);
+    const juce::ScopedLock lock(slotLock);
+    ++generations[index];
+    slots[index] = {};
+}
+
+void AnalysisService::cancelAll() {
+    cancel(Kind::SilenceIn);
+    cancel(Kind::SilenceOut);
+}
+
+bool AnalysisService::isBusy(Kind kind) const {
+    const juce::ScopedLock lock(slotLock);
+    return slots[slotIndex(kind)].pending;
+}
+
+bool AnalysisService::isBusy() const {
+    return isBusy(Kind::SilenceIn) || isBusy(Kind::SilenceOut);
+}
+
+bool AnalysisService::release(Kind kind, juce::uint32 generation) {
+    const juce::ScopedLock lock(slotLock);
+    Slot &slot = slots[slotIndex(kind)];
+    if (!slot.pending || slot.generation != generation)
+        return false;
+
+    slot = {};
+    return true;
+}
+
+void AnalysisService::runJob(const Request &request, juce::uint32 generation,
+                             AppEnums::ScanPolicy policy, const ResultCallback &onResult) {
+    const Kind kind = request.kind;
+
+    // A superseded request may still be queued behind the one that replaced it.
+    if (isStale(kind, generation))
+        return;
+
+    // Checked once per chunk by every scan thread, so cancellation costs one atomic load.
+    const auto shouldExit = [this, kind, generation] { return isStale(kind, generation); };
+    const bool forward = kind == Kind::SilenceIn;
+
+    Result result;
+    result.request = request;
+    result.generation = generation;
+
+    if (auto reader = createReader(request.file)) {
+        result.readerOpened = true;
+        result.sampleRate = reader->sampleRate;
+        result.lengthInSamples = reader->lengthInSamples;
+
+        const auto envelope =
+            envelopeProvider != nullptr ? envelopeProvider(request.file, shouldExit) : nullptr;
+
+        result.sample = SilenceAnalysisAlgorithms::envelopeMismatch;
+        if (envelope != nullptr && envelope->getLengthInSamples() == reader->lengthInSamples) {
+            const float threshold = request.threshold;
+            result.sample =
+                forward ? SilenceAnalysisAlgorithms::findSilenceIn(*envelope, *reader, threshold)
+                        : SilenceAnalysisAlgorithms::findSilenceOut(*envelope, *reader, threshold);
+        }
+
+        // No envelope, or a stale one (e.g. a cache entry for a changed file): a full scan.
+        if (result.sample == SilenceAnalysisAlgorithms::envelopeMismatch) {
+            // Each segment job opens its own reader; mapped readers share the page cache.
+            const juce::File file = request.file;
+            ParallelSilenceScanner scanner(
+                scanPool, [this, file] { return createReader(file); }, policy);
+
+            result.sample = forward ? scanner.findSilenceIn(request.threshold, shouldExit)
+                                    : scanner.findSilenceOut(request.threshold, shouldExit);
+        }
+    }
+
+    if (!isStale(kind, generation))
+        deliver(result, onResult);
+}
+
+void AnalysisService::deliver(const Result &result, const ResultCallback &onResult) {
+    if (delivery == Delivery::WorkerThread) {
+        if (release(result.request.kind, result.generation) && onResult != nullptr)
+            onResult(result);
+        return;
+    }
+
+    std::weak_ptr<bool> weakToken = lifeToken;
+    juce::MessageManager::callAsync([this, weakToken, result, onResult] {
+        if (auto token = weakToken.lock()) {
+            // A newer request or a cancellation arrived while the result was in flight.
+            if (release(result.request.kind, result.generation) && onResult != nullptr)
+                onResult(result);
+        }
+    });
+}
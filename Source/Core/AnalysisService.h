@@ -0,0 +1,181 @@
+#ifndef AUDIOFILER_ANALYSISSERVICE_H
+#define AUDIOFILER_ANALYSISSERVICE_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/AppEnums.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class EnvelopeIndex;
+
+/**
+ * @file AnalysisService.h
+ * @ingroup Threading
+ * @brief Job queue that runs silence analyses of a file on background threads.
+ * @details Every request names a file, a kind (In or Out) and a threshold. Each kind has one
+ *          slot and one worker thread, so an In and an Out request run side by side instead
+ *          of one being dropped or waiting behind the other:
+ *
+ *          - a request identical to the one already pending in its slot is deduplicated;
+ *          - any other request supersedes it: the old job is cancelled at its next checkpoint
+ *            and its result is never delivered.
+ *
+ *          Jobs open private readers through the reader factory and coalesce onto the load-time
+ *          decode through the envelope provider (the same pass that feeds the thumbnail and the
+ *          statistics), so once the envelope exists a request reads a single block. Without an
+ *          envelope, long files fall back to a `ParallelSilenceScanner` on a shared pool.
+ *
+ *          Results are posted to the message thread via `juce::MessageManager::callAsync`,
+ *          guarded by a life token. Hosts without a running message thread (tests, batch tools)
+ *          may ask for delivery on the worker thread instead.
+ *
+ * @see ParallelSilenceScanner
+ * @see SilenceDetectionPresenter
+ * @see EnvelopeBuilder
+ */
+class AnalysisService {
+  public:
+    /** @brief What a job looks for. */
+    enum class Kind { SilenceIn, SilenceOut };
+
+    /** @brief Where result callbacks run. */
+    enum class Delivery { MessageThread, WorkerThread };
+
+    struct Request {
+        juce::File file;
+        Kind kind{Kind::SilenceIn};
+        float threshold{0.0f};
+    };
+
+    struct Result {
+        Request request;
+        /** The request's generation; results of older generations are never delivered. */
+        juce::uint32 generation{0};
+        /** First (In) or last (Out) sample above the threshold, or -1 if none. */
+        juce::int64 sample{-1};
+        double sampleRate{0.0};
+        juce::int64 lengthInSamples{0};
+        /** False if the file could not be opened. */
+        bool readerOpened{false};
+    };
+
+    /** @brief Opens a fresh, private reader of a file; called on worker threads. */
+    using ReaderFactory =
+        std::function<std::unique_ptr<juce::AudioFormatReader>(const juce::File &file)>;
+
+    /**
+     * @brief Returns the finished envelope of a file, or nullptr; called on worker threads.
+     * @details May block (e.g. AudioPlayer::waitForEnvelopeIndex) but must honour `shouldAbort`.
+     */
+    using EnvelopeProvider = std::function<std::shared_ptr<const EnvelopeIndex>(
+        const juce::File &file, const std::function<bool()> &shouldAbort)>;
+
+    using ResultCallback = std::function<void(const Result &result)>;
+
+    explicit AnalysisService(ReaderFactory createReader, EnvelopeProvider envelopeProvider = {},
+                             Delivery delivery = Delivery::MessageThread);
+
+    ~AnalysisService();
+
+    /**
+     * @brief Queues a request, superseding any other pending request of the same kind.
+     * @details Bumps the kind's generation, so a superseded scan stops at its next chunk and
+     *          its result is dropped even if it was already posted.
+     * @return False if an identical request was already pending and this one was dropped.
+     */
+    bool submit(const Request &request, ResultCallback onResult);
+
+    /** @brief Cancels the pending request of `kind`, if any; its result is discarded. */
+    void cancel(Kind kind);
+
+    /** @brief Cancels every pending request. */
+    void cancelAll();
+
+    /** @brief Returns true while a request of `kind` is pending or running. Any thread. */
+    bool isBusy(Kind kind) const;
+
+    /** @brief Returns true while any request is pending or running. Any thread. */
+    bool isBusy() const;
+
+    /** @brief The generation of the latest request (or cancellation) of `kind`. Any thread. */
+    juce::uint32 getGeneration(Kind kind) const {
+        return generations[slotIndex(kind)].load();
+    }
+
+    /**
+     * @brief Selects how full scans share the CPU; takes effect on the next submit().
+     * @see ScanScheduler
+     */
+    void setScanPolicy(AppEnums::ScanPolicy policy) {
+        scanPolicy.store(policy);
+    }
+
+    AppEnums::ScanPolicy getScanPolicy() const {
+        return scanPolicy.load();
+    }
+
+  private:
+    struct Slot {
+        Request request;
+        juce::uint32 generation{0};
+        bool pending{false};
+    };
+
+    void runJob(const Request &request, juce::uint32 generation, AppEnums::ScanPolicy policy,
+                const ResultCallback &onResult);
+
+    void deliver(const Result &result, const ResultCallback &onResult);
+
+    bool isStale(Kind kind, juce::uint32 generation) const {
+        return getGeneration(kind) != generation;
+    }
+
+    /** Clears the slot of `kind` if `generation` is still its latest; true if it was. */
+    bool release(Kind kind, juce::uint32 generation);
+
+    static size_t slotIndex(Kind kind) {
+        return kind == Kind::SilenceIn ? 0 : 1;
+    }
+
+    static juce::ThreadPoolOptions jobPoolOptions(const juce::String &threadName);
+
+    juce::ThreadPool &jobPoolFor(Kind kind) {
+        return kind == Kind::SilenceIn ? inJobs : outJobs;
+    }
+
+    ReaderFactory createReader;
+    EnvelopeProvider envelopeProvider;
+    const Delivery delivery;
+    std::atomic<AppEnums::ScanPolicy> scanPolicy{AppEnums::ScanPolicy::Background};
+
+    /** Bumped by every submit() and cancel(); read lock-free by running scans. */
+    std::array<std::atomic<juce::uint32>, 2> generations{};
+
+    juce::CriticalSection slotLock;
+    std::array<Slot, 2> slots;
+
+    /** Segment workers for full scans of long files, shared by all jobs. */
+    juce::ThreadPool scanPool;
+
+    /**
+     * One single-thread pool per kind, so In and Out never wait on each other. A superseded
+     * job only delays the next job of its own kind, until it reaches its next checkpoint.
+     */
+    juce::ThreadPool inJobs;
+    juce::ThreadPool outJobs;
+
+    std::shared_ptr<bool> lifeToken;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisService)
+};
+
+#endif
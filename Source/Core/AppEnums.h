@@ -12,6 +12,8 @@ enum class ChannelViewMode { Mono, Stereo };
 enum class ActiveZoomPoint { None, In, Out };
 
 enum class GroupPosition { Alone, Left, Middle, Right };
+
+enum class ScanPolicy { FullSpeed, Background, TimeBudgeted };
 } // namespace AppEnums
 
 #endif
@@ -4,23 +4,38 @@
  * @file AudioPlayer.cpp
  */
 #include "Core/AudioPlayer.h"
+#include "Core/AudioReaderFactory.h"
 #include "Core/FileMetadata.h"
 #include "Core/SessionState.h"
 #include "Utils/PlaybackHelpers.h"
 #include <algorithm>
 #include <cmath>
 
+namespace {
+/** Channels read ahead and resampled; the device output is stereo. */
+constexpr int kPlaybackChannels = 2;
+} // namespace
+
 AudioPlayer::AudioPlayer(SessionState &state)
 #if !defined(JUCE_HEADLESS)
     : waveformManager(formatManager),
 #else
     :
 #endif
-      readAheadThread("Audio File Reader"), sessionState(state) {
+      readAheadThread("Audio File Reader"),
+      retirePool(juce::ThreadPoolOptions()
+                     .withThreadName("PlaybackRetire")
+                     .withNumberOfThreads(1)),
+      envelopeBuilder(formatManager),
+      loadPool(juce::ThreadPoolOptions()
+                   .withThreadName("FileLoad")
+                   .withNumberOfThreads(Config::Audio::fileLoadThreads)),
+      sessionState(state) {
+    lifeToken = std::make_shared<bool>(true);
     formatManager.registerBasicFormats();
     sessionState.addListener(this);
     readAheadThread.startThread();
-    transportSource.addChangeListener(this);
+    readAheadThread.addTimeSliceClient(this);
 
     lastAutoCutThresholdIn = sessionState.getCutPrefs().autoCut.thresholdIn;
     lastAutoCutThresholdOut = sessionState.getCutPrefs().autoCut.thresholdOut;
@@ -29,29 +44,115 @@ AudioPlayer::AudioPlayer(SessionState &state)
 }
 
 AudioPlayer::~AudioPlayer() {
+    lifeToken.reset();
+    cancelLoad();
+    loadPool.removeAllJobs(true, 4000);
     sessionState.removeListener(this);
-    transportSource.setSource(nullptr);
+    envelopeBuilder.shutdown();
+    persistCurrentMetadata(false);
+    readAheadThread.removeTimeSliceClient(this);
+    setPlaybackSource(nullptr);
+    retirePool.removeAllJobs(false, 4000);
     readAheadThread.stopThread(1000);
-    transportSource.removeChangeListener(this);
 }
 
 juce::Result AudioPlayer::loadFile(const juce::File &file) {
-    auto *reader = formatManager.createReaderFor(file);
+    cancelLoad();
+    return commitLoad(file, openFile(file));
+}
+
+AudioPlayer::OpenedFile AudioPlayer::openFile(const juce::File &file) {
+    OpenedFile opened;
+    opened.reader = AudioReaderFactory::createReader(formatManager, file);
+#if !defined(JUCE_HEADLESS)
+    if (opened.reader != nullptr)
+        opened.detailReader = AudioReaderFactory::createReader(formatManager, file);
+#endif
+    return opened;
+}
+
+void AudioPlayer::warmUp(const juce::File &file, juce::AudioFormatReader &reader) {
+    // Interning probes the metadata table here, so commitLoad finds the file in memory.
+    FileMetadata stored;
+    juce::int64 startSample = 0;
+    if (sessionState.getMetadata(sessionState.getFileId(file.getFullPathName()), stored))
+        startSample = juce::jlimit((juce::int64)0, reader.lengthInSamples,
+                                   (juce::int64)(stored.cutIn * reader.sampleRate));
+
+    // Pulls the pages playback starts from into the page cache, so the read-ahead thread's
+    // first blocks come from memory instead of the volume.
+    if (AudioReaderFactory::asMapped(&reader) != nullptr) {
+        AudioReaderFactory::prefault(&reader, startSample, Config::Audio::mappedPrefaultSamples);
+        return;
+    }
+    const int numSamples = (int)juce::jmin(reader.lengthInSamples - startSample,
+                                           (juce::int64)Config::Audio::readAheadBufferSize);
+    juce::AudioBuffer<float> warmup((int)reader.numChannels, juce::jmax(1, numSamples));
+    reader.read(&warmup, 0, numSamples, startSample, true, true);
+}
+
+void AudioPlayer::loadFileAsync(const juce::File &file, LoadCallback onLoaded) {
+    // Opens queued behind this one return as soon as they start; a running one finds out when
+    // it returns. Queued jobs are not removed, as that would run their cleanup on this thread.
+    const juce::uint32 generation = ++loadGeneration;
+
+    std::weak_ptr<bool> weakToken = lifeToken;
+    loadPool.addJob([this, file, onLoaded, generation, weakToken] {
+        const auto isCurrent = [this, generation] { return loadGeneration.load() == generation; };
+        if (!isCurrent())
+            return;
+
+        auto opened = std::make_shared<OpenedFile>(openFile(file));
+        if (opened->reader != nullptr && isCurrent())
+            warmUp(file, *opened->reader);
+        if (!isCurrent())
+            return;
+
+        juce::MessageManager::callAsync([this, file, onLoaded, generation, weakToken, opened] {
+            if (auto token = weakToken.lock()) {
+                if (loadGeneration.load() != generation)
+                    return;
+                deliveredGeneration = generation;
+                const juce::Result result = commitLoad(file, std::move(*opened));
+                if (onLoaded != nullptr)
+                    onLoaded(result);
+            }
+        });
+    });
+}
+
+void AudioPlayer::cancelLoad() {
+    deliveredGeneration = ++loadGeneration;
+}
+
+bool AudioPlayer::isLoading() const {
+    return loadGeneration.load() != deliveredGeneration;
+}
 
+juce::Result AudioPlayer::commitLoad(const juce::File &file, OpenedFile opened) {
+    auto &reader = opened.reader;
     if (reader != nullptr) {
+        // The previous decode winds down on its own; its waveform and cache callbacks are
+        // tied to its file and load, so nothing it still delivers reaches this one.
+        envelopeBuilder.cancelBuild();
+        persistCurrentMetadata(true);
+
         const juce::String filePath = file.getFullPathName();
-        const double totalDuration = (double)reader->lengthInSamples / reader->sampleRate;
+        const int numChannels = (int)reader->numChannels;
+        const double sampleRate = reader->sampleRate;
+        const juce::int64 lengthInSamples = reader->lengthInSamples;
+        const double totalDuration = (double)lengthInSamples / sampleRate;
         sessionState.setTotalDuration(totalDuration);
 
-        if (sessionState.hasMetadataForFile(filePath)) {
-            const FileMetadata cached = sessionState.getMetadataForFile(filePath);
-            sessionState.setMetadataForFile(filePath, cached);
-        } else {
-            FileMetadata metadata;
-            if (reader->sampleRate > 0.0)
+        const FileId fileId = sessionState.getFileId(filePath);
+        FileMetadata metadata;
+        loadedWithDefaults = !sessionState.getMetadata(fileId, metadata);
+        if (loadedWithDefaults) {
+            if (sampleRate > 0.0)
                 metadata.cutOut = totalDuration;
-            sessionState.setMetadataForFile(filePath, metadata);
+            loadDefaults = metadata;
         }
+        sessionState.setMetadata(fileId, metadata);
 
         lastAutoCutThresholdIn = sessionState.getCutPrefs().autoCut.thresholdIn;
         lastAutoCutThresholdOut = sessionState.getCutPrefs().autoCut.thresholdOut;
@@ -59,17 +160,36 @@ juce::Result AudioPlayer::loadFile(const juce::File &file) {
         lastAutoCutOutActive = sessionState.getCutPrefs().autoCut.outActive;
 
         loadedFile = file;
+        loadedFileId = fileId;
+        loadedFileKey.clear();
         {
-            std::lock_guard<std::mutex> lock(readerMutex);
-            auto newSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
-            transportSource.setSource(newSource.get(), Config::Audio::readAheadBufferSize,
-                                      &readAheadThread, reader->sampleRate);
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            pendingCachedMetadata.reset();
+        }
 #if !defined(JUCE_HEADLESS)
-            waveformManager.loadFile(file);
+        waveformLoad = waveformManager.beginStreamingLoad(numChannels, sampleRate, lengthInSamples);
+        waveformManager.setDetailReader(std::move(opened.detailReader));
 #endif
-            readerSource.reset(newSource.release());
-        }
-        setPlayheadPosition(sessionState.getCutPrefs().cutIn);
+        auto next = std::make_unique<PlaybackSource>();
+        next->sampleRate = sampleRate;
+        next->lengthInSamples = lengthInSamples;
+        next->source = std::make_unique<RepeatRegionSource>(
+            reader.release(), true,
+            (int)std::lround(sampleRate * Config::Audio::boundaryFadeSeconds),
+            Config::Audio::boundaryFadeCurve);
+
+        // The bundle gets its cut region and start position before the audio thread sees it.
+        const auto prefs = sessionState.getCutPrefs();
+        applyRepeatRegion(*next, prefs);
+        const auto startPosition =
+            (juce::int64)(clampToCut(prefs.cutIn, totalDuration) * sampleRate);
+        next->source->restartAt(startPosition);
+        // Mapped readers are buffered too: a page that is not resident would otherwise fault
+        // on the audio thread, and a cold cache or a network mount makes that a disk read.
+        // The buffer starts filling now and is not waited for.
+        attachBuffer(*next, *next->source, startPosition);
+        setPlaybackSource(std::move(next));
+        startEnvelopeBuild(file, numChannels, lengthInSamples);
 
         sessionState.setCurrentFilePath(filePath);
 
@@ -79,23 +199,165 @@ juce::Result AudioPlayer::loadFile(const juce::File &file) {
     return juce::Result::fail("Failed to read audio file: " + file.getFileName());
 }
 
+void AudioPlayer::persistCurrentMetadata(bool inBackground) {
+    if (loadedFileKey.isEmpty())
+        return;
+
+    FileMetadata metadata;
+    sessionState.getMetadata(loadedFileId, metadata);
+    if (!inBackground) {
+        analysisCache.storeMetadata(loadedFileKey, metadata);
+        return;
+    }
+    loadPool.addJob([this, key = loadedFileKey, metadata] {
+        analysisCache.storeMetadata(key, metadata);
+    });
+}
+
+void AudioPlayer::applyContentKey(const juce::String &filePath, const juce::String &contentKey) {
+    if (contentKey.isEmpty() || filePath != loadedFile.getFullPathName())
+        return;
+
+    loadedFileKey = contentKey;
+
+    std::optional<FileMetadata> cached;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (pendingCachedPath == filePath)
+            cached.swap(pendingCachedMetadata);
+    }
+
+    FileMetadata metadata;
+    sessionState.getMetadata(loadedFileId, metadata);
+
+    // Stored cut points replace the defaults chosen in loadFile, but never a user's edits.
+    const bool untouched = loadedWithDefaults && metadata.cutIn == loadDefaults.cutIn &&
+                           metadata.cutOut == loadDefaults.cutOut &&
+                           metadata.isAnalyzed == loadDefaults.isAnalyzed;
+    // Metadata kept from an earlier session describes other content if the file has changed.
+    const bool stale = metadata.hash.isNotEmpty() && metadata.hash != contentKey;
+    if (stale) {
+        metadata = FileMetadata{};
+        metadata.cutOut = sessionState.getTotalDuration();
+    }
+    if (cached.has_value() && (untouched || stale))
+        metadata = *cached;
+
+    metadata.hash = contentKey;
+    sessionState.setMetadata(loadedFileId, metadata);
+}
+
+void AudioPlayer::startEnvelopeBuild(const juce::File &file, int numChannels,
+                                     juce::int64 lengthInSamples) {
+    EnvelopeBuilder::Callbacks callbacks;
+    const juce::String filePath = file.getFullPathName();
+#if !defined(JUCE_HEADLESS)
+    const WaveformManager::LoadId load = waveformLoad;
+#endif
+
+    // Builder-thread callbacks: the builder is joined before this player is destroyed. A build
+    // superseded by the next load may still run them, so each is tied to its file and load.
+    callbacks.onLookup = [=](const juce::String &contentKey) {
+        AnalysisCache::Entry entry;
+        if (!analysisCache.load(contentKey, entry))
+            return std::shared_ptr<const EnvelopeIndex>();
+
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            pendingCachedPath = filePath;
+            pendingCachedMetadata = entry.metadata;
+        }
+
+        if (entry.envelope == nullptr || entry.envelope->getLengthInSamples() != lengthInSamples ||
+            entry.envelope->getNumChannels() != numChannels)
+            return std::shared_ptr<const EnvelopeIndex>();
+
+#if !defined(JUCE_HEADLESS)
+        // A failed restore leaves the waveform as it was, for the decode to fill.
+        juce::MemoryBlock thumbnailData;
+        if (!analysisCache.loadThumbnailData(contentKey, thumbnailData) ||
+            !waveformManager.loadFrom(load, thumbnailData))
+            return std::shared_ptr<const EnvelopeIndex>();
+#endif
+        return entry.envelope;
+    };
+
+    // One streaming decode feeds both the envelope index and the waveform pyramid; a strided
+    // preview shows the whole waveform before that decode gets far.
+#if !defined(JUCE_HEADLESS)
+    callbacks.onPreview = [this, load](juce::AudioFormatReader &reader,
+                                       const std::function<bool()> &shouldStop) {
+        waveformManager.buildPreview(load, reader, shouldStop);
+    };
+    callbacks.onBlock = [this, load](juce::int64 startSample,
+                                     const juce::AudioBuffer<float> &buffer, int numSamples) {
+        waveformManager.addBlock(load, startSample, buffer, numSamples);
+    };
+#endif
+
+    callbacks.onBuilt = [=](const juce::String &contentKey, const EnvelopeIndex &index) {
+        analysisCache.store(contentKey, sessionState.getMetadataForFile(filePath), &index);
+#if !defined(JUCE_HEADLESS)
+        juce::MemoryBlock thumbnailData;
+        if (waveformManager.saveTo(load, thumbnailData))
+            analysisCache.storeThumbnailData(contentKey, thumbnailData);
+#endif
+    };
+
+    callbacks.onComplete = [this, filePath](std::shared_ptr<const EnvelopeIndex>,
+                                            const juce::String &contentKey) {
+        applyContentKey(filePath, contentKey);
+        if (onEnvelopeReady != nullptr)
+            onEnvelopeReady();
+    };
+
+    envelopeBuilder.startBuild(file, std::move(callbacks));
+}
+
+std::shared_ptr<const EnvelopeIndex> AudioPlayer::getEnvelopeIndex() const {
+    return envelopeBuilder.getIndex();
+}
+
+std::shared_ptr<const EnvelopeIndex>
+AudioPlayer::waitForEnvelopeIndex(const juce::File &file,
+                                  const std::function<bool()> &shouldAbort) const {
+    return envelopeBuilder.waitForIndex(file, shouldAbort);
+}
+
 juce::File AudioPlayer::getLoadedFile() const {
     return loadedFile;
 }
 
 void AudioPlayer::togglePlayStop() {
-    if (transportSource.isPlaying())
-        transportSource.stop();
+    if (isPlaying())
+        stopPlayback();
     else
-        transportSource.start();
+        startPlayback();
 }
 
 bool AudioPlayer::isPlaying() const {
-    return transportSource.isPlaying();
+    return playing.load();
 }
 
 double AudioPlayer::getCurrentPosition() const {
-    return transportSource.getCurrentPosition();
+    const PlaybackSource *current = getPlaybackSource();
+    if (current == nullptr || current->sampleRate <= 0.0)
+        return 0.0;
+
+    const double sampleRate = current->sampleRate;
+    double position = (double)current->buffer->getPosition() / sampleRate;
+
+    double predicted = 0.0;
+    if (isPlaying() && playheadClock.predict(juce::Time::getMillisecondCounterHiRes(), predicted))
+        position = predicted;
+
+    // While repeating, the playback timeline runs on past cutOut; map it back into the file.
+    if (current->source == nullptr)
+        return position;
+
+    const juce::int64 filePosition =
+        current->source->toFilePosition((juce::int64)std::llround(position * sampleRate));
+    return (double)filePosition / sampleRate;
 }
 
 bool AudioPlayer::isRepeating() const {
@@ -104,6 +366,7 @@ bool AudioPlayer::isRepeating() const {
 
 void AudioPlayer::setRepeating(bool shouldRepeat) {
     repeating = shouldRepeat;
+    updateRepeatRegion(sessionState.getCutPrefs());
 }
 
 #if !defined(JUCE_HEADLESS)
@@ -121,15 +384,22 @@ const WaveformManager &AudioPlayer::getWaveformManager() const {
 #endif
 
 void AudioPlayer::startPlayback() {
-    transportSource.start();
+    if (getPlaybackSource() != nullptr && !playing.exchange(true))
+        sendChangeMessage();
 }
 
 void AudioPlayer::stopPlayback() {
-    transportSource.stop();
+    // The buffer has already been read up to a block past what was heard; park there instead,
+    // so the cursor does not jump when playback stops and resuming repeats nothing.
+    const double heardPosition = getCurrentPosition();
+    if (playing.exchange(false))
+        sendChangeMessage();
+    setPlayheadPosition(heardPosition);
 }
 
 void AudioPlayer::stopPlaybackAndReset() {
-    transportSource.stop();
+    if (playing.exchange(false))
+        sendChangeMessage();
     setPlayheadPosition(sessionState.getCutIn());
 }
 
@@ -138,78 +408,77 @@ juce::AudioFormatManager &AudioPlayer::getFormatManager() {
 }
 
 void AudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
-    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    blockSize = samplesPerBlockExpected;
+    outputSampleRate = sampleRate;
+    if (playbackSource != nullptr)
+        prepareBundle(*playbackSource);
 }
 
 void AudioPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) {
-    if (readerSource.get() == nullptr) {
-        bufferToFill.clearActiveBufferRegion();
-        return;
-    }
+    // Sequentially consistent with setPlaybackSource(): a callback that starts after a bundle
+    // was replaced loads the new one, and one already running keeps the count odd.
+    callbackCount.fetch_add(1);
+    renderBlock(liveSource.load(), bufferToFill);
+    callbackCount.fetch_add(1);
+}
 
-    const auto prefs = sessionState.getCutPrefs();
-    if (!prefs.active) {
-        transportSource.getNextAudioBlock(bufferToFill);
-        return;
+void AudioPlayer::renderBlock(PlaybackSource *current,
+                              const juce::AudioSourceChannelInfo &bufferToFill) {
+    if (current != renderedSource) {
+        renderedSource = current;
+        wasPlaying = false;
     }
-
-    double sampleRate = 0.0;
-    juce::int64 lengthInSamples = 0;
-    if (!getReaderInfo(sampleRate, lengthInSamples) || sampleRate <= 0.0) {
-        transportSource.getNextAudioBlock(bufferToFill);
+    if (current == nullptr || current->sampleRate <= 0.0) {
+        bufferToFill.clearActiveBufferRegion();
         return;
     }
 
-    const double cutIn = prefs.cutIn;
-    const double cutOut = prefs.cutOut;
-    const double startPos = transportSource.getCurrentPosition();
-
-    if (startPos >= cutOut) {
-        if (repeating) {
-            transportSource.setPosition(cutIn);
-            transportSource.start();
-            transportSource.getNextAudioBlock(bufferToFill);
-        } else {
-            transportSource.stop();
-            transportSource.setPosition(cutOut);
-            bufferToFill.clearActiveBufferRegion();
+    const auto blockGeneration = playheadClock.beginBlock();
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const bool shouldPlay = playing.load();
+
+    // A stop fades out what was already read before moving to where playback parked.
+    ReadAheadBuffer &buffer = *current->buffer;
+    if ((shouldPlay || !wasPlaying) && buffer.takeSeek())
+        current->resampler->flushBuffers();
+    const double positionSeconds = (double)buffer.getPosition() / current->sampleRate;
+
+    if (shouldPlay || wasPlaying) {
+        current->resampler->getNextAudioBlock(bufferToFill);
+        if (!shouldPlay) {
+            for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+                bufferToFill.buffer->applyGainRamp(channel, bufferToFill.startSample,
+                                                   bufferToFill.numSamples, 1.0f, 0.0f);
+        } else if (buffer.isFinished()) {
+            playing = false;
+            reachedEnd = true;
         }
-        return;
+    } else {
+        bufferToFill.clearActiveBufferRegion();
     }
+    wasPlaying = shouldPlay && playing.load();
 
-    transportSource.getNextAudioBlock(bufferToFill);
-
-    const double endPos = startPos + ((double)bufferToFill.numSamples / sampleRate);
-    if (endPos >= cutOut) {
-        const int samplesToKeep = juce::jlimit(0, bufferToFill.numSamples,
-                                               (int)std::floor((cutOut - startPos) * sampleRate));
-
-        if (samplesToKeep < bufferToFill.numSamples) {
-            bufferToFill.buffer->clear(bufferToFill.startSample + samplesToKeep,
-                                       bufferToFill.numSamples - samplesToKeep);
-        }
-
-        if (repeating) {
-            transportSource.setPosition(cutIn);
-            transportSource.start();
-        } else {
-            transportSource.stop();
-            transportSource.setPosition(cutOut);
-        }
-    }
+    const double sampleRate = outputSampleRate.load();
+    if (sampleRate > 0.0)
+        playheadClock.publish(blockGeneration, positionSeconds,
+                              bufferToFill.numSamples / sampleRate, shouldPlay, nowMs);
 }
 
-void AudioPlayer::releaseResources() {
-    transportSource.releaseResources();
+int AudioPlayer::useTimeSlice() {
+    // Sent from here rather than the audio thread, where posting a message could block.
+    if (reachedEnd.exchange(false))
+        sendChangeMessage();
+    return Config::Audio::playbackEndPollMs;
 }
 
-void AudioPlayer::changeListenerCallback(juce::ChangeBroadcaster *source) {
-    if (source == &transportSource) {
-        sendChangeMessage();
-    }
+void AudioPlayer::releaseResources() {
+    if (playbackSource != nullptr)
+        playbackSource->resampler->releaseResources();
 }
 
 void AudioPlayer::cutPreferenceChanged(const MainDomain::CutPreferences &prefs) {
+    updateRepeatRegion(prefs);
+
     const auto &autoCut = prefs.autoCut;
 
     lastAutoCutThresholdIn = autoCut.thresholdIn;
@@ -218,40 +487,107 @@ void AudioPlayer::cutPreferenceChanged(const MainDomain::CutPreferences &prefs)
     lastAutoCutOutActive = autoCut.outActive;
 }
 
+void AudioPlayer::updateRepeatRegion(const MainDomain::CutPreferences &prefs) {
+    if (const PlaybackSource *current = getPlaybackSource())
+        applyRepeatRegion(*current, prefs);
+}
+
+void AudioPlayer::applyRepeatRegion(const PlaybackSource &bundle,
+                                    const MainDomain::CutPreferences &prefs) {
+    if (bundle.source == nullptr || bundle.sampleRate <= 0.0)
+        return;
+
+    const double sampleRate = bundle.sampleRate;
+    const juce::int64 lengthInSamples = bundle.lengthInSamples;
+
+    const auto toSample = [sampleRate](double seconds) {
+        return (juce::int64)std::llround(seconds * sampleRate);
+    };
+
+    RepeatRegionSource::Region region;
+    region.bounded = prefs.active;
+    region.repeating = repeating;
+    region.cutIn = juce::jlimit((juce::int64)0, lengthInSamples, toSample(prefs.cutIn));
+    region.cutOut = juce::jlimit(region.cutIn, lengthInSamples, toSample(prefs.cutOut));
+
+    // Applied from the current playback position so what is audible stays continuous.
+    bundle.source->setRegion(region, bundle.buffer != nullptr ? bundle.buffer->getPosition() : 0);
+}
+
 juce::AudioFormatReader *AudioPlayer::getAudioFormatReader() const {
-    if (readerSource != nullptr)
-        return readerSource->getAudioFormatReader();
+    const PlaybackSource *current = getPlaybackSource();
+    if (current != nullptr && current->source != nullptr)
+        return current->source->getAudioFormatReader();
     return nullptr;
 }
 
 bool AudioPlayer::getReaderInfo(double &sampleRateOut, juce::int64 &lengthInSamplesOut) const {
-    std::lock_guard<std::mutex> lock(readerMutex);
-    if (readerSource == nullptr)
-        return false;
-
-    auto *reader = readerSource->getAudioFormatReader();
-    if (reader == nullptr)
+    const PlaybackSource *current = getPlaybackSource();
+    if (current == nullptr)
         return false;
 
-    sampleRateOut = reader->sampleRate;
-    lengthInSamplesOut = reader->lengthInSamples;
+    sampleRateOut = current->sampleRate;
+    lengthInSamplesOut = current->lengthInSamples;
     return true;
 }
 
-#if JUCE_UNIT_TESTS
-void AudioPlayer::setSourceForTesting(juce::PositionableAudioSource *source, double sampleRate) {
-    transportSource.setSource(source, 0, nullptr, sampleRate);
+void AudioPlayer::attachBuffer(PlaybackSource &bundle, juce::PositionableAudioSource &input,
+                               juce::int64 startPosition) {
+    bundle.buffer = std::make_unique<ReadAheadBuffer>(input, readAheadThread, kPlaybackChannels,
+                                                      Config::Audio::readAheadBufferSize,
+                                                      startPosition);
+    bundle.resampler = std::make_unique<juce::ResamplingAudioSource>(bundle.buffer.get(), false,
+                                                                     kPlaybackChannels);
+    prepareBundle(bundle);
 }
-#endif
 
-void AudioPlayer::setPlayheadPosition(double seconds) {
-    double sampleRate = 0.0;
-    juce::int64 lengthInSamples = 0;
-    if (!getReaderInfo(sampleRate, lengthInSamples) || sampleRate <= 0.0)
+void AudioPlayer::prepareBundle(PlaybackSource &bundle) const {
+    const double sampleRate = outputSampleRate.load();
+    if (sampleRate <= 0.0 || bundle.sampleRate <= 0.0)
+        return;
+
+    bundle.resampler->setResamplingRatio(bundle.sampleRate / sampleRate);
+    bundle.resampler->prepareToPlay(blockSize.load(), sampleRate);
+}
+
+void AudioPlayer::setPlaybackSource(std::unique_ptr<PlaybackSource> next) {
+    if (playing.exchange(false))
+        sendChangeMessage();
+
+    std::shared_ptr<PlaybackSource> retired(std::move(playbackSource));
+    playbackSource = std::move(next);
+    liveSource.store(playbackSource.get());
+    playheadClock.invalidate();
+    if (retired == nullptr)
         return;
 
-    const double totalDuration = (double)lengthInSamples / sampleRate;
+    // An odd count means a callback was running when the pointer moved and may still be
+    // rendering the old bundle; it is done with it once the count moves on.
+    const juce::uint32 callbacks = callbackCount.load();
+    retirePool.addJob([this, retired = std::move(retired), callbacks]() mutable {
+        if ((callbacks & 1) != 0)
+            while (callbackCount.load() == callbacks)
+                juce::Thread::sleep(1);
+        retired.reset();
+    });
+}
 
+#if JUCE_UNIT_TESTS
+void AudioPlayer::setSourceForTesting(juce::PositionableAudioSource *source, double sampleRate) {
+    std::unique_ptr<PlaybackSource> next;
+    if (source != nullptr) {
+        next = std::make_unique<PlaybackSource>();
+        next->sampleRate = sampleRate;
+        next->lengthInSamples = source->getTotalLength();
+        attachBuffer(*next, *source, 0);
+    }
+    setPlaybackSource(std::move(next));
+    while (retirePool.getNumJobs() > 0)
+        juce::Thread::sleep(1);
+}
+#endif
+
+double AudioPlayer::clampToCut(double seconds, double totalDuration) const {
     double cutIn = 0.0;
     double cutOut = totalDuration;
 
@@ -261,6 +597,22 @@ void AudioPlayer::setPlayheadPosition(double seconds) {
         cutOut = prefs.cutOut;
     }
 
-    double clampedPos = juce::jlimit(cutIn, cutOut, seconds);
-    transportSource.setPosition(clampedPos);
+    return juce::jlimit(cutIn, cutOut, seconds);
+}
+
+void AudioPlayer::setPlayheadPosition(double seconds) {
+    const PlaybackSource *current = getPlaybackSource();
+    if (current == nullptr || current->sampleRate <= 0.0)
+        return;
+
+    const double sampleRate = current->sampleRate;
+    const double clampedPos =
+        clampToCut(seconds, (double)current->lengthInSamples / sampleRate);
+    const auto position = (juce::int64)(clampedPos * sampleRate);
+
+    // A seek starts the repeat timeline again, so the playback position is a file position.
+    if (current->source != nullptr)
+        current->source->restartAt(position);
+    current->buffer->seek(position);
+    playheadClock.invalidate();
 }
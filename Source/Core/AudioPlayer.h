@@ -11,32 +11,47 @@
 #include <JuceHeader.h>
 #endif
 
+#include "Core/AnalysisCache.h"
+#include "Core/EnvelopeBuilder.h"
+#include "Core/PlayheadClock.h"
+#include "Core/ReadAheadBuffer.h"
+#include "Core/RepeatRegionSource.h"
 #include "Core/SessionState.h"
 #include "MainDomain.h"
 #include "Utils/Config.h"
 #if !defined(JUCE_HEADLESS)
 #include "Core/WaveformManager.h"
 #endif
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
 
 /**
  * @file AudioPlayer.h
  * @ingroup AudioEngine
  * @brief High-level audio playback and file handling class.
- * @details This class wraps `juce::AudioTransportSource` and handles loading audio files,
- *          managing playback position, and enforcing cut regions defined in `SessionState`.
+ * @details This class handles loading audio files, managing playback position, and enforcing
+ *          cut regions defined in `SessionState`. The cut region and repeat mode are applied by
+ *          the `RepeatRegionSource` it reads through, beneath the read-ahead buffer, so repeats
+ *          are gapless and never flush it.
  *
- *          It runs a background `juce::TimeSliceThread` for read-ahead buffering to ensure
- *          smooth playback.
+ *          Everything the audio thread needs of the loaded file is one bundle, published
+ *          through an atomic pointer; the audio callback renders it with its own read-ahead
+ *          ring and resampler, so it never takes a lock. It runs a background
+ *          `juce::TimeSliceThread` for read-ahead buffering to ensure smooth playback, a small
+ *          pool that opens files for loadFileAsync() so a slow volume never stalls the message
+ *          thread, and a thread of its own that destroys bundles the audio thread has let go.
  *
  * @see SessionState
  * @see MainComponent
  * @see WaveformManager
  */
 class AudioPlayer : public juce::AudioSource,
-                    public juce::ChangeListener,
                     public juce::ChangeBroadcaster,
-                    public SessionState::Listener {
+                    public SessionState::Listener,
+                    private juce::TimeSliceClient {
   public:
     explicit AudioPlayer(SessionState &state);
 
@@ -45,16 +60,44 @@ class AudioPlayer : public juce::AudioSource,
     /** @brief Seeks to the specified position in seconds, clamped by cut boundaries if active. */
     void setPlayheadPosition(double seconds);
 
-    /** @brief Loads an audio file and synchronizes SessionState with its metadata. */
+    /**
+     * @brief Loads an audio file and synchronizes SessionState with its metadata.
+     * @details The envelope build fingerprints the file's content in the background and
+     *          consults the AnalysisCache with it; on a hit the envelope and waveform come from
+     *          disk, stored cut points are restored and no decode runs.
+     */
     juce::Result loadFile(const juce::File &file);
 
+    /** @brief Called on the message thread with the outcome of loadFileAsync(). */
+    using LoadCallback = std::function<void(const juce::Result &)>;
+
+    /**
+     * @brief Loads an audio file without blocking the message thread.
+     * @details A worker opens the playback and waveform readers, looks the file up in the
+     *          metadata store and warms the page cache from its stored cut-in, so slow volumes
+     *          stall the worker instead of the UI. The opened readers are then swapped in on the
+     *          message thread exactly as loadFile() does, and `onLoaded` is called. A later load or cancelLoad() supersedes this one: its
+     *          reader is dropped on the worker and `onLoaded` is never called.
+     */
+    void loadFileAsync(const juce::File &file, LoadCallback onLoaded);
+
+    /** @brief Abandons the pending loadFileAsync(), if any; the loaded file keeps playing. */
+    void cancelLoad();
+
+    /** @brief True from loadFileAsync() until its result is delivered or superseded. */
+    bool isLoading() const;
+
     /** @brief Toggles between playback and paused states. */
     void togglePlayStop();
 
-    /** @brief Returns true if the transport is currently playing. */
+    /** @brief Returns true if playback is running. */
     bool isPlaying() const;
 
-    /** @brief Returns the current transport position in seconds. */
+    /**
+     * @brief Returns the current playback position in the file, in seconds.
+     * @details While playing, this is predicted by the PlayheadClock from the last audio
+     *          callback rather than read from the read-ahead buffer, which moves once per block.
+     */
     double getCurrentPosition() const;
 
     /** @brief Returns true if the player is set to repeat between cut points. */
@@ -65,10 +108,10 @@ class AudioPlayer : public juce::AudioSource,
 
 #if !defined(JUCE_HEADLESS)
 
-    /** @brief Returns the audio thumbnail for waveform rendering. */
+    /** @brief Returns the audio thumbnail, which carries the loaded file's length. */
     juce::AudioThumbnail &getThumbnail();
 
-    /** @brief Provides access to the WaveformManager for thumbnail updates. */
+    /** @brief Provides access to the WaveformManager for waveform updates. */
     WaveformManager &getWaveformManager();
 
     /** @brief Provides read-only access to the WaveformManager. */
@@ -78,7 +121,7 @@ class AudioPlayer : public juce::AudioSource,
     /** @brief Starts audio playback. */
     void startPlayback();
 
-    /** @brief Stops audio playback. */
+    /** @brief Stops audio playback where it was last heard. */
     void stopPlayback();
 
     /** @brief Stops playback and seeks back to the cut-in position. */
@@ -87,27 +130,35 @@ class AudioPlayer : public juce::AudioSource,
     /** @brief Provides access to the global audio format manager. */
     juce::AudioFormatManager &getFormatManager();
 
+    /** @brief The cache loads consult; shared with the FilePrefetcher. */
+    const AnalysisCache &getAnalysisCache() const {
+        return analysisCache;
+    }
+
     /** @brief Returns the underlying audio format reader for the loaded file. */
     juce::AudioFormatReader *getAudioFormatReader() const;
 
     /** @brief Returns the juce::File handle for the currently loaded audio. */
     juce::File getLoadedFile() const;
 
-    /** @brief Initializes audio processing parameters. */
+    /** @brief Initializes audio processing parameters. Called while no callback runs. */
     void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
 
     /**
      * @brief Processes the next block of audio samples.
-     * @details This is the core audio processing callback. The logic sequence is:
-     *          1. Check if a valid reader source exists. If not, clear the buffer.
-     *          2. Retrieve the current cut preferences from `SessionState`.
-     *          3. If cut mode is inactive, simply delegate to `transportSource`.
-     *          4. If active, check the current playback position against `cutIn` and `cutOut`.
-     *          5. If the position exceeds `cutOut`:
-     *             - If repeating is enabled, seek back to `cutIn`.
-     *             - If not, stop playback.
-     *          6. If the current block crosses the `cutOut` boundary, fade out or truncate
-     *             the buffer to ensure no audio is played past the cut point.
+     * @details This is the core audio processing callback, and it is wait-free. It loads the
+     *          current bundle from an atomic pointer and, if none is published, clears the
+     *          buffer. Otherwise it takes a pending seek from the bundle's ReadAheadBuffer,
+     *          renders through the bundle's own resampler while playing, and stamps the block on
+     *          the PlayheadClock. Cut enforcement needs no work here: the `RepeatRegionSource`
+     *          beneath the buffer fades out into `cutOut` on the exact sample, or crossfades
+     *          into `cutIn` when repeating, and the read-ahead ends where its timeline does.
+     *          Playback started at `cutIn` fades in; a stop fades out the block in flight.
+     *
+     *          Start, stop and seeks are atomics the callback reads, and the end of playback
+     *          is an atomic it sets; the change message for it is sent from the read-ahead
+     *          thread. The resampler's spin lock is only ever taken by this thread once the
+     *          bundle is published, and the callback touches no `SessionState`.
      *
      * @param bufferToFill The buffer to populate with audio data.
      */
@@ -115,8 +166,6 @@ class AudioPlayer : public juce::AudioSource,
 
     void releaseResources() override;
 
-    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
-
     void cutPreferenceChanged(const MainDomain::CutPreferences &prefs) override;
 
     double getCutIn() const {
@@ -135,34 +184,156 @@ class AudioPlayer : public juce::AudioSource,
         sessionState.setCutOut(positionSeconds);
     }
 
-    std::mutex &getReaderMutex() {
-        return readerMutex;
-    }
-
+    /** @brief Sample rate and length of the loaded file; false if none. Message thread. */
     bool getReaderInfo(double &sampleRateOut, juce::int64 &lengthInSamplesOut) const;
 
+    /** @brief Returns the envelope of the loaded file, or nullptr while it is being built. */
+    std::shared_ptr<const EnvelopeIndex> getEnvelopeIndex() const;
+
+    /**
+     * @brief Blocks the calling (non-message) thread until the envelope of `file` is built.
+     * @see EnvelopeBuilder::waitForIndex
+     */
+    std::shared_ptr<const EnvelopeIndex>
+    waitForEnvelopeIndex(const juce::File &file, const std::function<bool()> &shouldAbort) const;
+
+    /** @brief Called on the message thread when the envelope of the loaded file is ready. */
+    std::function<void()> onEnvelopeReady;
+
 #if JUCE_UNIT_TESTS
 
+    /**
+     * @brief Plays `source` instead of a file; nullptr unloads it.
+     * @details Returns once the previous source is released, so the caller may destroy it.
+     */
     void setSourceForTesting(juce::PositionableAudioSource *source, double sampleRate);
 #endif
 
   private:
+    /**
+     * @brief Everything playback reads from the loaded file, fixed when it is loaded.
+     * @details Built completely, cut region and start position included, before it is
+     *          published, and never replaced piecemeal: a new file gets a new bundle. The cut
+     *          region lives in the snapshot its `RepeatRegionSource` owns, so a marker drag
+     *          reaches the read-ahead thread without republishing the bundle.
+     */
+    struct PlaybackSource {
+        /** The file beneath the cut region; nullptr for a test source. */
+        std::unique_ptr<RepeatRegionSource> source;
+        /** Reads ahead from `source`; declared after it so it is destroyed first. */
+        std::unique_ptr<ReadAheadBuffer> buffer;
+        /** Converts to the device rate; rendered by the audio thread only once published. */
+        std::unique_ptr<juce::ResamplingAudioSource> resampler;
+        double sampleRate{0.0};
+        juce::int64 lengthInSamples{0};
+    };
+
+    /** @brief The current bundle, or nullptr. Message thread. */
+    const PlaybackSource *getPlaybackSource() const {
+        return playbackSource.get();
+    }
+
+    /** @brief Adds the read-ahead buffer and resampler for `input` to `bundle`. */
+    void attachBuffer(PlaybackSource &bundle, juce::PositionableAudioSource &input,
+                      juce::int64 startPosition);
+
+    /** @brief Prepares `bundle` for the device, if one has been set up. */
+    void prepareBundle(PlaybackSource &bundle) const;
+
+    /**
+     * @brief Stops playback and publishes `next` to the audio thread. Message thread.
+     * @details The old bundle, and with it the old file's reader, is destroyed on the retire
+     *          thread once no callback can still be reading it, so neither the audio nor the
+     *          message thread ever closes a file.
+     */
+    void setPlaybackSource(std::unique_ptr<PlaybackSource> next);
+
+    /** @brief Renders one block from `current`, which may be nullptr. Audio thread. */
+    void renderBlock(PlaybackSource *current, const juce::AudioSourceChannelInfo &bufferToFill);
+
+    /** @brief Reports the end of playback the audio thread found. Read-ahead thread. */
+    int useTimeSlice() override;
+
+    /** @brief The readers a load opens before it commits; either may be nullptr. */
+    struct OpenedFile {
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        /** Handed to the WaveformManager for sample-level zoom; not opened when headless. */
+        std::unique_ptr<juce::AudioFormatReader> detailReader;
+    };
+
+    /** @brief Opens the readers for `file`. Any thread. */
+    OpenedFile openFile(const juce::File &file);
+
+    /**
+     * @brief Brings the region playback starts from into the page cache. Load worker.
+     * @details Starts at the stored cut-in, if the metadata store has one for `file`.
+     */
+    void warmUp(const juce::File &file, juce::AudioFormatReader &reader);
+
+    /** @brief Swaps in opened readers and synchronizes SessionState. Message thread. */
+    juce::Result commitLoad(const juce::File &file, OpenedFile opened);
+
+    /** @brief Hands the cut region and repeat flag, in samples, to the reader source. */
+    void updateRepeatRegion(const MainDomain::CutPreferences &prefs);
+    void applyRepeatRegion(const PlaybackSource &bundle, const MainDomain::CutPreferences &prefs);
+    /** @brief Clamps `seconds` into the active cut region, or into the file. */
+    double clampToCut(double seconds, double totalDuration) const;
+    void startEnvelopeBuild(const juce::File &file, int numChannels, juce::int64 lengthInSamples);
+    void applyContentKey(const juce::String &filePath, const juce::String &contentKey);
+    /** @brief Stores the loaded file's metadata, on the load pool if `inBackground`. */
+    void persistCurrentMetadata(bool inBackground);
+
     juce::AudioFormatManager formatManager;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+    /** Replaced only by setPlaybackSource(). */
+    std::unique_ptr<PlaybackSource> playbackSource;
+    /** The bundle the audio thread renders; the same as `playbackSource`. */
+    std::atomic<PlaybackSource *> liveSource{nullptr};
+    /** Bumped as each callback starts and ends, so it is odd while one runs. */
+    std::atomic<juce::uint32> callbackCount{0};
+    std::atomic<bool> playing{false};
+    /** Set by the audio thread when playback runs out; cleared once it is reported. */
+    std::atomic<bool> reachedEnd{false};
     juce::TimeSliceThread readAheadThread;
-    juce::AudioTransportSource transportSource;
+    /** Destroys retired bundles; one thread, kept apart from slow file loads. */
+    juce::ThreadPool retirePool;
+
+    // Audio thread only.
+    const PlaybackSource *renderedSource{nullptr};
+    bool wasPlaying{false};
 
 #if !defined(JUCE_HEADLESS)
     WaveformManager waveformManager;
+    /** The waveform load of the loaded file; builder callbacks carry it. Message thread. */
+    WaveformManager::LoadId waveformLoad{0};
 #endif
+    AnalysisCache analysisCache;
+    EnvelopeBuilder envelopeBuilder;
+
+    juce::ThreadPool loadPool;
+    /** Bumped by every load and cancellation; a load only commits if it is still current. */
+    std::atomic<juce::uint32> loadGeneration{0};
+    juce::uint32 deliveredGeneration{0};
+    std::shared_ptr<bool> lifeToken;
 
     juce::File loadedFile;
+    FileId loadedFileId{invalidFileId};
+    juce::String loadedFileKey;
+    bool loadedWithDefaults{false};
+    FileMetadata loadDefaults;
+
+    std::mutex cacheMutex;
+    /** Both guarded by `cacheMutex`; the metadata is only applied to the file it came from. */
+    juce::String pendingCachedPath;
+    std::optional<FileMetadata> pendingCachedMetadata;
     SessionState &sessionState;
     float lastAutoCutThresholdIn{-1.0f};
     float lastAutoCutThresholdOut{-1.0f};
     bool lastAutoCutInActive{false};
     bool lastAutoCutOutActive{false};
-    mutable std::mutex readerMutex;
+
+    PlayheadClock playheadClock;
+    std::atomic<double> outputSampleRate{0.0};
+    std::atomic<int> blockSize{0};
 
     bool repeating = false;
 
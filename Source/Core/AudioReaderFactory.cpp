@@ -0,0 +1,43 @@
+#include "Core/AudioReaderFactory.h"
+#include "Utils/Config.h"
+
+namespace {
+constexpr int kPageSizeBytes = 4096;
+} // namespace
+
+std::unique_ptr<juce::AudioFormatReader>
+AudioReaderFactory::createReader(juce::AudioFormatManager &formatManager, const juce::File &file) {
+    if (Config::Audio::useMemoryMappedReaders) {
+        if (auto *format = formatManager.findFormatForFileExtension(file.getFileExtension())) {
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(
+                format->createMemoryMappedReader(file));
+
+            // Mapping fails for compressed encodings or when address space runs out.
+            if (mapped != nullptr && mapped->lengthInSamples > 0 && mapped->mapEntireFile())
+                return mapped;
+        }
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+}
+
+juce::MemoryMappedAudioFormatReader *
+AudioReaderFactory::asMapped(juce::AudioFormatReader *reader) {
+    return dynamic_cast<juce::MemoryMappedAudioFormatReader *>(reader);
+}
+
+void AudioReaderFactory::prefault(juce::AudioFormatReader *reader, juce::int64 startSample,
+                                  juce::int64 numSamples) {
+    const auto *mapped = asMapped(reader);
+    if (mapped == nullptr)
+        return;
+
+    const int bytesPerFrame =
+        juce::jmax(1, (int)mapped->numChannels * (int)mapped->bitsPerSample / 8);
+    const juce::int64 step = juce::jmax(1, kPageSizeBytes / bytesPerFrame);
+    const juce::Range<juce::int64> section =
+        mapped->getMappedSection().getIntersectionWith({startSample, startSample + numSamples});
+
+    for (juce::int64 sample = section.getStart(); sample < section.getEnd(); sample += step)
+        mapped->touchSample(sample);
+}
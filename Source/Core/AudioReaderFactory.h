@@ -0,0 +1,50 @@
+#ifndef AUDIOFILER_AUDIOREADERFACTORY_H
+#define AUDIOFILER_AUDIOREADERFACTORY_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <memory>
+
+/**
+ * @ingroup AudioEngine
+ * @class AudioReaderFactory
+ * @brief Creates audio readers, preferring a memory-mapped reader for uncompressed files.
+ * @details For formats that support it (WAV and AIFF PCM), the whole file is mapped with
+ *          `juce::MemoryMappedAudioFormatReader`, so reads convert straight out of the page
+ *          cache: no stream buffer, no intermediate copy, and every reader of the same file
+ *          shares the same physical pages. Everything else, or a failed mapping, falls back to
+ *          `juce::AudioFormatManager::createReaderFor()`.
+ *
+ *          Every call returns an independent reader, so the Threading Law (each worker owns
+ *          its reader) still holds. Controlled by `Config::Audio::useMemoryMappedReaders`.
+ *
+ * @see AudioPlayer
+ * @see EnvelopeBuilder
+ */
+class AudioReaderFactory {
+  public:
+    /**
+     * @brief Opens a reader for `file`.
+     * @return The reader, or nullptr if no registered format can read the file.
+     */
+    static std::unique_ptr<juce::AudioFormatReader>
+    createReader(juce::AudioFormatManager &formatManager, const juce::File &file);
+
+    /** @brief Returns the mapped reader behind `reader`, or nullptr if it reads from a stream. */
+    static juce::MemoryMappedAudioFormatReader *asMapped(juce::AudioFormatReader *reader);
+
+    /**
+     * @brief Touches the pages holding `numSamples` frames from `startSample`.
+     * @details Call off the audio thread before playback reaches a region (e.g. after a seek),
+     *          so the audio callback does not take the page faults. No-op for stream readers.
+     */
+    static void prefault(juce::AudioFormatReader *reader, juce::int64 startSample,
+                         juce::int64 numSamples);
+};
+
+#endif
@@ -0,0 +1,171 @@
+#include "Core/EnvelopeBuilder.h"
+#include "Core/AudioReaderFactory.h"
+#include "Utils/Config.h"
+#include "Utils/ContentFingerprint.h"
+#include "Workers/ScanScheduler.h"
+
+#include <utility>
+
+namespace {
+constexpr int kWaitSliceMs = 50;
+} // namespace
+
+EnvelopeBuilder::EnvelopeBuilder(juce::AudioFormatManager &formatManagerIn)
+    : formatManager(formatManagerIn),
+      buildPool(juce::ThreadPoolOptions()
+                    .withThreadName("EnvelopeBuilder")
+                    .withNumberOfThreads(1)
+                    .withDesiredThreadPriority(
+                        ScanScheduler::priorityFor(AppEnums::ScanPolicy::FullSpeed))) {
+    lifeToken = std::make_shared<bool>(true);
+}
+
+EnvelopeBuilder::~EnvelopeBuilder() {
+    shutdown();
+}
+
+void EnvelopeBuilder::startBuild(const juce::File &file, Callbacks callbacks) {
+    int generation = 0;
+    {
+        const juce::ScopedLock lock(stateLock);
+        generation = ++buildGeneration;
+        fileToBuild = file;
+        latestIndex.reset();
+        buildActive = true;
+        buildFinished.reset();
+    }
+
+    // A superseded build that is still running returns at its next checkpoint; this one is
+    // queued behind it rather than waited for.
+    buildPool.addJob([this, generation, file, callbacks = std::move(callbacks)] {
+        runBuild(generation, file, callbacks);
+    });
+}
+
+void EnvelopeBuilder::cancelBuild() {
+    const juce::ScopedLock lock(stateLock);
+    ++buildGeneration;
+    buildActive = false;
+    buildFinished.signal();
+}
+
+void EnvelopeBuilder::shutdown() {
+    cancelBuild();
+    buildPool.removeAllJobs(true, 4000);
+}
+
+std::shared_ptr<const EnvelopeIndex> EnvelopeBuilder::getIndex() const {
+    const juce::ScopedLock lock(stateLock);
+    return latestIndex;
+}
+
+std::shared_ptr<const EnvelopeIndex>
+EnvelopeBuilder::waitForIndex(const juce::File &file,
+                              const std::function<bool()> &shouldAbort) const {
+    for (;;) {
+        {
+            const juce::ScopedLock lock(stateLock);
+            if (fileToBuild != file)
+                return nullptr;
+            if (latestIndex != nullptr || !buildActive)
+                return latestIndex;
+        }
+
+        if (shouldAbort != nullptr && shouldAbort())
+            return nullptr;
+
+        buildFinished.wait(kWaitSliceMs);
+    }
+}
+
+std::shared_ptr<EnvelopeIndex> EnvelopeBuilder::buildFromReader(juce::AudioFormatReader &reader,
+                                                                ScanScheduler *scheduler,
+                                                                const BlockCallback &onBlock) {
+    const int numChannels = (int)reader.numChannels;
+    const juce::int64 lengthInSamples = reader.lengthInSamples;
+    if (numChannels <= 0 || lengthInSamples <= 0)
+        return nullptr;
+
+    auto index = std::make_shared<EnvelopeIndex>(numChannels, lengthInSamples, reader.sampleRate);
+    juce::AudioBuffer<float> buffer(numChannels, Config::Audio::envelopeReadChunkSize);
+
+    for (juce::int64 pos = 0; pos < lengthInSamples;) {
+        if (scheduler != nullptr && scheduler->checkpoint())
+            return nullptr;
+
+        const int numThisTime = (int)juce::jmin(
+            (juce::int64)Config::Audio::envelopeReadChunkSize, lengthInSamples - pos);
+        if (!reader.read(&buffer, 0, numThisTime, pos, true, true))
+            return nullptr;
+
+        index->addBlock(pos, buffer, numThisTime);
+        if (onBlock != nullptr)
+            onBlock(pos, buffer, numThisTime);
+
+        pos += numThisTime;
+    }
+
+    index->finalise();
+    return index;
+}
+
+void EnvelopeBuilder::finishBuild(int generation, std::shared_ptr<const EnvelopeIndex> index) {
+    const juce::ScopedLock lock(stateLock);
+    if (generation != buildGeneration.load())
+        return;
+    latestIndex = std::move(index);
+    buildActive = false;
+    buildFinished.signal();
+}
+
+void EnvelopeBuilder::runBuild(int generation, const juce::File &file,
+                               const Callbacks &callbacks) {
+    const auto shouldStop = [this, generation] { return buildGeneration.load() != generation; };
+    if (shouldStop())
+        return;
+
+    auto localReader = AudioReaderFactory::createReader(formatManager, file);
+    if (localReader == nullptr) {
+        finishBuild(generation, nullptr);
+        return;
+    }
+
+    if (callbacks.onPreview != nullptr)
+        callbacks.onPreview(*localReader, shouldStop);
+
+    const auto mode = Config::Cache::verifyFullContent ? ContentFingerprint::Mode::Full
+                                                       : ContentFingerprint::Mode::Sampled;
+    const juce::String contentKey = ContentFingerprint::compute(file, mode, shouldStop);
+    if (shouldStop())
+        return;
+
+    std::shared_ptr<const EnvelopeIndex> index;
+    if (contentKey.isNotEmpty() && callbacks.onLookup != nullptr) {
+        index = callbacks.onLookup(contentKey);
+        if (index != nullptr && (index->getLengthInSamples() != localReader->lengthInSamples ||
+                                 index->getNumChannels() != (int)localReader->numChannels))
+            index.reset();
+    }
+
+    const bool decoded = index == nullptr;
+    if (decoded) {
+        ScanScheduler scheduler(AppEnums::ScanPolicy::FullSpeed, shouldStop);
+        index = buildFromReader(*localReader, &scheduler, callbacks.onBlock);
+    }
+
+    finishBuild(generation, index);
+    if (index == nullptr || shouldStop())
+        return;
+
+    if (decoded && contentKey.isNotEmpty() && callbacks.onBuilt != nullptr)
+        callbacks.onBuilt(contentKey, *index);
+
+    std::weak_ptr<bool> weakToken = lifeToken;
+    juce::MessageManager::callAsync(
+        [this, weakToken, generation, index, contentKey, onComplete = callbacks.onComplete]() {
+            if (auto token = weakToken.lock()) {
+                if (generation == buildGeneration.load() && onComplete != nullptr)
+                    onComplete(index, contentKey);
+            }
+        });
+}
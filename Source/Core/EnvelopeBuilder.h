@@ -0,0 +1,148 @@
+#ifndef AUDIOFILER_ENVELOPEBUILDER_H
+#define AUDIOFILER_ENVELOPEBUILDER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/EnvelopeIndex.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class ScanScheduler;
+
+/**
+ * @file EnvelopeBuilder.h
+ * @ingroup Threading
+ * @brief Background job that decodes a file once and builds its EnvelopeIndex.
+ * @details Owns a private reader (never the AudioPlayer's), streams the whole file in
+ *          `Config::Audio::envelopeReadChunkSize` chunks and hands every decoded chunk to an
+ *          optional block callback so other consumers (the waveform pyramid) can piggy-back
+ *          on the same decode. Before decoding it fingerprints the file's content and asks the
+ *          owner for a stored index, so a cached file is never decoded. The finished index is
+ *          delivered on the message thread via `juce::MessageManager::callAsync`; results of
+ *          superseded builds are dropped.
+ *
+ *          Builds run as jobs on a one-thread pool, so starting or cancelling one never waits:
+ *          a superseded build returns at its next checkpoint, while the next one is queued
+ *          behind it. Until then its callbacks may still run, so callbacks that write shared
+ *          state must check that state still belongs to their build.
+ *
+ * @see EnvelopeIndex
+ * @see AudioPlayer
+ * @see ContentFingerprint
+ */
+class EnvelopeBuilder {
+  public:
+    /** @brief Called on the builder thread for every decoded chunk, in file order. */
+    using BlockCallback = std::function<void(juce::int64 startSample,
+                                             const juce::AudioBuffer<float> &buffer,
+                                             int numSamples)>;
+
+    /**
+     * @brief Called on the builder thread with its private reader before anything else.
+     * @details For quick sparse reads that should show before the decode, such as a waveform
+     *          preview. Positional reads only; `shouldStop` turns true once the build is
+     *          superseded.
+     */
+    using PreviewCallback = std::function<void(juce::AudioFormatReader &reader,
+                                               const std::function<bool()> &shouldStop)>;
+
+    /**
+     * @brief Called on the builder thread with the file's content key before decoding.
+     * @return A previously stored index for that key (e.g. from the AnalysisCache), or nullptr
+     *         to decode. An index whose shape does not match the file is ignored.
+     */
+    using LookupCallback =
+        std::function<std::shared_ptr<const EnvelopeIndex>(const juce::String &contentKey)>;
+
+    /** @brief Called on the builder thread with a freshly decoded index (e.g. to persist it). */
+    using BuiltCallback =
+        std::function<void(const juce::String &contentKey, const EnvelopeIndex &index)>;
+
+    /** @brief Called on the message thread with the finished index and the content key. */
+    using CompletionCallback = std::function<void(std::shared_ptr<const EnvelopeIndex> index,
+                                                  const juce::String &contentKey)>;
+
+    /** @brief The hooks of one build; every member is optional. */
+    struct Callbacks {
+        PreviewCallback onPreview;
+        LookupCallback onLookup;
+        BlockCallback onBlock;
+        BuiltCallback onBuilt;
+        CompletionCallback onComplete;
+    };
+
+    explicit EnvelopeBuilder(juce::AudioFormatManager &formatManager);
+
+    ~EnvelopeBuilder();
+
+    /**
+     * @brief Cancels any running build and starts a new one for the given file.
+     * @details The build first runs `onPreview`, then computes the file's
+     *          `ContentFingerprint` and offers it to `onLookup`; only on a miss is the file
+     *          decoded.
+     */
+    void startBuild(const juce::File &file, Callbacks callbacks);
+
+    /**
+     * @brief Cancels the running build, if any, without waiting for it.
+     * @details From here on the cancelled build changes neither the index nor calls
+     *          `onComplete`; waitForIndex() returns nullptr.
+     */
+    void cancelBuild();
+
+    /** @brief Cancels the build and waits for its job to return, e.g. before its callbacks'
+     *         targets are destroyed. */
+    void shutdown();
+
+    /** @brief Returns the finished index of the current file, or nullptr. Any thread. */
+    std::shared_ptr<const EnvelopeIndex> getIndex() const;
+
+    /**
+     * @brief Blocks until the index for `file` is finished.
+     * @details Intended for analysis threads that would otherwise decode the file a second
+     *          time. Returns early with nullptr if `file` is not the file being built, the
+     *          build fails or is cancelled, or `shouldAbort` returns true.
+     */
+    std::shared_ptr<const EnvelopeIndex> waitForIndex(const juce::File &file,
+                                                      const std::function<bool()> &shouldAbort)
+        const;
+
+    /**
+     * @brief Decodes a whole reader into a finished EnvelopeIndex on the calling thread.
+     * @return The index, or nullptr if the read failed or the scheduler cancelled it.
+     */
+    static std::shared_ptr<EnvelopeIndex> buildFromReader(juce::AudioFormatReader &reader,
+                                                          ScanScheduler *scheduler = nullptr,
+                                                          const BlockCallback &onBlock = {});
+
+  private:
+    void runBuild(int generation, const juce::File &file, const Callbacks &callbacks);
+
+    /** Publishes the result of build `generation`, unless it has been superseded. */
+    void finishBuild(int generation, std::shared_ptr<const EnvelopeIndex> index);
+
+    juce::AudioFormatManager &formatManager;
+    /** Bumped under `stateLock` by every start and cancellation. */
+    std::atomic<int> buildGeneration{0};
+
+    juce::CriticalSection stateLock;
+    juce::File fileToBuild;
+    std::shared_ptr<const EnvelopeIndex> latestIndex;
+    bool buildActive{false};
+    juce::WaitableEvent buildFinished{true};
+
+    std::shared_ptr<bool> lifeToken;
+    juce::ThreadPool buildPool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeBuilder)
+};
+
+#endif
@@ -0,0 +1,277 @@
+#include "Core/EnvelopeIndex.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+enum Array { kMins = 0, kMaxs = 1, kMeanSquares = 2, kNumArrays = 3 };
+} // namespace
+
+EnvelopeIndex::EnvelopeIndex(int channels, juce::int64 length, double rate)
+    : EnvelopeIndex(channels, length, rate, true) {
+}
+
+EnvelopeIndex::EnvelopeIndex(int channels, juce::int64 length, double rate,
+                             bool allocateStorage)
+    : numChannels(juce::jmax(0, channels)), lengthInSamples(length), sampleRate(rate) {
+    static_assert(Config::Audio::envelopeReadChunkSize % Config::Audio::envelopeBaseBlockSize == 0,
+                  "Decode chunks must cover whole envelope blocks");
+
+    int blockSize = Config::Audio::envelopeBaseBlockSize;
+    for (int level = 0; level < Config::Audio::envelopeNumLevels; ++level) {
+        Level newLevel;
+        newLevel.blockSize = blockSize;
+        newLevel.numBlocks = (lengthInSamples + blockSize - 1) / blockSize;
+        newLevel.offset = totalFloats;
+        totalFloats += (size_t)newLevel.numBlocks * (size_t)numChannels * kNumArrays;
+        levels.push_back(newLevel);
+        blockSize *= Config::Audio::envelopeLevelRatio;
+    }
+
+    if (allocateStorage) {
+        storage.assign(totalFloats, 0.0f);
+        writeData = storage.data();
+        readData = storage.data();
+    }
+}
+
+std::shared_ptr<EnvelopeIndex>
+EnvelopeIndex::fromMappedFile(std::unique_ptr<juce::MemoryMappedFile> mappedFile,
+                              size_t dataOffsetBytes, int numChannels,
+                              juce::int64 lengthInSamples, double sampleRate) {
+    if (mappedFile == nullptr || mappedFile->getData() == nullptr)
+        return nullptr;
+
+    std::shared_ptr<EnvelopeIndex> index(
+        new EnvelopeIndex(numChannels, lengthInSamples, sampleRate, false));
+
+    const size_t bytesNeeded = dataOffsetBytes + index->totalFloats * sizeof(float);
+    if (mappedFile->getSize() < bytesNeeded || dataOffsetBytes % alignof(float) != 0)
+        return nullptr;
+
+    index->readData = reinterpret_cast<const float *>(
+        static_cast<const char *>(mappedFile->getData()) + dataOffsetBytes);
+    index->mapping = std::move(mappedFile);
+    index->complete = true;
+    return index;
+}
+
+size_t EnvelopeIndex::arrayOffset(int level, int channel, int array) const {
+    const auto &info = levels[(size_t)level];
+    return info.offset + ((size_t)channel * kNumArrays + (size_t)array) * (size_t)info.numBlocks;
+}
+
+int EnvelopeIndex::getBlockSize(int level) const {
+    return levels[(size_t)level].blockSize;
+}
+
+juce::int64 EnvelopeIndex::getNumBlocks(int level) const {
+    return numChannels > 0 ? levels[(size_t)level].numBlocks : 0;
+}
+
+const float *EnvelopeIndex::getMinData(int level, int channel) const {
+    return readData + arrayOffset(level, channel, kMins);
+}
+
+const float *EnvelopeIndex::getMaxData(int level, int channel) const {
+    return readData + arrayOffset(level, channel, kMaxs);
+}
+
+const float *EnvelopeIndex::getMeanSquareData(int level, int channel) const {
+    return readData + arrayOffset(level, channel, kMeanSquares);
+}
+
+void EnvelopeIndex::addBlock(juce::int64 startSample, const juce::AudioBuffer<float> &buffer,
+                             int numSamples) {
+    jassert(writeData != nullptr);
+    if (writeData == nullptr)
+        return;
+
+    const int blockSize = getBlockSize(0);
+    jassert(startSample % blockSize == 0);
+
+    const int channelsToRead = juce::jmin(numChannels, buffer.getNumChannels());
+    const juce::int64 numBlocks = getNumBlocks(0);
+
+    for (int offset = 0; offset < numSamples; offset += blockSize) {
+        const juce::int64 block = (startSample + offset) / blockSize;
+        if (block >= numBlocks)
+            break;
+
+        const int blockLength = juce::jmin(blockSize, numSamples - offset);
+        for (int channel = 0; channel < channelsToRead; ++channel) {
+            const float *samples = buffer.getReadPointer(channel, offset);
+            const auto range = juce::FloatVectorOperations::findMinAndMax(samples, blockLength);
+
+            float sumOfSquares = 0.0f;
+            for (int i = 0; i < blockLength; ++i)
+                sumOfSquares += samples[i] * samples[i];
+
+            writeData[arrayOffset(0, channel, kMins) + (size_t)block] = range.getStart();
+            writeData[arrayOffset(0, channel, kMaxs) + (size_t)block] = range.getEnd();
+            writeData[arrayOffset(0, channel, kMeanSquares) + (size_t)block] =
+                sumOfSquares / (float)blockLength;
+        }
+    }
+}
+
+void EnvelopeIndex::finalise() {
+    if (writeData == nullptr)
+        return;
+
+    for (int level = 1; level < getNumLevels(); ++level) {
+        const int fineSize = getBlockSize(level - 1);
+        const juce::int64 numFine = getNumBlocks(level - 1);
+        const juce::int64 numCoarse = getNumBlocks(level);
+        const int ratio = getBlockSize(level) / fineSize;
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const float *srcMins = getMinData(level - 1, channel);
+            const float *srcMaxs = getMaxData(level - 1, channel);
+            const float *srcSquares = getMeanSquareData(level - 1, channel);
+            float *dstMins = writeData + arrayOffset(level, channel, kMins);
+            float *dstMaxs = writeData + arrayOffset(level, channel, kMaxs);
+            float *dstSquares = writeData + arrayOffset(level, channel, kMeanSquares);
+
+            for (juce::int64 block = 0; block < numCoarse; ++block) {
+                const juce::int64 first = block * ratio;
+                const juce::int64 last = juce::jmin(first + ratio, numFine);
+
+                float minValue = srcMins[first];
+                float maxValue = srcMaxs[first];
+                double weightedSquares = 0.0;
+                juce::int64 coveredSamples = 0;
+
+                for (juce::int64 child = first; child < last; ++child) {
+                    const juce::int64 childLength =
+                        juce::jmin((juce::int64)fineSize, lengthInSamples - child * fineSize);
+
+                    minValue = juce::jmin(minValue, srcMins[child]);
+                    maxValue = juce::jmax(maxValue, srcMaxs[child]);
+                    weightedSquares += (double)srcSquares[child] * childLength;
+                    coveredSamples += childLength;
+                }
+
+                dstMins[block] = minValue;
+                dstMaxs[block] = maxValue;
+                dstSquares[block] =
+                    coveredSamples > 0 ? (float)(weightedSquares / (double)coveredSamples) : 0.0f;
+            }
+        }
+    }
+
+    complete = true;
+}
+
+bool EnvelopeIndex::blockExceeds(int level, juce::int64 block, float threshold) const {
+    for (int channel = 0; channel < numChannels; ++channel) {
+        if (getMaxData(level, channel)[block] > threshold ||
+            getMinData(level, channel)[block] < -threshold)
+            return true;
+    }
+    return false;
+}
+
+juce::int64 EnvelopeIndex::findFirstBlockAbove(float threshold) const {
+    const int top = getNumLevels() - 1;
+    if (top < 0)
+        return -1;
+
+    for (juce::int64 block = 0; block < getNumBlocks(top); ++block) {
+        if (!blockExceeds(top, block, threshold))
+            continue;
+
+        // Parent min/max are exact bounds of their children, so one child must also exceed.
+        juce::int64 current = block;
+        for (int level = top; level > 0; --level) {
+            const int ratio = getBlockSize(level) / getBlockSize(level - 1);
+            const juce::int64 first = current * ratio;
+            const juce::int64 last = juce::jmin(first + ratio, getNumBlocks(level - 1));
+            juce::int64 child = first;
+            while (child < last && !blockExceeds(level - 1, child, threshold))
+                ++child;
+            jassert(child < last);
+            current = child;
+        }
+        return current;
+    }
+    return -1;
+}
+
+juce::int64 EnvelopeIndex::findLastBlockAbove(float threshold) const {
+    const int top = getNumLevels() - 1;
+    if (top < 0)
+        return -1;
+
+    for (juce::int64 block = getNumBlocks(top) - 1; block >= 0; --block) {
+        if (!blockExceeds(top, block, threshold))
+            continue;
+
+        juce::int64 current = block;
+        for (int level = top; level > 0; --level) {
+            const int ratio = getBlockSize(level) / getBlockSize(level - 1);
+            const juce::int64 first = current * ratio;
+            juce::int64 child = juce::jmin(first + ratio, getNumBlocks(level - 1)) - 1;
+            while (child > first && !blockExceeds(level - 1, child, threshold))
+                --child;
+            current = child;
+        }
+        return current;
+    }
+    return -1;
+}
+
+int EnvelopeIndex::chooseLevel(juce::int64 numSamples) const {
+    int level = 0;
+    while (level + 1 < getNumLevels() && getBlockSize(level + 1) <= numSamples)
+        ++level;
+    return level;
+}
+
+juce::Range<float> EnvelopeIndex::getMinMax(int channel, juce::int64 startSample,
+                                            juce::int64 numSamples) const {
+    if (!juce::isPositiveAndBelow(channel, numChannels) || numSamples <= 0 ||
+        startSample >= lengthInSamples)
+        return {};
+
+    const int level = chooseLevel(numSamples);
+    const float *mins = getMinData(level, channel);
+    const float *maxs = getMaxData(level, channel);
+    const int blockSize = getBlockSize(level);
+    const juce::int64 first = juce::jmax((juce::int64)0, startSample) / blockSize;
+    const juce::int64 last =
+        juce::jmin(getNumBlocks(level), (startSample + numSamples + blockSize - 1) / blockSize);
+
+    float minValue = mins[first];
+    float maxValue = maxs[first];
+    for (juce::int64 block = first + 1; block < last; ++block) {
+        minValue = juce::jmin(minValue, mins[block]);
+        maxValue = juce::jmax(maxValue, maxs[block]);
+    }
+    return {minValue, maxValue};
+}
+
+float EnvelopeIndex::getRms(int channel, juce::int64 startSample, juce::int64 numSamples) const {
+    if (!juce::isPositiveAndBelow(channel, numChannels) || numSamples <= 0 ||
+        startSample >= lengthInSamples)
+        return 0.0f;
+
+    const int level = chooseLevel(numSamples);
+    const float *meanSquares = getMeanSquareData(level, channel);
+    const int blockSize = getBlockSize(level);
+    const juce::int64 first = juce::jmax((juce::int64)0, startSample) / blockSize;
+    const juce::int64 last =
+        juce::jmin(getNumBlocks(level), (startSample + numSamples + blockSize - 1) / blockSize);
+
+    double weightedSquares = 0.0;
+    juce::int64 coveredSamples = 0;
+    for (juce::int64 block = first; block < last; ++block) {
+        const juce::int64 blockStart = block * blockSize;
+        const juce::int64 blockLength =
+            juce::jmin((juce::int64)blockSize, lengthInSamples - blockStart);
+        weightedSquares += (double)meanSquares[block] * blockLength;
+        coveredSamples += blockLength;
+    }
+    return coveredSamples > 0 ? (float)std::sqrt(weightedSquares / (double)coveredSamples) : 0.0f;
+}
@@ -0,0 +1,157 @@
+#ifndef AUDIOFILER_ENVELOPEINDEX_H
+#define AUDIOFILER_ENVELOPEINDEX_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file EnvelopeIndex.h
+ * @ingroup AudioEngine
+ * @brief Multi-resolution peak/RMS envelope of an audio file.
+ * @details Stores min, max and mean-square values per block at several block sizes
+ *          (`Config::Audio::envelopeBaseBlockSize`, multiplied by
+ *          `Config::Audio::envelopeLevelRatio` per level), per channel, in
+ *          structure-of-arrays layout. It is filled once by `EnvelopeBuilder` during a
+ *          single streaming decode and then shared read-only by silence detection, the
+ *          waveform and the stats overlay.
+ *
+ *          Because min/max are exact, a coarse-to-fine walk locates the one base block that
+ *          contains the first (or last) threshold crossing without touching the audio.
+ *
+ * @see EnvelopeBuilder
+ * @see SilenceAnalysisAlgorithms
+ */
+class EnvelopeIndex {
+  public:
+    EnvelopeIndex(int numChannels, juce::int64 lengthInSamples, double sampleRate);
+
+    /**
+     * @brief Wraps envelope data that lives in a memory-mapped file (see AnalysisCache).
+     * @details No copy is made; the mapping is kept alive by the returned index. The data must
+     *          have the layout produced by getRawData() for the same channel count, length and
+     *          current `Config::Audio` envelope settings.
+     * @return The finished index, or nullptr if the mapping is too small.
+     */
+    static std::shared_ptr<EnvelopeIndex>
+    fromMappedFile(std::unique_ptr<juce::MemoryMappedFile> mappedFile, size_t dataOffsetBytes,
+                   int numChannels, juce::int64 lengthInSamples, double sampleRate);
+
+    /**
+     * @brief Appends decoded audio to the finest level.
+     * @details Blocks must arrive in order and `startSample` must be a multiple of the base
+     *          block size; only the final block of the file may be partial.
+     */
+    void addBlock(juce::int64 startSample, const juce::AudioBuffer<float> &buffer,
+                  int numSamples);
+
+    /** @brief Derives the coarser levels from the finest one; call once after the last block. */
+    void finalise();
+
+    /** @brief True once finalise() has run. */
+    bool isComplete() const noexcept {
+        return complete;
+    }
+
+    int getNumChannels() const noexcept {
+        return numChannels;
+    }
+
+    juce::int64 getLengthInSamples() const noexcept {
+        return lengthInSamples;
+    }
+
+    double getSampleRate() const noexcept {
+        return sampleRate;
+    }
+
+    /** @brief Number of resolution levels; level 0 is the finest. */
+    int getNumLevels() const noexcept {
+        return (int)levels.size();
+    }
+
+    /** @brief Samples covered by one block at the given level. */
+    int getBlockSize(int level) const;
+
+    /** @brief Number of blocks at the given level (the last one may be partial). */
+    juce::int64 getNumBlocks(int level) const;
+
+    /** @brief Raw per-block minima of one channel at one level. */
+    const float *getMinData(int level, int channel) const;
+
+    /** @brief Raw per-block maxima of one channel at one level. */
+    const float *getMaxData(int level, int channel) const;
+
+    /** @brief Raw per-block mean-square values of one channel at one level. */
+    const float *getMeanSquareData(int level, int channel) const;
+
+    /** @brief The whole envelope as one contiguous array, for serialisation. */
+    const float *getRawData() const noexcept {
+        return readData;
+    }
+
+    /** @brief Number of floats in getRawData(). */
+    size_t getRawDataSize() const noexcept {
+        return totalFloats;
+    }
+
+    /**
+     * @brief Returns the first finest-level block where any channel has |x| > threshold.
+     * @return The block index (multiply by getBlockSize(0) for samples), or -1 if none.
+     */
+    juce::int64 findFirstBlockAbove(float threshold) const;
+
+    /**
+     * @brief Returns the last finest-level block where any channel has |x| > threshold.
+     * @return The block index, or -1 if none.
+     */
+    juce::int64 findLastBlockAbove(float threshold) const;
+
+    /**
+     * @brief Min/max of a channel over a sample range.
+     * @details Answered from the coarsest level whose block size still fits the range, so the
+     *          result may include up to one block of context on either side.
+     */
+    juce::Range<float> getMinMax(int channel, juce::int64 startSample,
+                                 juce::int64 numSamples) const;
+
+    /** @brief RMS of a channel over a sample range, with the same granularity as getMinMax(). */
+    float getRms(int channel, juce::int64 startSample, juce::int64 numSamples) const;
+
+  private:
+    /** Per level, each channel owns three consecutive arrays: mins, maxs, mean squares. */
+    struct Level {
+        int blockSize{0};
+        juce::int64 numBlocks{0};
+        size_t offset{0};
+    };
+
+    EnvelopeIndex(int numChannels, juce::int64 lengthInSamples, double sampleRate,
+                  bool allocateStorage);
+
+    size_t arrayOffset(int level, int channel, int array) const;
+    bool blockExceeds(int level, juce::int64 block, float threshold) const;
+    int chooseLevel(juce::int64 numSamples) const;
+
+    int numChannels{0};
+    juce::int64 lengthInSamples{0};
+    double sampleRate{0.0};
+    std::vector<Level> levels;
+    size_t totalFloats{0};
+
+    std::vector<float> storage;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    float *writeData{nullptr};
+    const float *readData{nullptr};
+    bool complete{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeIndex)
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "Core/FileIdTable.h"
+
+namespace {
+constexpr size_t kMinSlots = 16;
+}
+
+FileId FileIdTable::find(const juce::String &key) const {
+    if (slots.empty())
+        return invalidFileId;
+
+    const auto hash = (juce::uint64)key.hashCode64();
+    const size_t mask = slots.size() - 1;
+    for (size_t probe = 0; probe < slots.size(); ++probe) {
+        const FileId id = slots[(hash + probe) & mask];
+        if (id == invalidFileId)
+            return invalidFileId;
+        if (hashes[id - 1] == hash && keys[id - 1] == key)
+            return id;
+    }
+    return invalidFileId;
+}
+
+FileId FileIdTable::intern(const juce::String &key) {
+    if (const FileId existing = find(key); existing != invalidFileId)
+        return existing;
+
+    // Keep the load factor at or below one half, so probes stay short.
+    if ((keys.size() + 1) * 2 > slots.size())
+        grow();
+
+    keys.push_back(key);
+    hashes.push_back((juce::uint64)key.hashCode64());
+    const auto id = (FileId)keys.size();
+
+    const size_t mask = slots.size() - 1;
+    size_t index = hashes.back() & mask;
+    while (slots[index] != invalidFileId)
+        index = (index + 1) & mask;
+    slots[index] = id;
+    return id;
+}
+
+const juce::String &FileIdTable::getKey(FileId id) const {
+    jassert(id != invalidFileId && id <= keys.size());
+    return keys[id - 1];
+}
+
+void FileIdTable::grow() {
+    slots.assign(juce::jmax(kMinSlots, slots.size() * 2), invalidFileId);
+    const size_t mask = slots.size() - 1;
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        size_t index = hashes[i] & mask;
+        while (slots[index] != invalidFileId)
+            index = (index + 1) & mask;
+        slots[index] = (FileId)(i + 1);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef AUDIOFILER_FILEIDTABLE_H
+#define AUDIOFILER_FILEIDTABLE_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <vector>
+
+/** @brief A small integer standing for an interned path for the lifetime of its table. */
+using FileId = juce::uint32;
+
+/** @brief Never handed out; marks "no file". */
+constexpr FileId invalidFileId = 0;
+
+/**
+ * @file FileIdTable.h
+ * @ingroup State
+ * @brief Interns paths (or other keys) as dense, stable FileIds.
+ * @details Ids are handed out from 1 upwards and never change or get reused, so callers can
+ *          keep them instead of the string and index flat arrays with them. Interning and
+ *          finding hash the string once and probe a flat open-addressing array of ids; the
+ *          strings themselves are kept once, in id order, sharing the caller's storage.
+ *
+ *          Not thread-safe: the owner serialises access.
+ *
+ * @see MetadataStore
+ */
+class FileIdTable {
+  public:
+    FileIdTable() = default;
+
+    /** @brief The id of `key`, adding it if it is new. */
+    FileId intern(const juce::String &key);
+
+    /** @brief The id of `key`, or invalidFileId if it was never interned. */
+    FileId find(const juce::String &key) const;
+
+    /** @brief The string behind `id`, which must come from this table. */
+    const juce::String &getKey(FileId id) const;
+
+    int size() const {
+        return (int)keys.size();
+    }
+
+  private:
+    void grow();
+
+    std::vector<juce::String> keys;    // keys[id - 1]
+    std::vector<juce::uint64> hashes;  // hashes[id - 1]
+    std::vector<FileId> slots;         // invalidFileId marks an empty slot
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileIdTable)
+};
+
+#endif
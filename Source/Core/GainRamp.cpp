@@ -0,0 +1,58 @@
+#include "Core/GainRamp.h"
+
+#include <cmath>
+
+GainRamp::GainRamp(int length, Config::Audio::FadeCurve curve) {
+    const int numSamples = juce::jmax(0, length);
+    fadeIn.resize((size_t)numSamples);
+    fadeOut.resize((size_t)numSamples);
+
+    // Sample centres, so the two halves of a crossfade are exact mirrors of each other.
+    for (int i = 0; i < numSamples; ++i)
+        fadeIn[(size_t)i] = evaluate(curve, ((float)i + 0.5f) / (float)numSamples);
+    for (int i = 0; i < numSamples; ++i)
+        fadeOut[(size_t)i] = fadeIn[(size_t)(numSamples - 1 - i)];
+}
+
+int GainRamp::getLength() const {
+    return (int)fadeIn.size();
+}
+
+float GainRamp::evaluate(Config::Audio::FadeCurve curve, float position) {
+    switch (curve) {
+    case Config::Audio::FadeCurve::EqualPower:
+        return std::sin(position * juce::MathConstants<float>::halfPi);
+    case Config::Audio::FadeCurve::RaisedCosine:
+        return 0.5f - 0.5f * std::cos(position * juce::MathConstants<float>::pi);
+    case Config::Audio::FadeCurve::Linear:
+        break;
+    }
+    return position;
+}
+
+void GainRamp::applyFadeIn(juce::AudioBuffer<float> &buffer, int startSample, int numSamples,
+                           int rampOffset) const {
+    jassert(rampOffset >= 0 && rampOffset + numSamples <= getLength());
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel, startSample),
+                                              fadeIn.data() + rampOffset, numSamples);
+}
+
+void GainRamp::applyFadeOut(juce::AudioBuffer<float> &buffer, int startSample, int numSamples,
+                            int rampOffset) const {
+    jassert(rampOffset >= 0 && rampOffset + numSamples <= getLength());
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel, startSample),
+                                              fadeOut.data() + rampOffset, numSamples);
+}
+
+void GainRamp::addFadedIn(juce::AudioBuffer<float> &dest, int destStartSample,
+                          const juce::AudioBuffer<float> &source, int numSamples,
+                          int rampOffset) const {
+    jassert(rampOffset >= 0 && rampOffset + numSamples <= getLength());
+    const int numChannels = juce::jmin(dest.getNumChannels(), source.getNumChannels());
+    for (int channel = 0; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::addWithMultiply(
+            dest.getWritePointer(channel, destStartSample), source.getReadPointer(channel),
+            fadeIn.data() + rampOffset, numSamples);
+}
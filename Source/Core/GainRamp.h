@@ -0,0 +1,60 @@
+#ifndef AUDIOFILER_GAINRAMP_H
+#define AUDIOFILER_GAINRAMP_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Utils/Config.h"
+#include <vector>
+
+/**
+ * @file GainRamp.h
+ * @ingroup AudioEngine
+ * @brief Precomputed fade-in and fade-out gain tables applied with vector operations.
+ * @details The tables are built once, off the audio thread, for a fixed length and curve.
+ *          Applying a fade is then a table-driven multiply (or multiply-add for the incoming
+ *          side of a crossfade) over any sub-range of the ramp, so a fade split across blocks
+ *          continues exactly where it stopped and nothing is allocated or evaluated per sample.
+ *
+ *          The fade-out table is the fade-in table reversed. For the equal-power curve the two
+ *          sum to constant power, for the linear and raised-cosine curves to constant gain.
+ *
+ * @see RepeatRegionSource
+ */
+class GainRamp {
+  public:
+    GainRamp(int length, Config::Audio::FadeCurve curve);
+
+    /** @brief Number of samples in a full fade. */
+    int getLength() const;
+
+    /**
+     * @brief Multiplies samples by the fade-in gains from `rampOffset` onwards.
+     * @param rampOffset Samples of the fade already applied before `startSample`.
+     */
+    void applyFadeIn(juce::AudioBuffer<float> &buffer, int startSample, int numSamples,
+                     int rampOffset) const;
+
+    /** @brief Multiplies samples by the fade-out gains from `rampOffset` onwards. */
+    void applyFadeOut(juce::AudioBuffer<float> &buffer, int startSample, int numSamples,
+                      int rampOffset) const;
+
+    /** @brief Adds `source`, faded in from `rampOffset` onwards, to `dest`. */
+    void addFadedIn(juce::AudioBuffer<float> &dest, int destStartSample,
+                    const juce::AudioBuffer<float> &source, int numSamples,
+                    int rampOffset) const;
+
+  private:
+    static float evaluate(Config::Audio::FadeCurve curve, float position);
+
+    std::vector<float> fadeIn;
+    std::vector<float> fadeOut;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainRamp)
+};
+
+#endif
@@ -0,0 +1,624 @@
+#include "Core/MetadataStore.h"
+#include "Utils/Config.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr char kTableMagic[4] = {'A', 'F', 'M', 'T'};
+constexpr char kJournalMagic[4] = {'A', 'F', 'M', 'J'};
+constexpr juce::uint32 kVersion = 1;
+constexpr juce::uint32 kFlagAnalyzed = 1u << 0;
+constexpr int kMinTableSlots = 16;
+/** A journal record longer than this can only be a corrupt length field. */
+constexpr juce::uint32 kMaxRecordBytes = 1u << 16;
+
+/** On-disk headers and slots, in native byte order; a foreign one fails the version check. */
+struct TableHeader {
+    char magic[4];
+    juce::uint32 version;
+    juce::uint32 headerSize;
+    juce::uint32 slotSize;
+    juce::uint64 numSlots;
+    juce::uint64 stringBytes;
+};
+
+/** One hash table entry; its strings live in the heap that follows the slots. */
+struct TableSlot {
+    juce::uint64 keyHash; // 0 marks an empty slot
+    double cutIn;
+    double cutOut;
+    juce::uint32 flags;
+    juce::uint32 pathBytes;
+    juce::uint64 pathOffset;
+    juce::uint32 hashBytes;
+    juce::uint32 reserved;
+    juce::uint64 hashOffset;
+};
+
+struct JournalHeader {
+    char magic[4];
+    juce::uint32 version;
+};
+
+static_assert(sizeof(TableHeader) == 32, "Table header layout must stay fixed");
+static_assert(sizeof(TableSlot) == 56, "Table slot layout must stay fixed");
+static_assert(sizeof(JournalHeader) == 8, "Journal header layout must stay fixed");
+
+/** FNV-1a over the path's UTF-8 bytes; never 0, which marks an empty slot. */
+juce::uint64 hashPath(const char *utf8, size_t numBytes) noexcept {
+    juce::uint64 hash = 14695981039346656037ull;
+    for (size_t i = 0; i < numBytes; ++i)
+        hash = (hash ^ (juce::uint8)utf8[i]) * 1099511628211ull;
+    return hash == 0 ? 1 : hash;
+}
+
+juce::uint32 checksum(const void *data, size_t numBytes) noexcept {
+    const auto *bytes = static_cast<const juce::uint8 *>(data);
+    juce::uint32 sum = 2166136261u;
+    for (size_t i = 0; i < numBytes; ++i)
+        sum = (sum ^ bytes[i]) * 16777619u;
+    return sum;
+}
+
+bool sameRecord(const MetadataStore::Record &a, const MetadataStore::Record &b) {
+    return a.cutIn == b.cutIn && a.cutOut == b.cutOut && a.isAnalyzed == b.isAnalyzed &&
+           a.contentKey == b.contentKey;
+}
+
+// --- Table ---
+
+struct TableView {
+    const char *data{nullptr};
+    TableHeader header{};
+
+    const char *strings() const {
+        return data + sizeof(TableHeader) + header.numSlots * sizeof(TableSlot);
+    }
+
+    TableSlot slot(juce::uint64 index) const {
+        TableSlot result;
+        std::memcpy(&result, data + sizeof(TableHeader) + index * sizeof(TableSlot),
+                    sizeof(TableSlot));
+        return result;
+    }
+
+    bool holds(juce::uint64 offset, juce::uint32 numBytes) const {
+        return offset <= header.stringBytes && numBytes <= header.stringBytes - offset;
+    }
+
+    FileMetadata metadataOf(const TableSlot &entry) const {
+        FileMetadata metadata;
+        metadata.cutIn = entry.cutIn;
+        metadata.cutOut = entry.cutOut;
+        metadata.isAnalyzed = (entry.flags & kFlagAnalyzed) != 0;
+        if (entry.hashBytes > 0 && holds(entry.hashOffset, entry.hashBytes))
+            metadata.hash =
+                juce::String::fromUTF8(strings() + entry.hashOffset, (int)entry.hashBytes);
+        return metadata;
+    }
+};
+
+bool viewTable(const juce::MemoryMappedFile *table, TableView &view) {
+    if (table == nullptr || table->getData() == nullptr ||
+        table->getSize() < sizeof(TableHeader))
+        return false;
+
+    view.data = static_cast<const char *>(table->getData());
+    std::memcpy(&view.header, view.data, sizeof(TableHeader));
+    const auto &header = view.header;
+    if (std::memcmp(header.magic, kTableMagic, sizeof(kTableMagic)) != 0 ||
+        header.version != kVersion || header.headerSize != sizeof(TableHeader) ||
+        header.slotSize != sizeof(TableSlot) || header.numSlots == 0 ||
+        (header.numSlots & (header.numSlots - 1)) != 0)
+        return false;
+
+    const juce::uint64 bodyBytes = table->getSize() - sizeof(TableHeader);
+    return header.numSlots <= bodyBytes / sizeof(TableSlot) &&
+           header.stringBytes <= bodyBytes - header.numSlots * sizeof(TableSlot);
+}
+
+bool findInTable(const juce::MemoryMappedFile *table, const juce::String &path,
+                 FileMetadata &metadataOut) {
+    TableView view;
+    if (!viewTable(table, view))
+        return false;
+
+    const char *utf8 = path.toRawUTF8();
+    const auto numBytes = (juce::uint32)path.getNumBytesAsUTF8();
+    const juce::uint64 keyHash = hashPath(utf8, numBytes);
+    const juce::uint64 mask = view.header.numSlots - 1;
+
+    for (juce::uint64 probe = 0; probe < view.header.numSlots; ++probe) {
+        const TableSlot entry = view.slot((keyHash + probe) & mask);
+        if (entry.keyHash == 0)
+            return false;
+        if (entry.keyHash == keyHash && entry.pathBytes == numBytes &&
+            view.holds(entry.pathOffset, numBytes) &&
+            std::memcmp(view.strings() + entry.pathOffset, utf8, numBytes) == 0) {
+            metadataOut = view.metadataOf(entry);
+            return true;
+        }
+    }
+    return false;
+}
+
+using TableEntries = std::vector<std::pair<juce::String, FileMetadata>>;
+
+bool writeTable(const juce::File &target, const TableEntries &entries) {
+    const int numSlots = juce::nextPowerOfTwo(juce::jmax(kMinTableSlots, (int)entries.size() * 2));
+    const auto mask = (juce::uint64)numSlots - 1;
+    std::vector<TableSlot> slots((size_t)numSlots, TableSlot{});
+    juce::MemoryOutputStream strings;
+
+    for (const auto &[path, metadata] : entries) {
+        const auto pathBytes = path.getNumBytesAsUTF8();
+        TableSlot entry{};
+        entry.keyHash = hashPath(path.toRawUTF8(), pathBytes);
+        entry.cutIn = metadata.cutIn;
+        entry.cutOut = metadata.cutOut;
+        entry.flags = metadata.isAnalyzed ? kFlagAnalyzed : 0u;
+        entry.pathOffset = (juce::uint64)strings.getPosition();
+        entry.pathBytes = (juce::uint32)pathBytes;
+        strings.write(path.toRawUTF8(), pathBytes);
+        entry.hashOffset = (juce::uint64)strings.getPosition();
+        entry.hashBytes = (juce::uint32)metadata.hash.getNumBytesAsUTF8();
+        strings.write(metadata.hash.toRawUTF8(), entry.hashBytes);
+
+        juce::uint64 index = entry.keyHash & mask;
+        while (slots[(size_t)index].keyHash != 0)
+            index = (index + 1) & mask;
+        slots[(size_t)index] = entry;
+    }
+
+    TableHeader header{};
+    std::memcpy(header.magic, kTableMagic, sizeof(kTableMagic));
+    header.version = kVersion;
+    header.headerSize = (juce::uint32)sizeof(TableHeader);
+    header.slotSize = (juce::uint32)sizeof(TableSlot);
+    header.numSlots = (juce::uint64)numSlots;
+    header.stringBytes = (juce::uint64)strings.getDataSize();
+
+    juce::FileOutputStream out(target);
+    if (!out.openedOk() || !out.write(&header, sizeof(header)) ||
+        !out.write(slots.data(), slots.size() * sizeof(TableSlot)) ||
+        !out.write(strings.getData(), strings.getDataSize()))
+        return false;
+    out.flush();
+    return out.getStatus().wasOk();
+}
+
+// --- Journal ---
+
+void writeString(juce::MemoryOutputStream &out, const juce::String &text) {
+    const auto numBytes = text.getNumBytesAsUTF8();
+    out.writeInt((int)numBytes);
+    out.write(text.toRawUTF8(), numBytes);
+}
+
+bool readString(juce::MemoryInputStream &in, juce::String &text) {
+    const auto numBytes = (juce::uint32)in.readInt();
+    if (numBytes > (juce::uint64)in.getNumBytesRemaining())
+        return false;
+    const auto *data = static_cast<const char *>(in.getData()) + in.getPosition();
+    text = juce::String::fromUTF8(data, (int)numBytes);
+    return in.setPosition(in.getPosition() + numBytes);
+}
+
+/** Record layout: payload size, payload checksum, then the payload itself. */
+void appendRecord(juce::MemoryOutputStream &out, const juce::String &path,
+                  const FileMetadata &metadata) {
+    juce::MemoryOutputStream payload;
+    payload.writeDouble(metadata.cutIn);
+    payload.writeDouble(metadata.cutOut);
+    payload.writeInt((int)(metadata.isAnalyzed ? kFlagAnalyzed : 0u));
+    writeString(payload, path);
+    writeString(payload, metadata.hash);
+
+    out.writeInt((int)payload.getDataSize());
+    out.writeInt((int)checksum(payload.getData(), payload.getDataSize()));
+    out.write(payload.getData(), payload.getDataSize());
+}
+
+/** Reads the next record; false at the end of the journal or at the first damaged record. */
+bool readRecord(juce::MemoryInputStream &in, juce::String &path, FileMetadata &metadata) {
+    if (in.getNumBytesRemaining() < 8)
+        return false;
+    const auto numBytes = (juce::uint32)in.readInt();
+    const auto sum = (juce::uint32)in.readInt();
+    if (numBytes > kMaxRecordBytes || numBytes > (juce::uint64)in.getNumBytesRemaining())
+        return false;
+
+    const auto *data = static_cast<const char *>(in.getData()) + in.getPosition();
+    if (checksum(data, numBytes) != sum)
+        return false;
+    in.skipNextBytes(numBytes);
+
+    juce::MemoryInputStream payload(data, numBytes, false);
+    metadata.cutIn = payload.readDouble();
+    metadata.cutOut = payload.readDouble();
+    metadata.isAnalyzed = ((juce::uint32)payload.readInt() & kFlagAnalyzed) != 0;
+    return readString(payload, path) && readString(payload, metadata.hash);
+}
+} // namespace
+
+MetadataStore::MetadataStore() : juce::Thread("MetadataStore"), persistent(false) {
+}
+
+MetadataStore::MetadataStore(const juce::File &directoryIn)
+    : juce::Thread("MetadataStore"), directory(directoryIn), persistent(true) {
+    open();
+    startThread(juce::Thread::Priority::background);
+}
+
+MetadataStore::~MetadataStore() {
+    if (!persistent)
+        return;
+    stopThread(4000);
+    writePending();
+}
+
+juce::File MetadataStore::getDefaultDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("audiofiler")
+        .getChildFile("Session");
+}
+
+juce::File MetadataStore::getJournalFile() const {
+    return directory.getChildFile("metadata.afjournal");
+}
+
+juce::File MetadataStore::getTableFile() const {
+    return directory.getChildFile("metadata.aftable");
+}
+
+int MetadataStore::getNumJournalRecords() const {
+    return numJournalRecords.load();
+}
+
+FileId MetadataStore::internLocked(const juce::String &path, const FileMetadata *stored) {
+    if (const FileId existing = paths.find(path); existing != invalidFileId)
+        return existing;
+
+    const FileId id = paths.intern(path);
+    entries.resize((size_t)id + 1);
+    if (stored != nullptr)
+        entries[id] = {toRecord(*stored), 0, State::clean};
+    return id;
+}
+
+MetadataStore::Record MetadataStore::toRecord(const FileMetadata &metadata) {
+    Record record;
+    record.cutIn = metadata.cutIn;
+    record.cutOut = metadata.cutOut;
+    record.isAnalyzed = metadata.isAnalyzed;
+    if (metadata.hash.isNotEmpty())
+        record.contentKey = contentKeys.intern(metadata.hash);
+    return record;
+}
+
+FileMetadata MetadataStore::toMetadata(const Record &record) const {
+    FileMetadata metadata;
+    metadata.cutIn = record.cutIn;
+    metadata.cutOut = record.cutOut;
+    metadata.isAnalyzed = record.isAnalyzed;
+    if (record.contentKey != invalidFileId)
+        metadata.hash = contentKeys.getKey(record.contentKey);
+    return metadata;
+}
+
+void MetadataStore::storeLocked(FileId id, const Record &record) {
+    auto &entry = entries[id];
+    if (entry.state != State::absent && sameRecord(entry.record, record))
+        return;
+
+    if (entry.state != State::pending)
+        pendingIds.push_back(id);
+    entry = {record, nextSequence++, State::pending};
+}
+
+FileId MetadataStore::intern(const juce::String &path) {
+    std::shared_ptr<const juce::MemoryMappedFile> mapped;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (const FileId existing = paths.find(path); existing != invalidFileId)
+            return existing;
+        mapped = table;
+    }
+
+    // Probed without the lock, so a page fault on the table holds up no other caller. A path
+    // that is not interned has never been changed, so every table agrees on it.
+    FileMetadata stored;
+    const bool found = findInTable(mapped.get(), path, stored);
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    return internLocked(path, found ? &stored : nullptr);
+}
+
+bool MetadataStore::get(FileId id, FileMetadata &metadataOut) const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (id == invalidFileId || id >= entries.size() || entries[id].state == State::absent)
+        return false;
+    metadataOut = toMetadata(entries[id].record);
+    return true;
+}
+
+bool MetadataStore::get(const juce::String &path, FileMetadata &metadataOut) const {
+    std::shared_ptr<const juce::MemoryMappedFile> mapped;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        // A path seen before is answered from memory; any other one straight from the table.
+        if (const FileId id = paths.find(path); id != invalidFileId) {
+            if (entries[id].state == State::absent)
+                return false;
+            metadataOut = toMetadata(entries[id].record);
+            return true;
+        }
+        mapped = table;
+    }
+    return findInTable(mapped.get(), path, metadataOut);
+}
+
+bool MetadataStore::contains(const juce::String &path) const {
+    FileMetadata unused;
+    return get(path, unused);
+}
+
+void MetadataStore::put(FileId id, const FileMetadata &metadata) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (id != invalidFileId && id < entries.size())
+        storeLocked(id, toRecord(metadata));
+}
+
+void MetadataStore::put(const juce::String &path, const FileMetadata &metadata) {
+    const FileId id = intern(path);
+    const std::lock_guard<std::mutex> lock(mutex);
+    storeLocked(id, toRecord(metadata));
+}
+
+void MetadataStore::update(FileId id, const std::function<void(Record &)> &change) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (id == invalidFileId || id >= entries.size())
+        return;
+    Record record = entries[id].record;
+    change(record);
+    storeLocked(id, record);
+}
+
+void MetadataStore::flush() {
+    writePending();
+}
+
+void MetadataStore::compact() {
+    if (!persistent)
+        return;
+    const std::lock_guard<std::mutex> io(ioMutex);
+    if (appendPending())
+        compactJournaled();
+}
+
+void MetadataStore::run() {
+    while (!threadShouldExit()) {
+        wait(Config::Cache::metadataFlushIntervalMs);
+        writePending();
+    }
+}
+
+void MetadataStore::open() {
+    directory.createDirectory();
+
+    auto mapping = std::make_unique<juce::MemoryMappedFile>(getTableFile(),
+                                                            juce::MemoryMappedFile::readOnly);
+    TableView view;
+    if (viewTable(mapping.get(), view))
+        table = std::move(mapping);
+
+    replayJournal();
+}
+
+void MetadataStore::replayJournal() {
+    const juce::File file = getJournalFile();
+    juce::MemoryBlock data;
+    JournalHeader header{};
+    if (file.existsAsFile() && file.loadFileAsData(data) && data.getSize() >= sizeof(header))
+        std::memcpy(&header, data.getData(), sizeof(header));
+    if (std::memcmp(header.magic, kJournalMagic, sizeof(kJournalMagic)) != 0 ||
+        header.version != kVersion) {
+        rewriteJournal();
+        return;
+    }
+
+    juce::MemoryInputStream in(data, false);
+    in.skipNextBytes(sizeof(header));
+    juce::int64 validBytes = in.getPosition();
+    juce::String path;
+    FileMetadata metadata;
+    int numRecords = 0;
+    while (readRecord(in, path, metadata)) {
+        // Replay overwrites whatever the table holds for the path, so it is not probed.
+        const FileId id = internLocked(path, nullptr);
+        if (entries[id].state != State::journaled)
+            journaledIds.push_back(id);
+        entries[id] = {toRecord(metadata), nextSequence++, State::journaled};
+        validBytes = in.getPosition();
+        ++numRecords;
+    }
+    numJournalRecords = numRecords;
+
+    // Appending resumes after the last whole record; a torn tail from a crash is dropped.
+    journal = std::make_unique<juce::FileOutputStream>(file);
+    if (journal->openedOk() && validBytes < (juce::int64)data.getSize() &&
+        (!journal->setPosition(validBytes) || journal->truncate().failed()))
+        journal.reset();
+    if (journal != nullptr && !journal->openedOk())
+        journal.reset();
+}
+
+std::vector<MetadataStore::Change> MetadataStore::copyPending() const {
+    std::vector<Change> changes;
+    const std::lock_guard<std::mutex> lock(mutex);
+    for (const FileId id : pendingIds)
+        changes.push_back(
+            {id, paths.getKey(id), toMetadata(entries[id].record), entries[id].sequence});
+    return changes;
+}
+
+void MetadataStore::markJournaled(const std::vector<Change> &changes) {
+    // A put() since the copy is newer than what was written; it stays pending.
+    const std::lock_guard<std::mutex> lock(mutex);
+    std::vector<FileId> stillPending;
+    for (const auto &change : changes) {
+        auto &entry = entries[change.id];
+        if (entry.sequence != change.sequence) {
+            stillPending.push_back(change.id);
+        } else {
+            entry.state = State::journaled;
+            journaledIds.push_back(change.id);
+        }
+    }
+    // Ids made pending during the write were appended after the ones copied.
+    const auto numCopied = (std::ptrdiff_t)changes.size();
+    pendingIds.erase(pendingIds.begin(), pendingIds.begin() + numCopied);
+    pendingIds.insert(pendingIds.end(), stillPending.begin(), stillPending.end());
+}
+
+bool MetadataStore::rewriteJournal() {
+    const std::vector<Change> changes = copyPending();
+
+    JournalHeader header{};
+    std::memcpy(header.magic, kJournalMagic, sizeof(kJournalMagic));
+    header.version = kVersion;
+    juce::MemoryOutputStream contents;
+    contents.write(&header, sizeof(header));
+    for (const auto &change : changes)
+        appendRecord(contents, change.path, change.metadata);
+
+    // Synced under a temporary name and renamed over the old journal, so a crash leaves
+    // either the old journal or the complete new one, never an empty one.
+    juce::TemporaryFile temp(getJournalFile());
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk() || !out.write(contents.getData(), contents.getDataSize()))
+            return false;
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+    if (!temp.overwriteTargetFileWithTemporary())
+        return false;
+
+    journal = std::make_unique<juce::FileOutputStream>(getJournalFile());
+    if (!journal->openedOk())
+        journal.reset();
+
+    // The records are on disk even if the journal cannot be reopened for appending.
+    markJournaled(changes);
+    numJournalRecords = (int)changes.size();
+    return journal != nullptr;
+}
+
+bool MetadataStore::appendPending() {
+    const std::vector<Change> changes = copyPending();
+    if (changes.empty())
+        return true;
+    if (journal == nullptr)
+        return false;
+
+    juce::MemoryOutputStream records;
+    for (const auto &change : changes)
+        appendRecord(records, change.path, change.metadata);
+    if (!journal->write(records.getData(), records.getDataSize()))
+        return false;
+    journal->flush();
+    if (journal->getStatus().failed())
+        return false;
+
+    markJournaled(changes);
+    numJournalRecords += (int)changes.size();
+    return true;
+}
+
+void MetadataStore::writePending() {
+    if (!persistent)
+        return;
+    const std::lock_guard<std::mutex> io(ioMutex);
+    if (appendPending() && numJournalRecords >= Config::Cache::metadataCompactAfterRecords)
+        compactJournaled();
+}
+
+void MetadataStore::compactJournaled() {
+    // Only journaled changes go into the new table. If the process dies before the journal is
+    // replaced, replaying the old journal over the new table still gives the same result.
+#if JUCE_UNIT_TESTS
+    if (compactionHook != nullptr)
+        compactionHook(CompactionStep::started);
+#endif
+    std::vector<Change> journaled;
+    FileIdTable merged;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (const FileId id : journaledIds) {
+            const auto &entry = entries[id];
+            const auto &path = paths.getKey(id);
+            if (entry.state != State::journaled || merged.find(path) != invalidFileId)
+                continue;
+            merged.intern(path);
+            journaled.push_back({id, path, toMetadata(entry.record), entry.sequence});
+        }
+    }
+
+    TableEntries tableEntries;
+    TableView view;
+    if (viewTable(table.get(), view)) {
+        for (juce::uint64 index = 0; index < view.header.numSlots; ++index) {
+            const TableSlot slot = view.slot(index);
+            if (slot.keyHash == 0 || !view.holds(slot.pathOffset, slot.pathBytes))
+                continue;
+            auto path =
+                juce::String::fromUTF8(view.strings() + slot.pathOffset, (int)slot.pathBytes);
+            if (merged.find(path) == invalidFileId)
+                tableEntries.emplace_back(std::move(path), view.metadataOf(slot));
+        }
+    }
+    for (const auto &change : journaled)
+        tableEntries.emplace_back(change.path, change.metadata);
+
+    juce::TemporaryFile temp(getTableFile());
+    if (!writeTable(temp.getFile(), tableEntries))
+        return;
+
+    // Renamed and mapped before the lock is taken. The old mapping stays readable after the
+    // rename, so lookups keep probing it meanwhile and the lock only covers the exchange.
+    // Without the new table every change stays in memory and in the journal.
+    if (!temp.overwriteTargetFileWithTemporary())
+        return;
+    std::shared_ptr<const juce::MemoryMappedFile> mapping =
+        std::make_shared<juce::MemoryMappedFile>(getTableFile(), juce::MemoryMappedFile::readOnly);
+    if (!viewTable(mapping.get(), view))
+        return;
+
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        // The old mapping is unmapped outside the lock, by whichever holder drops it last.
+        table.swap(mapping);
+
+        // Anything changed since the copy is pending again and goes to the new journal. Its
+        // last journaled value may be missing from the new table, so the old journal is only
+        // dropped once the new one holds the change.
+        for (const auto &change : journaled)
+            if (entries[change.id].sequence == change.sequence)
+                entries[change.id].state = State::clean;
+        journaledIds.clear();
+    }
+#if JUCE_UNIT_TESTS
+    if (compactionHook != nullptr)
+        compactionHook(CompactionStep::tableSwapped);
+#endif
+
+    rewriteJournal();
+#if JUCE_UNIT_TESTS
+    if (compactionHook != nullptr)
+        compactionHook(CompactionStep::journalReplaced);
+#endif
+}
@@ -0,0 +1,193 @@
+#ifndef AUDIOFILER_METADATASTORE_H
+#define AUDIOFILER_METADATASTORE_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/FileIdTable.h"
+#include "Core/FileMetadata.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file MetadataStore.h
+ * @ingroup State
+ * @brief Persistent per-path FileMetadata: a memory-mapped hash table plus an append-only
+ *        journal of the changes made since it was written.
+ * @details Two files live in the store's directory:
+ *
+ *          - **Table** (`metadata.aftable`): an open-addressing hash table of fixed-size slots
+ *            keyed by a 64-bit hash of the path, followed by the path and content-key strings.
+ *            It is memory-mapped and probed in place, so opening it reads nothing and a lookup
+ *            touches one or two pages however many files it holds.
+ *          - **Journal** (`metadata.afjournal`): checksummed records appended by put(). On open
+ *            they are replayed into memory over the table; a torn record at the end (a crash
+ *            mid-write) is cut off and everything before it kept.
+ *
+ *          put() only changes memory. A background thread appends the changed records every
+ *          `Config::Cache::metadataFlushIntervalMs` and syncs them to disk, so a crash loses
+ *          at most that much editing. Once the journal holds
+ *          `Config::Cache::metadataCompactAfterRecords` records the same thread merges them
+ *          into a new table, swaps it in and renames a new journal over the old one that holds
+ *          only the changes made since, which bounds the replay at startup. A crash at any
+ *          point leaves a table and journal that replay to the last synced state.
+ *
+ *          In memory, paths are interned as FileIds and each id indexes a flat array of
+ *          plain Records, so a caller that keeps the handle pays no hashing, string compares
+ *          or string copies per access. Content keys are interned the same way.
+ *
+ *          All methods may be called from any thread. Lookups take a short lock over the
+ *          in-memory state only: the mapped table is probed outside it, and a compaction renames
+ *          and maps the new table before taking it just to exchange the mapping. Neither a page
+ *          fault on the table nor a compaction can stall a caller, such as a marker drag.
+ *
+ * @see SessionState
+ * @see FileMetadata
+ */
+class MetadataStore : private juce::Thread {
+  public:
+    /** @brief FileMetadata as it is kept: plain values, with the content key interned. */
+    struct Record {
+        double cutIn{0.0};
+        double cutOut{0.0};
+        bool isAnalyzed{false};
+        FileId contentKey{invalidFileId};
+    };
+
+    /** @brief A store that lives in memory only; nothing is read or written. */
+    MetadataStore();
+
+    /** @brief Opens, or creates, the store in `directory`, and starts its writer thread. */
+    explicit MetadataStore(const juce::File &directory);
+
+    ~MetadataStore() override;
+
+    /** @brief `<user application data>/audiofiler/Session`. */
+    static juce::File getDefaultDirectory();
+
+    /**
+     * @brief The handle for `path`, valid for the store's lifetime.
+     * @details The first call for a path hashes it and probes the table; calls through the
+     *          handle afterwards index an array.
+     */
+    FileId intern(const juce::String &path);
+
+    /** @brief Copies the metadata stored for `path` into `metadataOut`, if there is any. */
+    bool get(const juce::String &path, FileMetadata &metadataOut) const;
+    bool get(FileId id, FileMetadata &metadataOut) const;
+
+    bool contains(const juce::String &path) const;
+
+    /** @brief Stores `metadata` for `path`; does nothing if it is already stored. */
+    void put(const juce::String &path, const FileMetadata &metadata);
+    void put(FileId id, const FileMetadata &metadata);
+
+    /** @brief Applies `change` to the record for `id`, starting from defaults if it has none. */
+    void update(FileId id, const std::function<void(Record &)> &change);
+
+    /** @brief Writes all changes to the journal now and waits until they are on disk. */
+    void flush();
+
+    /** @brief Merges the journal into a new table now and waits until it is done. */
+    void compact();
+
+    /** @brief Records in the journal that the next compaction will merge. */
+    int getNumJournalRecords() const;
+
+    juce::File getJournalFile() const;
+    juce::File getTableFile() const;
+
+#if JUCE_UNIT_TESTS
+
+    /** @brief Points in a compaction where a test may change the store or copy its files. */
+    enum class CompactionStep { started, tableSwapped, journalReplaced };
+
+    /**
+     * @brief Called at each CompactionStep on the compacting thread, between file writes.
+     * @details The hook may put() but not flush() or compact(), which wait for the files.
+     */
+    void setCompactionHookForTesting(std::function<void(CompactionStep)> hook) {
+        compactionHook = std::move(hook);
+    }
+#endif
+
+  private:
+    enum class State : juce::uint8 {
+        absent,    // nothing stored for the path
+        clean,     // as in the table
+        pending,   // changed in memory only
+        journaled, // changed in the journal, not yet in the table
+    };
+
+    struct Entry {
+        Record record;
+        juce::uint64 sequence{0};
+        State state{State::absent};
+    };
+
+    /** A change copied out of the store, so the files can be written without its lock. */
+    struct Change {
+        FileId id;
+        juce::String path;
+        FileMetadata metadata;
+        juce::uint64 sequence;
+    };
+
+    void run() override;
+    void open();
+    void replayJournal();
+    std::vector<Change> copyPending() const;
+    /** Marks copied changes as journaled, unless they have changed again since. */
+    void markJournaled(const std::vector<Change> &changes);
+    /**
+     * Replaces the journal with one holding just the pending changes, in a single rename.
+     * Call with `ioMutex` held.
+     */
+    bool rewriteJournal();
+    /** Appends every pending change and syncs the journal. Call with `ioMutex` held. */
+    bool appendPending();
+    void writePending();
+    /** Folds the journaled changes into a new table. Call with `ioMutex` held. */
+    void compactJournaled();
+
+    // Call with `mutex` held.
+    /** Interns `path`, as `stored` if the caller found it in the table, else as absent. */
+    FileId internLocked(const juce::String &path, const FileMetadata *stored);
+    Record toRecord(const FileMetadata &metadata);
+    FileMetadata toMetadata(const Record &record) const;
+    void storeLocked(FileId id, const Record &record);
+
+    juce::File directory;
+    const bool persistent;
+
+    mutable std::mutex mutex;
+    FileIdTable paths;
+    FileIdTable contentKeys;
+    /** Indexed by FileId; covers every path interned, read or written this session. */
+    std::vector<Entry> entries;
+    std::vector<FileId> pendingIds;
+    std::vector<FileId> journaledIds;
+    /** Exchanged under `mutex`; lookups copy it and probe the mapping without the lock. */
+    std::shared_ptr<const juce::MemoryMappedFile> table;
+    juce::uint64 nextSequence{1};
+
+    /** Serialises everything that touches the files; lookups never take it, and `mutex` is
+        never held across file I/O. */
+    std::mutex ioMutex;
+    std::unique_ptr<juce::FileOutputStream> journal;
+    std::atomic<int> numJournalRecords{0};
+
+#if JUCE_UNIT_TESTS
+    std::function<void(CompactionStep)> compactionHook;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetadataStore)
+};
+
+#endif
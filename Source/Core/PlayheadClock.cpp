@@ -0,0 +1,45 @@
+#include "Core/PlayheadClock.h"
+#include "Utils/Config.h"
+
+#include <cmath>
+
+void PlayheadClock::publish(juce::uint32 blockGeneration, double positionSeconds,
+                            double blockSeconds, bool playing, double nowMs) noexcept {
+    // A seek landed while this block was rendered; its position may predate it.
+    if (blockGeneration != generation.load(std::memory_order_acquire)) {
+        filterPrimed = false;
+        return;
+    }
+
+    const double blockMs = blockSeconds * 1000.0;
+    double timeMs = nowMs;
+    if (filterPrimed && playing) {
+        const double expectedMs = filteredMs + lastBlockMs;
+        const double errorMs = nowMs - expectedMs;
+        // A larger error is a dropout or a device restart rather than jitter: start over.
+        if (std::abs(errorMs) < lastBlockMs)
+            timeMs = expectedMs + errorMs * Config::Audio::playheadClockSmoothing;
+    }
+
+    filterPrimed = playing;
+    filteredMs = timeMs;
+    lastBlockMs = blockMs;
+    stamp.publishFromSingleWriter({positionSeconds, timeMs, blockMs, blockGeneration, playing});
+}
+
+void PlayheadClock::invalidate() noexcept {
+    generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool PlayheadClock::predict(double nowMs, double &positionSeconds) const noexcept {
+    Stamp latest;
+    if (!stamp.tryRead(latest) || !latest.playing ||
+        latest.generation != generation.load(std::memory_order_acquire))
+        return false;
+
+    // Never run far past the last block: if callbacks stop, the cursor stops too.
+    const double maxLeadMs = latest.blockMs * Config::Audio::playheadMaxLeadBlocks;
+    const double elapsedMs = juce::jlimit(0.0, maxLeadMs, nowMs - latest.timeMs);
+    positionSeconds = latest.positionSeconds + elapsedMs / 1000.0;
+    return true;
+}
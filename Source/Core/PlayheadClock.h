@@ -0,0 +1,88 @@
+#ifndef AUDIOFILER_PLAYHEADCLOCK_H
+#define AUDIOFILER_PLAYHEADCLOCK_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Utils/LockFreeSnapshot.h"
+#include <atomic>
+
+/**
+ * @file PlayheadClock.h
+ * @ingroup AudioEngine
+ * @brief Predicts the playhead between audio callbacks from the time each block was rendered.
+ * @details The transport's position only moves once per audio block, so a cursor that reads
+ *          it steps by a whole buffer and lags by up to one. Instead, the audio thread stamps
+ *          every block with the transport position of its first sample and the time it was
+ *          rendered, and readers extrapolate from the latest stamp to "now".
+ *
+ *          Callback times jitter with scheduling, so the stamped time is filtered: each
+ *          callback is expected one block after the previous one, and only a small part of the
+ *          measured difference (`Config::Audio::playheadClockSmoothing`) is taken over. That
+ *          keeps the predicted position steady to well under a millisecond while still
+ *          following the device's real clock.
+ *
+ *          A seek makes the last stamp meaningless, so invalidate() retires it until the audio
+ *          thread has stamped a block at the new position. Stamps travel through a
+ *          LockFreeSnapshot, so neither side ever blocks.
+ *
+ * @see AudioPlayer
+ * @see LockFreeSnapshot
+ */
+class PlayheadClock {
+  public:
+    PlayheadClock() = default;
+
+    /**
+     * @brief Opens an audio block; pass the result to publish() once it is rendered.
+     * @details Read before the transport position, so a seek racing the block is detected.
+     */
+    juce::uint32 beginBlock() const noexcept {
+        return generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Stamps a block. Audio thread only.
+     * @param blockGeneration What beginBlock() returned for this block.
+     * @param positionSeconds Transport position of the block's first sample.
+     * @param blockSeconds Duration of the block.
+     * @param playing Whether the transport was running; a stopped clock is never extrapolated.
+     * @param nowMs Time of the callback, from `juce::Time::getMillisecondCounterHiRes()`.
+     */
+    void publish(juce::uint32 blockGeneration, double positionSeconds, double blockSeconds,
+                 bool playing, double nowMs) noexcept;
+
+    /** @brief Discards the last stamp, e.g. after a seek. Call after moving the transport. */
+    void invalidate() noexcept;
+
+    /**
+     * @brief Predicts the transport position at `nowMs`.
+     * @return False if there is no usable stamp: stopped, just sought, or racing a publish.
+     *         The transport's own position is then the best answer.
+     */
+    bool predict(double nowMs, double &positionSeconds) const noexcept;
+
+  private:
+    struct Stamp {
+        double positionSeconds{0.0};
+        double timeMs{0.0};
+        double blockMs{0.0};
+        juce::uint32 generation{0};
+        bool playing{false};
+    };
+
+    LockFreeSnapshot<Stamp> stamp;
+    std::atomic<juce::uint32> generation{1};
+
+    // Filter state, touched by the audio thread only.
+    bool filterPrimed{false};
+    double filteredMs{0.0};
+    double lastBlockMs{0.0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlayheadClock)
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "Core/Playlist.h"
+
+#include <algorithm>
+
+void Playlist::setFiles(const juce::Array<juce::File> &newFiles, const juce::File &current) {
+    files = newFiles;
+    std::sort(files.begin(), files.end());
+    files.removeRange((int)(std::unique(files.begin(), files.end()) - files.begin()),
+                      files.size());
+
+    currentIndex = files.isEmpty() ? -1 : juce::jmax(0, files.indexOf(current));
+}
+
+juce::Array<juce::File> Playlist::listFolderOf(const juce::File &file,
+                                               const juce::String &wildcard) {
+    auto siblings = file.getParentDirectory().findChildFiles(juce::File::findFiles, false,
+                                                             wildcard);
+    siblings.addIfNotAlreadyThere(file);
+    return siblings;
+}
+
+juce::File Playlist::getCurrent() const {
+    return files[currentIndex];
+}
+
+bool Playlist::hasNext() const {
+    return currentIndex + 1 < files.size();
+}
+
+bool Playlist::hasPrevious() const {
+    return currentIndex > 0;
+}
+
+juce::File Playlist::moveToNext() {
+    if (!hasNext())
+        return {};
+    return files[++currentIndex];
+}
+
+juce::File Playlist::moveToPrevious() {
+    if (!hasPrevious())
+        return {};
+    return files[--currentIndex];
+}
+
+juce::Array<juce::File> Playlist::getUpcoming(int numFiles) const {
+    juce::Array<juce::File> upcoming;
+    for (int i = currentIndex + 1; i < files.size() && upcoming.size() < numFiles; ++i)
+        upcoming.add(files[i]);
+    return upcoming;
+}
@@ -0,0 +1,67 @@
+#ifndef AUDIOFILER_PLAYLIST_H
+#define AUDIOFILER_PLAYLIST_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+/**
+ * @file Playlist.h
+ * @ingroup State
+ * @brief The ordered queue of files the operator works through, and the position in it.
+ * @details Filled from the files picked in the open dialog: several files become the queue as
+ *          they are, a single file brings its whole folder along so reviews can step through
+ *          it without reopening the dialog. Paths are sorted the same way the batch tool sorts
+ *          them. Message thread only, except for listFolderOf().
+ *
+ * @see FilePrefetcher
+ * @see MainComponent
+ */
+class Playlist {
+  public:
+    Playlist() = default;
+
+    /** @brief Queues `files` in path order and makes `current` (or the first file) current. */
+    void setFiles(const juce::Array<juce::File> &files, const juce::File &current = {});
+
+    /**
+     * @brief Every file matching `wildcard` in `file`'s folder, `file` included. Any thread.
+     * @details Lists the directory, which can stall on a slow or network volume, so callers
+     *          run it off the message thread and pass the result to setFiles().
+     */
+    static juce::Array<juce::File> listFolderOf(const juce::File &file,
+                                                const juce::String &wildcard);
+
+    /** @brief The current file, or a default File if the playlist is empty. */
+    juce::File getCurrent() const;
+
+    int getCurrentIndex() const {
+        return currentIndex;
+    }
+
+    int size() const {
+        return files.size();
+    }
+
+    bool hasNext() const;
+    bool hasPrevious() const;
+
+    /** @brief Steps forward and returns the new current file; a default File at the end. */
+    juce::File moveToNext();
+
+    /** @brief Steps back and returns the new current file; a default File at the start. */
+    juce::File moveToPrevious();
+
+    /** @brief Up to `numFiles` files after the current one, nearest first. */
+    juce::Array<juce::File> getUpcoming(int numFiles) const;
+
+  private:
+    juce::Array<juce::File> files;
+    int currentIndex{-1};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Playlist)
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include "Core/ReadAheadBuffer.h"
+#include "Utils/Config.h"
+
+ReadAheadBuffer::ReadAheadBuffer(juce::PositionableAudioSource &source,
+                                 juce::TimeSliceThread &readThread, int numChannels,
+                                 int bufferSize, juce::int64 startPosition)
+    : input(source), thread(readThread),
+      ring(juce::jmax(1, numChannels), juce::jmax(1, bufferSize)), seekTarget(startPosition),
+      position(startPosition), readStart(startPosition) {
+    ring.clear();
+    input.setNextReadPosition(startPosition);
+    thread.addTimeSliceClient(this);
+}
+
+ReadAheadBuffer::~ReadAheadBuffer() {
+    thread.removeTimeSliceClient(this);
+}
+
+void ReadAheadBuffer::seek(juce::int64 newPosition) {
+    seekTarget.store(newPosition, std::memory_order_relaxed);
+    requestedGeneration.fetch_add(1, std::memory_order_release);
+    thread.moveToFrontOfQueue(this);
+}
+
+bool ReadAheadBuffer::takeSeek() noexcept {
+    const juce::uint32 requested = requestedGeneration.load(std::memory_order_acquire);
+    if (requested == consumerGeneration.load(std::memory_order_relaxed))
+        return false;
+
+    position.store(seekTarget.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    consumed.store(0, std::memory_order_relaxed);
+    consumerGeneration.store(requested, std::memory_order_release);
+    return true;
+}
+
+juce::int64 ReadAheadBuffer::getPosition() const noexcept {
+    const juce::uint32 requested = requestedGeneration.load(std::memory_order_acquire);
+    if (requested != consumerGeneration.load(std::memory_order_acquire))
+        return seekTarget.load(std::memory_order_relaxed);
+    return position.load(std::memory_order_relaxed);
+}
+
+bool ReadAheadBuffer::isFinished() const noexcept {
+    if (requestedGeneration.load(std::memory_order_acquire) !=
+        consumerGeneration.load(std::memory_order_acquire))
+        return false;
+    return position.load(std::memory_order_relaxed) >= input.getTotalLength();
+}
+
+int ReadAheadBuffer::getNumReady() const noexcept {
+    if (producerGeneration.load(std::memory_order_acquire) !=
+        consumerGeneration.load(std::memory_order_relaxed))
+        return 0;
+
+    // A region that shrinks after it was read ahead ends playback at its new end.
+    const juce::int64 ready = written.load(std::memory_order_acquire) -
+                              consumed.load(std::memory_order_relaxed);
+    const juce::int64 remaining = input.getTotalLength() - position.load(std::memory_order_relaxed);
+    return (int)juce::jlimit((juce::int64)0, (juce::int64)ring.getNumSamples(),
+                             juce::jmin(ready, remaining));
+}
+
+void ReadAheadBuffer::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    input.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void ReadAheadBuffer::releaseResources() {
+    input.releaseResources();
+}
+
+void ReadAheadBuffer::getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) {
+    const int numSamples = juce::jmin(bufferToFill.numSamples, getNumReady());
+    const juce::int64 done = consumed.load(std::memory_order_relaxed);
+    const int size = ring.getNumSamples();
+    const int start = (int)(done % size);
+    const int firstPart = juce::jmin(numSamples, size - start);
+
+    auto &out = *bufferToFill.buffer;
+    for (int channel = 0; channel < out.getNumChannels(); ++channel) {
+        const int source = channel % ring.getNumChannels();
+        out.copyFrom(channel, bufferToFill.startSample, ring, source, start, firstPart);
+        if (firstPart < numSamples)
+            out.copyFrom(channel, bufferToFill.startSample + firstPart, ring, source, 0,
+                         numSamples - firstPart);
+        if (numSamples < bufferToFill.numSamples)
+            out.clear(channel, bufferToFill.startSample + numSamples,
+                      bufferToFill.numSamples - numSamples);
+    }
+
+    consumed.store(done + numSamples, std::memory_order_release);
+    position.fetch_add(numSamples, std::memory_order_relaxed);
+}
+
+int ReadAheadBuffer::useTimeSlice() {
+    const juce::uint32 generation = consumerGeneration.load(std::memory_order_acquire);
+    if (generation != producerGeneration.load(std::memory_order_relaxed)) {
+        // The audio thread reads nothing of the ring until this generation is published.
+        readStart = position.load(std::memory_order_relaxed);
+        written.store(0, std::memory_order_relaxed);
+        input.setNextReadPosition(readStart);
+        producerGeneration.store(generation, std::memory_order_release);
+    }
+
+    // A seek only the audio thread can take is about to need a refill; check back soon.
+    const bool seekPending = requestedGeneration.load(std::memory_order_acquire) != generation;
+
+    const int size = ring.getNumSamples();
+    const juce::int64 filled = written.load(std::memory_order_relaxed);
+    const juce::int64 space = size - (filled - consumed.load(std::memory_order_acquire));
+    const juce::int64 remaining = input.getTotalLength() - (readStart + filled);
+    const int numSamples = (int)juce::jmin(space, remaining,
+                                           (juce::int64)Config::Audio::readAheadChunkSize);
+    if (numSamples <= 0)
+        return seekPending ? 1 : Config::Audio::readAheadIdleMs;
+
+    const int start = (int)(filled % size);
+    const int firstPart = juce::jmin(numSamples, size - start);
+    input.getNextAudioBlock(juce::AudioSourceChannelInfo(&ring, start, firstPart));
+    if (firstPart < numSamples)
+        input.getNextAudioBlock(juce::AudioSourceChannelInfo(&ring, 0, numSamples - firstPart));
+
+    written.store(filled + numSamples, std::memory_order_release);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#ifndef AUDIOFILER_READAHEADBUFFER_H
+#define AUDIOFILER_READAHEADBUFFER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+
+/**
+ * @file ReadAheadBuffer.h
+ * @ingroup AudioEngine
+ * @brief Reads a source ahead on a background thread into a ring the audio thread drains.
+ * @details A single-producer, single-consumer ring: the read-ahead thread appends what it reads
+ *          from the source and the audio thread copies it out, each side publishing how far
+ *          it got through an atomic counter. Neither side ever takes a lock, so
+ *          getNextAudioBlock() is wait-free; `juce::BufferingAudioSource` instead shares a
+ *          critical section with its reading thread.
+ *
+ *          A seek is only a request until the audio thread takes it with takeSeek(), which
+ *          empties the ring on its side and starts a new generation. The read-ahead thread
+ *          refills from the new position once it sees that generation, and the audio thread
+ *          reads nothing of the ring until then. Neither side ever touches samples the other
+ *          may be using, and a block that finds the ring empty plays silence and does not move.
+ *
+ * @see AudioPlayer
+ */
+class ReadAheadBuffer : public juce::AudioSource, private juce::TimeSliceClient {
+  public:
+    /**
+     * @brief Starts reading `input` from `startPosition` on `thread`.
+     * @param input Read on `thread` only, from now until this buffer is destroyed.
+     * @param numChannels Channels kept in the ring; the input fills every one of them.
+     * @param bufferSize Samples kept in the ring.
+     */
+    ReadAheadBuffer(juce::PositionableAudioSource &input, juce::TimeSliceThread &thread,
+                    int numChannels, int bufferSize, juce::int64 startPosition);
+
+    /** @brief Waits for a time slice in progress. Not on the audio thread. */
+    ~ReadAheadBuffer() override;
+
+    /** @brief Asks for playback to continue from `position`. Not on the audio thread. */
+    void seek(juce::int64 position);
+
+    /** @brief Takes a pending seek, if any, and returns true if it did. Audio thread only. */
+    bool takeSeek() noexcept;
+
+    /** @brief Position of the next sample the audio thread reads, or of a pending seek. */
+    juce::int64 getPosition() const noexcept;
+
+    /** @brief True once the audio thread has read up to the end of the input. */
+    bool isFinished() const noexcept;
+
+    /** @brief Samples the audio thread can read without running dry. Audio thread only. */
+    int getNumReady() const noexcept;
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+
+    /** @brief Copies out the next samples and silences any the ring does not hold yet. */
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) override;
+
+  private:
+    int useTimeSlice() override;
+
+    juce::PositionableAudioSource &input;
+    juce::TimeSliceThread &thread;
+    juce::AudioBuffer<float> ring;
+
+    // Written by seek() only.
+    std::atomic<juce::int64> seekTarget;
+    std::atomic<juce::uint32> requestedGeneration{0};
+
+    // Written by the audio thread only; `position` is where the generation started plus
+    // `consumed`.
+    std::atomic<juce::uint32> consumerGeneration{0};
+    std::atomic<juce::int64> position;
+    std::atomic<juce::int64> consumed{0};
+
+    // Written by the read-ahead thread only.
+    std::atomic<juce::uint32> producerGeneration{0};
+    std::atomic<juce::int64> written{0};
+    juce::int64 readStart;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReadAheadBuffer)
+};
+
+#endif
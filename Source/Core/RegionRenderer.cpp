@@ -0,0 +1,294 @@
+#include "Core/RegionRenderer.h"
+#include "Core/AudioReaderFactory.h"
+#include "Core/GainRamp.h"
+
+#include <cstring>
+#include <limits>
+
+namespace {
+constexpr int kRiffHeaderBytes = 12;
+constexpr int kChunkHeaderBytes = 8;
+constexpr int kMinFormatChunkBytes = 16;
+constexpr int kMaxFormatChunkBytes = 64;
+constexpr int kExtensibleSubFormatOffset = 24;
+constexpr int kBlockAlignOffset = 12;
+constexpr int kFormatPcm = 0x0001;
+constexpr int kFormatIeeeFloat = 0x0003;
+constexpr int kFormatExtensible = 0xFFFE;
+constexpr int kWriterThreadStopTimeoutMs = 4000;
+
+/** Where the frames of an uncompressed WAV file live. */
+struct WavLayout {
+    juce::MemoryBlock formatChunk;
+    juce::int64 dataStart{0};
+    juce::int64 numFrames{0};
+    int bytesPerFrame{0};
+};
+
+int readShort(const void *bytes) {
+    return (int)juce::ByteOrder::littleEndianShort(bytes);
+}
+
+bool isUncompressed(const juce::MemoryBlock &formatChunk) {
+    const auto *fmt = static_cast<const char *>(formatChunk.getData());
+    int tag = readShort(fmt);
+    if (tag == kFormatExtensible && formatChunk.getSize() >= kExtensibleSubFormatOffset + 2)
+        tag = readShort(fmt + kExtensibleSubFormatOffset);
+    return tag == kFormatPcm || tag == kFormatIeeeFloat;
+}
+
+/** Walks the RIFF chunks up to `data`; false for RF64, compressed or malformed files. */
+bool readWavLayout(const juce::File &file, WavLayout &layout) {
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+        return false;
+
+    char riff[kRiffHeaderBytes];
+    if (in.read(riff, kRiffHeaderBytes) != kRiffHeaderBytes || std::memcmp(riff, "RIFF", 4) != 0 ||
+        std::memcmp(riff + 8, "WAVE", 4) != 0)
+        return false;
+
+    char chunk[kChunkHeaderBytes];
+    while (in.read(chunk, kChunkHeaderBytes) == kChunkHeaderBytes) {
+        const juce::int64 size = (juce::int64)juce::ByteOrder::littleEndianInt(chunk + 4);
+        const juce::int64 next = in.getPosition() + size + (size & 1);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (size < kMinFormatChunkBytes || size > kMaxFormatChunkBytes)
+                return false;
+            layout.formatChunk.setSize((size_t)size);
+            if (in.read(layout.formatChunk.getData(), (int)size) != (int)size)
+                return false;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (layout.formatChunk.getSize() == 0 || !isUncompressed(layout.formatChunk))
+                return false;
+
+            layout.bytesPerFrame = readShort(
+                static_cast<const char *>(layout.formatChunk.getData()) + kBlockAlignOffset);
+            if (layout.bytesPerFrame <= 0)
+                return false;
+
+            // Streamed recorders may leave the size unset; trust the file length instead.
+            layout.dataStart = in.getPosition();
+            const juce::int64 dataBytes = juce::jmin(size, in.getTotalLength() - layout.dataStart);
+            layout.numFrames = dataBytes / layout.bytesPerFrame;
+            return true;
+        }
+
+        if (!in.setPosition(next))
+            return false;
+    }
+    return false;
+}
+
+bool isWav(const juce::File &file) {
+    return file.hasFileExtension("wav");
+}
+
+/** Applies whichever parts of the region's fades fall inside one chunk. */
+void applyFades(juce::AudioBuffer<float> &chunk, juce::int64 offset, int numSamples,
+                juce::int64 regionLength, const GainRamp &fadeIn, const GainRamp &fadeOut) {
+    if (offset < fadeIn.getLength()) {
+        const int count = (int)juce::jmin((juce::int64)numSamples, fadeIn.getLength() - offset);
+        fadeIn.applyFadeIn(chunk, 0, count, (int)offset);
+    }
+
+    const juce::int64 fadeOutStart = regionLength - fadeOut.getLength();
+    const juce::int64 from = juce::jmax(offset, fadeOutStart);
+    const juce::int64 to = offset + numSamples;
+    if (fadeOut.getLength() > 0 && from < to)
+        fadeOut.applyFadeOut(chunk, (int)(from - offset), (int)(to - from),
+                             (int)(from - fadeOutStart));
+}
+
+bool aborted(const std::function<bool()> &shouldAbort) {
+    return shouldAbort != nullptr && shouldAbort();
+}
+} // namespace
+
+RegionRenderer::RegionRenderer(juce::AudioFormatManager &manager, int numWriterThreads)
+    : formatManager(manager) {
+    for (int i = 0; i < juce::jmax(1, numWriterThreads); ++i) {
+        auto *thread = writerThreads.add(new juce::TimeSliceThread("RegionWriter"));
+        thread->startThread();
+    }
+}
+
+RegionRenderer::~RegionRenderer() {
+    for (auto *thread : writerThreads)
+        thread->stopThread(kWriterThreadStopTimeoutMs);
+}
+
+bool RegionRenderer::canCopyBytes(const Request &request) {
+    WavLayout layout;
+    return isWav(request.source) && isWav(request.destination) && request.fadeInSamples <= 0 &&
+           request.fadeOutSamples <= 0 && readWavLayout(request.source, layout);
+}
+
+juce::Result RegionRenderer::render(const Request &request,
+                                    const std::function<bool()> &shouldAbort) const {
+    if (request.destination == request.source)
+        return juce::Result::fail("Cannot render a file onto itself");
+
+    return canCopyBytes(request) ? copyBytes(request, shouldAbort)
+                                 : encode(request, shouldAbort);
+}
+
+juce::Result RegionRenderer::copyBytes(const Request &request,
+                                       const std::function<bool()> &shouldAbort) const {
+    WavLayout layout;
+    if (!readWavLayout(request.source, layout))
+        return juce::Result::fail("Cannot read " + request.source.getFullPathName());
+
+    const juce::int64 start = juce::jlimit((juce::int64)0, layout.numFrames, request.startSample);
+    const juce::int64 end = juce::jlimit(start, layout.numFrames, request.endSample);
+    const juce::int64 dataBytes = (end - start) * layout.bytesPerFrame;
+    if (dataBytes <= 0)
+        return juce::Result::fail("Nothing to render in the selected region");
+
+    const auto formatBytes = (juce::int64)layout.formatChunk.getSize();
+    const juce::int64 riffBytes = 4 + kChunkHeaderBytes + formatBytes + (formatBytes & 1) +
+                                  kChunkHeaderBytes + dataBytes + (dataBytes & 1);
+    if (riffBytes > (juce::int64)0xffffffff)
+        return encode(request, shouldAbort); // Needs RF64, which the WAV writer handles.
+
+    juce::FileInputStream in(request.source);
+    if (!in.openedOk() || !in.setPosition(layout.dataStart + start * layout.bytesPerFrame))
+        return juce::Result::fail("Cannot read " + request.source.getFullPathName());
+
+    juce::TemporaryFile temp(request.destination);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return juce::Result::fail("Cannot write " + request.destination.getFullPathName());
+
+        out.write("RIFF", 4);
+        out.writeInt((int)(juce::uint32)riffBytes);
+        out.write("WAVE", 4);
+        out.write("fmt ", 4);
+        out.writeInt((int)formatBytes);
+        out.write(layout.formatChunk.getData(), (size_t)formatBytes);
+        if (formatBytes & 1)
+            out.writeByte(0);
+        out.write("data", 4);
+        out.writeInt((int)(juce::uint32)dataBytes);
+
+        juce::MemoryBlock chunk((size_t)Config::Audio::renderCopyChunkBytes);
+        for (juce::int64 remaining = dataBytes; remaining > 0;) {
+            if (aborted(shouldAbort))
+                return juce::Result::fail("Render cancelled");
+
+            const int wanted =
+                (int)juce::jmin(remaining, (juce::int64)Config::Audio::renderCopyChunkBytes);
+            const int got = in.read(chunk.getData(), wanted);
+            if (got <= 0 || !out.write(chunk.getData(), (size_t)got))
+                return juce::Result::fail("Failed to write " +
+                                          request.destination.getFullPathName());
+            remaining -= got;
+        }
+        if (dataBytes & 1)
+            out.writeByte(0);
+
+        out.flush();
+        if (out.getStatus().failed())
+            return juce::Result::fail("Failed to write " + request.destination.getFullPathName());
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+        return juce::Result::fail("Cannot replace " + request.destination.getFullPathName());
+    return juce::Result::ok();
+}
+
+juce::Result RegionRenderer::encode(const Request &request,
+                                    const std::function<bool()> &shouldAbort) const {
+    auto reader = AudioReaderFactory::createReader(formatManager, request.source);
+    if (reader == nullptr)
+        return juce::Result::fail("Cannot read " + request.source.getFullPathName());
+
+    const juce::int64 length = reader->lengthInSamples;
+    const juce::int64 start = juce::jlimit((juce::int64)0, length, request.startSample);
+    const juce::int64 end = juce::jlimit(start, length, request.endSample);
+    const juce::int64 regionLength = end - start;
+    if (regionLength <= 0)
+        return juce::Result::fail("Nothing to render in the selected region");
+
+    auto *format = formatManager.findFormatForFileExtension(
+        request.destination.getFileExtension());
+    if (format == nullptr)
+        return juce::Result::fail("Unsupported output format: " +
+                                  request.destination.getFileExtension());
+
+    const juce::Array<int> bitDepths = format->getPossibleBitDepths();
+    const juce::Array<int> sampleRates = format->getPossibleSampleRates();
+    if (bitDepths.isEmpty() ||
+        (!sampleRates.isEmpty() && !sampleRates.contains((int)reader->sampleRate)))
+        return juce::Result::fail(format->getFormatName() + " cannot store " +
+                                  juce::String(reader->sampleRate) + " Hz audio");
+
+    const int bitsPerSample = bitDepths.contains((int)reader->bitsPerSample)
+                                  ? (int)reader->bitsPerSample
+                                  : bitDepths.getLast();
+    const int numChannels = (int)reader->numChannels;
+
+    juce::TemporaryFile temp(request.destination);
+    auto fileStream = std::make_unique<juce::FileOutputStream>(temp.getFile());
+    if (!fileStream->openedOk())
+        return juce::Result::fail("Cannot write " + request.destination.getFullPathName());
+
+    std::unique_ptr<juce::OutputStream> stream = std::move(fileStream);
+    auto writer = format->createWriterFor(
+        stream, juce::AudioFormatWriterOptions()
+                    .withSampleRate(reader->sampleRate)
+                    .withNumChannels(numChannels)
+                    .withBitsPerSample(bitsPerSample)
+                    .withQualityOptionIndex(
+                        juce::jmax(0, format->getQualityOptions().size() - 1)));
+    if (writer == nullptr)
+        return juce::Result::fail(format->getFormatName() + " cannot store this audio");
+
+    // Each fade gets at most half the region so the two never overlap.
+    const auto maxFade =
+        (int)juce::jmin(regionLength / 2, (juce::int64)std::numeric_limits<int>::max());
+    const GainRamp fadeIn(juce::jmin(request.fadeInSamples, maxFade), request.fadeCurve);
+    const GainRamp fadeOut(juce::jmin(request.fadeOutSamples, maxFade), request.fadeCurve);
+
+    bool cancelled = false;
+    bool readFailed = false;
+    {
+        // Encoding and disk writes happen on the writer thread; the destructor drains the queue.
+        juce::AudioFormatWriter::ThreadedWriter threaded(
+            writer.release(), nextWriterThread(), Config::Audio::renderWriterFifoSamples);
+        juce::AudioBuffer<float> chunk(numChannels, Config::Audio::renderChunkSamples);
+
+        for (juce::int64 offset = 0; offset < regionLength && !cancelled && !readFailed;) {
+            const int numSamples = (int)juce::jmin(regionLength - offset,
+                                                   (juce::int64)Config::Audio::renderChunkSamples);
+            readFailed = !reader->read(&chunk, 0, numSamples, start + offset, true, true);
+            applyFades(chunk, offset, numSamples, regionLength, fadeIn, fadeOut);
+
+            // A full queue means the encoder is behind; wait for it rather than grow memory.
+            while (!readFailed && !threaded.write(chunk.getArrayOfReadPointers(), numSamples)) {
+                cancelled = aborted(shouldAbort);
+                if (cancelled)
+                    break;
+                juce::Thread::sleep(1);
+            }
+
+            cancelled = cancelled || aborted(shouldAbort);
+            offset += numSamples;
+        }
+    }
+
+    if (cancelled)
+        return juce::Result::fail("Render cancelled");
+    if (readFailed)
+        return juce::Result::fail("Failed to read " + request.source.getFullPathName());
+    if (!temp.overwriteTargetFileWithTemporary())
+        return juce::Result::fail("Cannot replace " + request.destination.getFullPathName());
+    return juce::Result::ok();
+}
+
+juce::TimeSliceThread &RegionRenderer::nextWriterThread() const {
+    const unsigned int index = nextWriter.fetch_add(1) % (unsigned int)writerThreads.size();
+    return *writerThreads[(int)index];
+}
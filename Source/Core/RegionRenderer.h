@@ -0,0 +1,85 @@
+#ifndef AUDIOFILER_REGIONRENDERER_H
+#define AUDIOFILER_REGIONRENDERER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Utils/Config.h"
+#include <atomic>
+#include <functional>
+
+/**
+ * @file RegionRenderer.h
+ * @ingroup AudioEngine
+ * @brief Writes a region of an audio file to a new WAV, FLAC or Ogg Vorbis file.
+ * @details Two paths, chosen per request:
+ *
+ *          - **Byte copy.** A WAV-to-WAV render without fades never decodes: the source's
+ *            `fmt ` chunk is copied verbatim and the region's PCM frames are streamed
+ *            straight from the source's `data` chunk, so a trim runs at disk speed.
+ *          - **Encode.** Everything else is read in chunks from a private reader, shaped by
+ *            optional GainRamp fades at both ends and queued to an
+ *            `AudioFormatWriter::ThreadedWriter`. Decoding stays on the calling thread while
+ *            encoding and disk writes run on one of the renderer's writer threads.
+ *
+ *          The output format follows the destination's extension. Output goes to a temporary
+ *          file that replaces the destination only once complete, so a failed or cancelled
+ *          render never leaves a partial file behind. `render()` may be called from several
+ *          threads at once.
+ *
+ * @see GainRamp
+ * @see AudioReaderFactory
+ * @see BatchProcessor
+ */
+class RegionRenderer {
+  public:
+    struct Request {
+        juce::File source;
+        /** Format is chosen by extension: `.wav`, `.flac` or `.ogg`. */
+        juce::File destination;
+        /** Region in source samples; `endSample` is exclusive and clamped to the file. */
+        juce::int64 startSample{0};
+        juce::int64 endSample{0};
+        /** Fade lengths in samples; 0 cuts hard. Any fade forces the encode path. */
+        int fadeInSamples{0};
+        int fadeOutSamples{0};
+        Config::Audio::FadeCurve fadeCurve{Config::Audio::boundaryFadeCurve};
+    };
+
+    /**
+     * @param formatManager Formats to read sources with and to pick output formats from.
+     * @param numWriterThreads Threads encoding queued audio; one suits a single render,
+     *        concurrent renders (e.g. a batch) may want one per decoding thread.
+     */
+    explicit RegionRenderer(juce::AudioFormatManager &formatManager, int numWriterThreads = 1);
+    ~RegionRenderer();
+
+    /**
+     * @brief Renders `request.destination`, replacing any existing file. Blocks.
+     * @param shouldAbort Polled between chunks; returning true cancels the render.
+     */
+    juce::Result render(const Request &request,
+                        const std::function<bool()> &shouldAbort = {}) const;
+
+    /** @brief True if `request` takes the byte-copy path rather than decoding. */
+    static bool canCopyBytes(const Request &request);
+
+  private:
+    juce::Result copyBytes(const Request &request,
+                           const std::function<bool()> &shouldAbort) const;
+    juce::Result encode(const Request &request, const std::function<bool()> &shouldAbort) const;
+    juce::TimeSliceThread &nextWriterThread() const;
+
+    juce::AudioFormatManager &formatManager;
+    juce::OwnedArray<juce::TimeSliceThread> writerThreads;
+    mutable std::atomic<unsigned int> nextWriter{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RegionRenderer)
+};
+
+#endif
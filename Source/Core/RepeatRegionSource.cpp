@@ -0,0 +1,223 @@
+#include "Core/RepeatRegionSource.h"
+
+namespace {
+/** Reported length while repeating; large enough never to be reached, small enough to scale. */
+constexpr juce::int64 kUnboundedLength = (juce::int64)1 << 52;
+} // namespace
+
+RepeatRegionSource::RepeatRegionSource(juce::AudioFormatReader *reader,
+                                       bool deleteReaderWhenThisIsDeleted, int fadeSamples,
+                                       Config::Audio::FadeCurve fadeCurve)
+    : juce::AudioFormatReaderSource(reader, deleteReaderWhenThisIsDeleted),
+      fileLength(reader->lengthInSamples), ramp(fadeSamples, fadeCurve) {
+    // The player's read-ahead buffer is at least stereo; reads fill every channel it has.
+    crossfadeBuffer.setSize(juce::jmax(2, (int)reader->numChannels),
+                            juce::jmax(1, ramp.getLength()));
+    totalLength.store(lengthOf(Epoch{}));
+}
+
+void RepeatRegionSource::setRegion(const Region &region, juce::int64 fromPosition) {
+    const Epoch current = epoch.read();
+    const Region &old = current.region;
+    if (old.bounded == region.bounded && old.repeating == region.repeating &&
+        old.cutIn == region.cutIn && old.cutOut == region.cutOut)
+        return;
+
+    // Continue from what is audible at fromPosition; mid-crossfade that is the cut-in side.
+    const Span span = locate(current, fromPosition, fileLength);
+
+    Epoch next;
+    next.start = fromPosition;
+    next.fileStart = span.kind == Span::Kind::Crossfade ? span.incomingPosition
+                                                        : span.filePosition;
+    next.region = region;
+    next.fade = region.cutOut - region.cutIn > 2 * (juce::int64)ramp.getLength()
+                    ? ramp.getLength()
+                    : 0;
+    publish(next);
+}
+
+void RepeatRegionSource::restartAt(juce::int64 filePosition) {
+    Epoch next = epoch.read();
+    next.start = filePosition;
+    next.fileStart = filePosition;
+    publish(next);
+}
+
+juce::int64 RepeatRegionSource::toFilePosition(juce::int64 timelinePosition) const {
+    return locate(epoch.read(), timelinePosition, fileLength).filePosition;
+}
+
+void RepeatRegionSource::publish(const Epoch &next) {
+    epoch.publish(next);
+    totalLength.store(lengthOf(next));
+}
+
+bool RepeatRegionSource::isCycling(const Epoch &e) {
+    return e.region.bounded && e.region.repeating && e.region.cutOut > e.region.cutIn;
+}
+
+RepeatRegionSource::Span RepeatRegionSource::locate(const Epoch &e, juce::int64 timelinePosition,
+                                                    juce::int64 length) {
+    Span span;
+    const Region &region = e.region;
+
+    if (!isCycling(e)) {
+        const juce::int64 end = region.bounded ? juce::jmin(region.cutOut, length) : length;
+        const juce::int64 filePosition = e.fileStart + (timelinePosition - e.start);
+        span.filePosition = juce::jlimit((juce::int64)0, end, filePosition);
+        if (filePosition < 0 || filePosition >= end) {
+            span.length = kUnboundedLength;
+            return span;
+        }
+
+        span.kind = Span::Kind::Plain;
+        span.length = end - filePosition;
+        if (region.bounded)
+            splitAtFades(span, e.fileStart == region.cutIn ? region.cutIn : -1, end, e.fade);
+        return span;
+    }
+
+    // The first pass runs up to the crossfade before cutOut; every later pass starts at cutIn
+    // and lasts `period` samples, beginning with the crossfade.
+    const juce::int64 fadeStart = region.cutOut - e.fade;
+    const juce::int64 period = region.cutOut - region.cutIn - e.fade;
+    const juce::int64 fileStart = e.fileStart >= fadeStart ? region.cutIn : e.fileStart;
+    const juce::int64 filePosition =
+        juce::jmax((juce::int64)0, fileStart + (timelinePosition - e.start));
+
+    if (filePosition < fadeStart) {
+        span.kind = Span::Kind::Plain;
+        span.filePosition = filePosition;
+        span.length = fadeStart - filePosition;
+        splitAtFades(span, fileStart == region.cutIn ? region.cutIn : -1, -1, e.fade);
+        return span;
+    }
+
+    const juce::int64 offset = (filePosition - fadeStart) % period;
+    if (offset < e.fade) {
+        span.kind = Span::Kind::Crossfade;
+        span.filePosition = fadeStart + offset;
+        span.incomingPosition = region.cutIn + offset;
+        span.rampOffset = (int)offset;
+        span.length = e.fade - offset;
+    } else {
+        span.kind = Span::Kind::Plain;
+        span.filePosition = region.cutIn + offset;
+        span.length = period - offset;
+    }
+    return span;
+}
+
+void RepeatRegionSource::splitAtFades(Span &span, juce::int64 fadeInStart,
+                                      juce::int64 fadeOutEnd, int fade) {
+    if (fade <= 0)
+        return;
+
+    const juce::int64 filePosition = span.filePosition;
+    if (fadeInStart >= 0 && filePosition >= fadeInStart && filePosition < fadeInStart + fade) {
+        span.kind = Span::Kind::FadeIn;
+        span.rampOffset = (int)(filePosition - fadeInStart);
+        span.length = juce::jmin(span.length, fadeInStart + fade - filePosition);
+        return;
+    }
+
+    if (fadeOutEnd < 0)
+        return;
+
+    const juce::int64 fadeOutStart = fadeOutEnd - fade;
+    if (filePosition >= fadeOutStart) {
+        span.kind = Span::Kind::FadeOut;
+        span.rampOffset = (int)(filePosition - fadeOutStart);
+        span.length = juce::jmin(span.length, fadeOutEnd - filePosition);
+    } else {
+        span.length = juce::jmin(span.length, fadeOutStart - filePosition);
+    }
+}
+
+juce::int64 RepeatRegionSource::lengthOf(const Epoch &e) const {
+    if (isCycling(e))
+        return kUnboundedLength;
+
+    const juce::int64 end =
+        e.region.bounded ? juce::jmin(e.region.cutOut, fileLength) : fileLength;
+    return e.start + juce::jmax((juce::int64)0, end - e.fileStart);
+}
+
+void RepeatRegionSource::getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) {
+    // A failed read means the region is being replaced; keep the previous one for this block.
+    epoch.tryRead(readerEpoch);
+
+    juce::int64 timelinePosition = position.load(std::memory_order_relaxed);
+    int done = 0;
+
+    while (done < bufferToFill.numSamples) {
+        const Span span = locate(readerEpoch, timelinePosition, fileLength);
+        const int numSamples =
+            (int)juce::jmin((juce::int64)(bufferToFill.numSamples - done), span.length);
+        const juce::AudioSourceChannelInfo part(bufferToFill.buffer,
+                                                bufferToFill.startSample + done, numSamples);
+
+        switch (span.kind) {
+        case Span::Kind::Silence:
+            part.clearActiveBufferRegion();
+            break;
+        case Span::Kind::Plain:
+            readInput(*part.buffer, part.startSample, span.filePosition, numSamples);
+            break;
+        case Span::Kind::FadeIn:
+            readInput(*part.buffer, part.startSample, span.filePosition, numSamples);
+            ramp.applyFadeIn(*part.buffer, part.startSample, numSamples, span.rampOffset);
+            break;
+        case Span::Kind::FadeOut:
+            readInput(*part.buffer, part.startSample, span.filePosition, numSamples);
+            ramp.applyFadeOut(*part.buffer, part.startSample, numSamples, span.rampOffset);
+            break;
+        case Span::Kind::Crossfade:
+            renderCrossfade(part, span);
+            break;
+        }
+
+        done += numSamples;
+        timelinePosition += numSamples;
+    }
+
+    position.store(timelinePosition, std::memory_order_relaxed);
+}
+
+void RepeatRegionSource::readInput(juce::AudioBuffer<float> &buffer, int startSample,
+                                   juce::int64 filePosition, int numSamples) {
+    // The base class keeps the file cursor; this class only keeps the timeline position.
+    juce::AudioFormatReaderSource::setNextReadPosition(filePosition);
+    juce::AudioFormatReaderSource::getNextAudioBlock(
+        juce::AudioSourceChannelInfo(&buffer, startSample, numSamples));
+}
+
+void RepeatRegionSource::renderCrossfade(const juce::AudioSourceChannelInfo &info,
+                                         const Span &span) {
+    juce::AudioBuffer<float> &buffer = *info.buffer;
+
+    // Channels beyond the preallocated buffer cannot be mixed; splice them directly.
+    if (buffer.getNumChannels() > crossfadeBuffer.getNumChannels()) {
+        readInput(buffer, info.startSample, span.incomingPosition, info.numSamples);
+        return;
+    }
+
+    readInput(buffer, info.startSample, span.filePosition, info.numSamples);
+    ramp.applyFadeOut(buffer, info.startSample, info.numSamples, span.rampOffset);
+
+    readInput(crossfadeBuffer, 0, span.incomingPosition, info.numSamples);
+    ramp.addFadedIn(buffer, info.startSample, crossfadeBuffer, info.numSamples, span.rampOffset);
+}
+
+void RepeatRegionSource::setNextReadPosition(juce::int64 newPosition) {
+    position.store(newPosition, std::memory_order_relaxed);
+}
+
+juce::int64 RepeatRegionSource::getNextReadPosition() const {
+    return position.load(std::memory_order_relaxed);
+}
+
+juce::int64 RepeatRegionSource::getTotalLength() const {
+    return totalLength.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,119 @@
+#ifndef AUDIOFILER_REPEATREGIONSOURCE_H
+#define AUDIOFILER_REPEATREGIONSOURCE_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/GainRamp.h"
+#include "Utils/LockFreeSnapshot.h"
+#include <atomic>
+
+/**
+ * @file RepeatRegionSource.h
+ * @ingroup AudioEngine
+ * @brief A reader source that confines playback to the cut region and repeats it seamlessly.
+ * @details Feeds the player's read-ahead buffer with a continuous timeline: while
+ *          repeating, the sample after `cutOut - 1` is `cutIn`, so the buffer reads straight
+ *          across every jump and the cut-in region is already buffered when playback reaches
+ *          it. The read-ahead buffer is never flushed by a repeat; only real seeks
+ *          (`restartAt`) start the timeline again.
+ *
+ *          Edges are shaped by a GainRamp: playback entered at `cutIn` fades in, playback that
+ *          ends at `cutOut` fades out, and every repeat crossfades the tail before `cutOut`
+ *          into the start of the region. Without repetition the timeline simply ends at
+ *          `cutOut`, so playback stops on that exact sample.
+ *
+ *          The region is published by the message thread through a LockFreeSnapshot; the
+ *          reading thread (read-ahead or audio) never blocks on it.
+ *
+ * @see AudioPlayer
+ * @see GainRamp
+ * @see LockFreeSnapshot
+ */
+class RepeatRegionSource : public juce::AudioFormatReaderSource {
+  public:
+    /** @brief Cut region in source-file samples. */
+    struct Region {
+        bool bounded{false};   ///< Playback is confined to [cutIn, cutOut).
+        bool repeating{false}; ///< At cutOut, continue from cutIn instead of ending.
+        juce::int64 cutIn{0};
+        juce::int64 cutOut{0};
+    };
+
+    /**
+     * @param reader The file to play; owned if `deleteReaderWhenThisIsDeleted`.
+     * @param fadeSamples Length of boundary fades and repeat crossfades; 0 cuts hard.
+     * @param fadeCurve Shape of those fades.
+     */
+    RepeatRegionSource(juce::AudioFormatReader *reader, bool deleteReaderWhenThisIsDeleted,
+                       int fadeSamples, Config::Audio::FadeCurve fadeCurve);
+
+    /**
+     * @brief Applies a new region from timeline position `fromPosition` onwards.
+     * @details Pass the current playback position so what is audible stays continuous. Message
+     *          thread only.
+     */
+    void setRegion(const Region &region, juce::int64 fromPosition);
+
+    /**
+     * @brief Starts the timeline again at `filePosition`, which becomes its own position.
+     * @details Call before seeking the read-ahead buffer to the same position. Message thread only.
+     */
+    void restartAt(juce::int64 filePosition);
+
+    /** @brief Maps a timeline position, e.g. the player's, back to a position in the file. */
+    juce::int64 toFilePosition(juce::int64 position) const;
+
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) override;
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+
+  private:
+    /** A region and the timeline position from which it applies. */
+    struct Epoch {
+        juce::int64 start{0};     ///< Timeline position where this epoch begins.
+        juce::int64 fileStart{0}; ///< File position played at `start`.
+        Region region;
+        int fade{0}; ///< 0 when the region is too short to fade both ends.
+    };
+
+    /** A stretch of the timeline that maps to the file in one piece. */
+    struct Span {
+        enum class Kind { Plain, FadeIn, FadeOut, Crossfade, Silence };
+
+        Kind kind{Kind::Silence};
+        juce::int64 filePosition{0};     ///< Read position; the outgoing side of a crossfade.
+        juce::int64 incomingPosition{0}; ///< The cut-in side of a crossfade.
+        int rampOffset{0};               ///< Samples of the fade already played.
+        juce::int64 length{0};
+    };
+
+    static bool isCycling(const Epoch &epoch);
+    static Span locate(const Epoch &epoch, juce::int64 position, juce::int64 fileLength);
+    static void splitAtFades(Span &span, juce::int64 fadeInStart, juce::int64 fadeOutEnd,
+                             int fade);
+    juce::int64 lengthOf(const Epoch &epoch) const;
+    void publish(const Epoch &epoch);
+    void readInput(juce::AudioBuffer<float> &buffer, int startSample, juce::int64 filePosition,
+                   int numSamples);
+    void renderCrossfade(const juce::AudioSourceChannelInfo &info, const Span &span);
+
+    const juce::int64 fileLength;
+    const GainRamp ramp;
+
+    LockFreeSnapshot<Epoch> epoch;
+    Epoch readerEpoch; ///< Only touched by the reading thread.
+    std::atomic<juce::int64> position{0};
+    std::atomic<juce::int64> totalLength{0};
+    juce::AudioBuffer<float> crossfadeBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RepeatRegionSource)
+};
+
+#endif
@@ -2,7 +2,14 @@
 
 #include "Core/SessionState.h"
 
-SessionState::SessionState() {
+#include <utility>
+
+SessionState::SessionState() : SessionState(std::make_unique<MetadataStore>()) {
+}
+
+SessionState::SessionState(std::unique_ptr<MetadataStore> metadataStore)
+    : files(std::make_shared<const Files>()), store(std::move(metadataStore)) {
+    jassert(store != nullptr);
     cutPrefs.cutIn = 0.0;
     cutPrefs.cutOut = 0.0;
 }
@@ -15,174 +22,259 @@ void SessionState::removeListener(Listener *listener) {
     listeners.remove(listener);
 }
 
+SessionState::Snapshot SessionState::getSnapshot() const {
+    return snapshot.read();
+}
+
 MainDomain::CutPreferences SessionState::getCutPrefs() const {
-    const juce::ScopedLock lock(stateLock);
-    return cutPrefs;
+    return getSnapshot().cutPrefs;
 }
 
-void SessionState::setCutActive(bool active) {
-    const juce::ScopedLock lock(stateLock);
-    if (cutPrefs.active != active) {
-        cutPrefs.active = active;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+std::shared_ptr<const SessionState::Files> SessionState::loadFiles() const {
+    return std::atomic_load(&files);
+}
+
+void SessionState::publishCutPrefs() {
+    snapshot.publish({cutPrefs, totalDuration, ++version});
+}
+
+void SessionState::cutPrefsChanged(Changes &changes) {
+    publishCutPrefs();
+    changes.cutPrefs = true;
+}
+
+void SessionState::updateFiles(const std::function<void(Files &)> &change) {
+    auto next = std::make_shared<Files>(*loadFiles());
+    change(*next);
+    std::atomic_store(&files, std::shared_ptr<const Files>(std::move(next)));
+}
+
+void SessionState::updateCutPrefs(
+    const std::function<bool(MainDomain::CutPreferences &)> &change) {
+    Changes changes;
+    {
+        const juce::ScopedLock lock(writeLock);
+        if (change(cutPrefs))
+            cutPrefsChanged(changes);
     }
+    notify(changes);
+}
+
+void SessionState::notify(const Changes &changes) {
+    if (changes.cutIn)
+        cutInPending = true;
+    if (changes.cutOut)
+        cutOutPending = true;
+    if (changes.cutPrefs)
+        deliverCutChanges();
+
+    for (const auto &event : changes.events)
+        listeners.call(event);
+}
+
+void SessionState::deliverCutChanges() {
+    if (pendingDeliveries.fetch_add(1) != 0)
+        return;
+
+    int handled = 0;
+    do {
+        // Every request counted here was published before it was counted.
+        handled = pendingDeliveries.load();
+        const MainDomain::CutPreferences prefs = getCutPrefs();
+        listeners.call([&prefs](Listener &l) { l.cutPreferenceChanged(prefs); });
+        if (cutInPending.exchange(false))
+            listeners.call([&prefs](Listener &l) { l.cutInChanged(prefs.cutIn); });
+        if (cutOutPending.exchange(false))
+            listeners.call([&prefs](Listener &l) { l.cutOutChanged(prefs.cutOut); });
+    } while (pendingDeliveries.fetch_sub(handled) != handled);
+}
+
+void SessionState::setCutActive(bool active) {
+    updateCutPrefs([active](MainDomain::CutPreferences &prefs) {
+        return std::exchange(prefs.active, active) != active;
+    });
 }
 
 void SessionState::setAutoPlayActive(bool active) {
-    const juce::ScopedLock lock(stateLock);
-    if (cutPrefs.autoplay != active) {
-        cutPrefs.autoplay = active;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
-    }
+    updateCutPrefs([active](MainDomain::CutPreferences &prefs) {
+        return std::exchange(prefs.autoplay, active) != active;
+    });
 }
 
 void SessionState::setAutoCutInActive(bool active) {
-    const juce::ScopedLock lock(stateLock);
-    if (cutPrefs.autoCut.inActive != active) {
-        cutPrefs.autoCut.inActive = active;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
-    }
+    updateCutPrefs([active](MainDomain::CutPreferences &prefs) {
+        return std::exchange(prefs.autoCut.inActive, active) != active;
+    });
 }
 
 void SessionState::setAutoCutOutActive(bool active) {
-    const juce::ScopedLock lock(stateLock);
-    if (cutPrefs.autoCut.outActive != active) {
-        cutPrefs.autoCut.outActive = active;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
-    }
+    updateCutPrefs([active](MainDomain::CutPreferences &prefs) {
+        return std::exchange(prefs.autoCut.outActive, active) != active;
+    });
 }
 
 void SessionState::setThresholdIn(float threshold) {
-    const juce::ScopedLock lock(stateLock);
-    if (cutPrefs.autoCut.thresholdIn != threshold) {
-        cutPrefs.autoCut.thresholdIn = threshold;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
-    }
+    updateCutPrefs([threshold](MainDomain::CutPreferences &prefs) {
+        return std::exchange(prefs.autoCut.thresholdIn, threshold) != threshold;
+    });
 }
 
 void SessionState::setThresholdOut(float threshold) {
-    const juce::ScopedLock lock(stateLock);
-    if (cutPrefs.autoCut.thresholdOut != threshold) {
-        cutPrefs.autoCut.thresholdOut = threshold;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
-    }
+    updateCutPrefs([threshold](MainDomain::CutPreferences &prefs) {
+        return std::exchange(prefs.autoCut.thresholdOut, threshold) != threshold;
+    });
 }
 
 void SessionState::setCutIn(double value) {
-    const juce::ScopedLock lock(stateLock);
+    Changes changes;
+    {
+        const juce::ScopedLock lock(writeLock);
 
-    // Clamp to [0, totalDuration]
-    double clampedValue = juce::jlimit(0.0, totalDuration, value);
+        // Clamp to [0, totalDuration]
+        double clampedValue = juce::jlimit(0.0, totalDuration, value);
 
-    // Boundary Rule: CutIn <= CutOut
-    clampedValue = juce::jmin(clampedValue, cutPrefs.cutOut);
+        // Boundary Rule: CutIn <= CutOut
+        clampedValue = juce::jmin(clampedValue, cutPrefs.cutOut);
+
+        if (cutPrefs.cutIn == clampedValue)
+            return;
 
-    if (cutPrefs.cutIn != clampedValue) {
         cutPrefs.cutIn = clampedValue;
-        if (!currentFilePath.isEmpty())
-            metadataCache[currentFilePath].cutIn = clampedValue;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
-        listeners.call([clampedValue](Listener &l) { l.cutInChanged(clampedValue); });
+        const FileId currentFileId = loadFiles()->currentFileId;
+        if (currentFileId != invalidFileId)
+            store->update(currentFileId, [clampedValue](MetadataStore::Record &record) {
+                record.cutIn = clampedValue;
+            });
+        cutPrefsChanged(changes);
+        changes.cutIn = true;
     }
+    notify(changes);
 }
 
 void SessionState::setCutOut(double value) {
-    const juce::ScopedLock lock(stateLock);
+    Changes changes;
+    {
+        const juce::ScopedLock lock(writeLock);
+
+        // Clamp to [0, totalDuration]
+        double clampedValue = juce::jlimit(0.0, totalDuration, value);
 
-    // Clamp to [0, totalDuration]
-    double clampedValue = juce::jlimit(0.0, totalDuration, value);
+        // Boundary Rule: CutOut >= CutIn
+        clampedValue = juce::jmax(clampedValue, cutPrefs.cutIn);
 
-    // Boundary Rule: CutOut >= CutIn
-    clampedValue = juce::jmax(clampedValue, cutPrefs.cutIn);
+        if (cutPrefs.cutOut == clampedValue)
+            return;
 
-    if (cutPrefs.cutOut != clampedValue) {
         cutPrefs.cutOut = clampedValue;
-        if (!currentFilePath.isEmpty())
-            metadataCache[currentFilePath].cutOut = clampedValue;
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
-        listeners.call([clampedValue](Listener &l) { l.cutOutChanged(clampedValue); });
+        const FileId currentFileId = loadFiles()->currentFileId;
+        if (currentFileId != invalidFileId)
+            store->update(currentFileId, [clampedValue](MetadataStore::Record &record) {
+                record.cutOut = clampedValue;
+            });
+        cutPrefsChanged(changes);
+        changes.cutOut = true;
     }
+    notify(changes);
 }
 
 double SessionState::getCutIn() const {
-    const juce::ScopedLock lock(stateLock);
-    return cutPrefs.cutIn;
+    return getSnapshot().cutPrefs.cutIn;
 }
 
 double SessionState::getCutOut() const {
-    const juce::ScopedLock lock(stateLock);
-    return cutPrefs.cutOut;
+    return getSnapshot().cutPrefs.cutOut;
 }
 
 void SessionState::setTotalDuration(double duration) {
-    const juce::ScopedLock lock(stateLock);
+    const juce::ScopedLock lock(writeLock);
     totalDuration = duration;
+    publishCutPrefs();
 }
 
 double SessionState::getTotalDuration() const {
-    const juce::ScopedLock lock(stateLock);
-    return totalDuration;
+    return getSnapshot().totalDuration;
+}
+
+FileId SessionState::getFileId(const juce::String &filePath) {
+    return store->intern(filePath);
 }
 
 FileMetadata SessionState::getMetadataForFile(const juce::String &filePath) const {
-    const juce::ScopedLock lock(stateLock);
-    const auto it = metadataCache.find(filePath);
-    if (it != metadataCache.end())
-        return it->second;
-    return FileMetadata{};
+    FileMetadata metadata;
+    store->get(filePath, metadata);
+    return metadata;
+}
+
+bool SessionState::getMetadata(FileId fileId, FileMetadata &metadataOut) const {
+    return store->get(fileId, metadataOut);
 }
 
 FileMetadata SessionState::getCurrentMetadata() const {
-    const juce::ScopedLock lock(stateLock);
-    return getMetadataForFile(currentFilePath);
+    FileMetadata metadata;
+    store->get(loadFiles()->currentFileId, metadata);
+    return metadata;
 }
 
 bool SessionState::hasMetadataForFile(const juce::String &filePath) const {
-    const juce::ScopedLock lock(stateLock);
-    return metadataCache.find(filePath) != metadataCache.end();
+    return store->contains(filePath);
 }
 
 void SessionState::setCurrentFilePath(const juce::String &filePath) {
-    const juce::ScopedLock lock(stateLock);
-    if (currentFilePath != filePath) {
-        currentFilePath = filePath;
-
-        // Sync cutPrefs from metadata cache for the new current file
-        const auto it = metadataCache.find(filePath);
-        if (it != metadataCache.end()) {
-            const auto &metadata = it->second;
+    Changes changes;
+    {
+        const juce::ScopedLock lock(writeLock);
+        if (loadFiles()->currentFilePath == filePath)
+            return;
+
+        const FileId fileId = filePath.isEmpty() ? invalidFileId : store->intern(filePath);
+        updateFiles([&filePath, fileId](Files &next) {
+            next.currentFilePath = filePath;
+            next.currentFileId = fileId;
+        });
+
+        // Sync cutPrefs from the stored metadata for the new current file
+        FileMetadata metadata;
+        if (store->get(fileId, metadata)) {
             const double inVal = juce::jlimit(0.0, totalDuration, metadata.cutIn);
             const double outVal = juce::jlimit(0.0, totalDuration, metadata.cutOut);
 
             cutPrefs.cutIn = juce::jmin(inVal, outVal);
             cutPrefs.cutOut = juce::jmax(inVal, outVal);
 
-            listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+            cutPrefsChanged(changes);
         }
 
-        listeners.call([filePath](Listener &l) { l.fileChanged(filePath); });
+        changes.events.push_back([filePath](Listener &l) { l.fileChanged(filePath); });
     }
+    notify(changes);
 }
 
 juce::String SessionState::getCurrentFilePath() const {
-    const juce::ScopedLock lock(stateLock);
-    return currentFilePath;
+    return loadFiles()->currentFilePath;
 }
 
 void SessionState::setMetadataForFile(const juce::String &filePath,
                                       const FileMetadata &newMetadata) {
-    const juce::ScopedLock lock(stateLock);
-    metadataCache[filePath] = newMetadata;
+    setMetadata(store->intern(filePath), newMetadata);
+}
 
-    if (filePath == currentFilePath) {
-        // Apply clamping when syncing to active cutPrefs
-        const double inVal = juce::jlimit(0.0, totalDuration, newMetadata.cutIn);
-        const double outVal = juce::jlimit(0.0, totalDuration, newMetadata.cutOut);
+void SessionState::setMetadata(FileId fileId, const FileMetadata &newMetadata) {
+    Changes changes;
+    {
+        const juce::ScopedLock lock(writeLock);
+        store->put(fileId, newMetadata);
 
-        // Ensure CutIn <= CutOut
-        cutPrefs.cutIn = juce::jmin(inVal, outVal);
-        cutPrefs.cutOut = juce::jmax(inVal, outVal);
+        if (fileId != invalidFileId && fileId == loadFiles()->currentFileId) {
+            // Apply clamping when syncing to active cutPrefs
+            const double inVal = juce::jlimit(0.0, totalDuration, newMetadata.cutIn);
+            const double outVal = juce::jlimit(0.0, totalDuration, newMetadata.cutOut);
 
-        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+            // Ensure CutIn <= CutOut
+            cutPrefs.cutIn = juce::jmin(inVal, outVal);
+            cutPrefs.cutOut = juce::jmax(inVal, outVal);
+
+            cutPrefsChanged(changes);
+        }
     }
+    notify(changes);
 }
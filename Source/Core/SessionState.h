@@ -1,9 +1,14 @@
 #pragma once
 
 #include "Core/FileMetadata.h"
+#include "Core/MetadataStore.h"
 #include "MainDomain.h"
+#include "Utils/LockFreeSnapshot.h"
 #include <juce_core/juce_core.h>
-#include <map>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
 
 /**
  * @file SessionState.h
@@ -15,9 +20,27 @@
  *
  *          It uses `juce::ListenerList` to notify registered listeners when properties change.
  *
+ *          Readers never take a lock. Every change builds a new immutable state and publishes
+ *          it whole: the cut preferences and duration as a versioned Snapshot through a
+ *          LockFreeSnapshot, the file path as a shared `Files` swapped atomically. The audio
+ *          thread, workers and the UI can therefore read at any time without waiting on a
+ *          writer. Writers are serialised among themselves, and listeners are called after the
+ *          writer's lock is released, so a slow listener never holds up another writer.
+ *
+ *          Cut notifications carry the latest snapshot rather than the one the write produced,
+ *          and only one thread delivers them at a time: a writer that finds another thread
+ *          delivering leaves its change to that thread and returns. However writers on
+ *          different threads interleave, the last cut values a listener receives are the final
+ *          state, never an older write delivered late.
+ *
+ *          Per-file metadata lives in a MetadataStore, which only takes a short lock of its own
+ *          per lookup. The application's store persists across sessions; the default
+ *          constructor keeps it in memory.
+ *
  * @see AudioPlayer
  * @see ControlPanel
  * @see FileMetadata
+ * @see MetadataStore
  */
 class SessionState {
   public:
@@ -39,12 +62,25 @@ class SessionState {
         }
     };
 
+    /** @brief Cut state as one consistent value; `version` grows with every change. */
+    struct Snapshot {
+        MainDomain::CutPreferences cutPrefs;
+        double totalDuration{0.0};
+        juce::uint64 version{0};
+    };
+
     SessionState();
 
+    /** @brief Keeps per-file metadata in `metadataStore`, e.g. one that persists on disk. */
+    explicit SessionState(std::unique_ptr<MetadataStore> metadataStore);
+
     void addListener(Listener *listener);
 
     void removeListener(Listener *listener);
 
+    /** @brief The latest published cut state. Never blocks; safe on any thread. */
+    Snapshot getSnapshot() const;
+
     MainDomain::CutPreferences getCutPrefs() const;
 
     void setCutActive(bool active);
@@ -68,20 +104,74 @@ class SessionState {
     void setTotalDuration(double duration);
     double getTotalDuration() const;
 
+    /**
+     * @brief A handle for `filePath` that stays valid for the session.
+     * @details Metadata reads and writes through the handle skip hashing and comparing the
+     *          path, so callers that touch the same file repeatedly should keep it.
+     */
+    FileId getFileId(const juce::String &filePath);
+
     FileMetadata getMetadataForFile(const juce::String &filePath) const;
+    /** @brief Copies the metadata for `fileId` into `metadataOut`; false if there is none. */
+    bool getMetadata(FileId fileId, FileMetadata &metadataOut) const;
     FileMetadata getCurrentMetadata() const;
     void setMetadataForFile(const juce::String &filePath, const FileMetadata &newMetadata);
+    void setMetadata(FileId fileId, const FileMetadata &newMetadata);
 
     bool hasMetadataForFile(const juce::String &filePath) const;
     void setCurrentFilePath(const juce::String &filePath);
     juce::String getCurrentFilePath() const;
 
   private:
+    /** Replaced, never modified, once published. */
+    struct Files {
+        juce::String currentFilePath;
+        FileId currentFileId{invalidFileId};
+    };
+
+    using Notifications = std::vector<std::function<void(Listener &)>>;
+
+    /** What one write changed; delivered by notify() once `writeLock` is released. */
+    struct Changes {
+        bool cutPrefs{false};
+        bool cutIn{false};
+        bool cutOut{false};
+        /** Delivered as queued, after the cut notifications. */
+        Notifications events;
+    };
+
+    std::shared_ptr<const Files> loadFiles() const;
+    /** Publishes the writer's cut state under a new version. Call with `writeLock` held. */
+    void publishCutPrefs();
+    /** Publishes a cut change and marks it for delivery. Call with `writeLock` held. */
+    void cutPrefsChanged(Changes &changes);
+    /** Publishes a changed copy of the files. Call with `writeLock` held. */
+    void updateFiles(const std::function<void(Files &)> &change);
+    /** Applies `change`, which returns whether it changed anything, and notifies. */
+    void updateCutPrefs(const std::function<bool(MainDomain::CutPreferences &)> &change);
+    void notify(const Changes &changes);
+    /**
+     * @brief Delivers the latest cut state, or leaves it to the thread already delivering.
+     * @details The delivering thread keeps going until no write arrived during its last round,
+     *          so the final round always reads the final snapshot.
+     */
+    void deliverCutChanges();
+
+    // The writers' copy of the state, guarded by writeLock.
     MainDomain::CutPreferences cutPrefs;
-    juce::String currentFilePath;
     double totalDuration{0.0};
-    std::map<juce::String, FileMetadata> metadataCache;
-    juce::ListenerList<Listener> listeners;
+    juce::uint64 version{0};
 
-    mutable juce::CriticalSection stateLock;
+    LockFreeSnapshot<Snapshot> snapshot;
+    /** Accessed only with std::atomic_load / std::atomic_store. */
+    std::shared_ptr<const Files> files;
+    juce::ListenerList<Listener> listeners;
+    /** Cut deliveries requested and not yet handled; nonzero while a thread is delivering. */
+    std::atomic<int> pendingDeliveries{0};
+    /** Set by setCutIn / setCutOut before requesting a delivery; cleared by the deliverer. */
+    std::atomic<bool> cutInPending{false};
+    std::atomic<bool> cutOutPending{false};
+    std::unique_ptr<MetadataStore> store;
+
+    juce::CriticalSection writeLock;
 };
@@ -0,0 +1,322 @@
+#include "Core/WaveformLod.h"
+#include "Utils/Config.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr char kMagic[4] = {'A', 'F', 'W', 'L'};
+constexpr juce::uint32 kVersion = 1;
+
+/** Serialised header, in native byte order like the AnalysisCache entry it sits next to. */
+struct LodHeader {
+    char magic[4];
+    juce::uint32 version;
+    juce::int32 numChannels;
+    juce::int32 baseBlockSize;
+    juce::int32 levelRatio;
+    juce::int32 numLevels;
+    juce::int64 lengthInSamples;
+    double sampleRate;
+    juce::uint64 numFloats;
+};
+
+static_assert(sizeof(LodHeader) == 48, "Waveform header layout must stay fixed");
+
+constexpr int coarsestBlockSize() {
+    int blockSize = Config::Audio::waveformLodBaseBlockSize;
+    for (int level = 1; level < Config::Audio::waveformLodNumLevels; ++level)
+        blockSize *= Config::Audio::waveformLodLevelRatio;
+    return blockSize;
+}
+
+static_assert(Config::Audio::envelopeReadChunkSize % coarsestBlockSize() == 0,
+              "Decode chunks must cover whole waveform blocks at every level");
+} // namespace
+
+WaveformLod::WaveformLod(int channels, juce::int64 length, double rate)
+    : numChannels(juce::jmax(0, channels)), lengthInSamples(juce::jmax((juce::int64)0, length)),
+      sampleRate(rate) {
+    size_t totalFloats = 0;
+    int blockSize = Config::Audio::waveformLodBaseBlockSize;
+    for (int level = 0; level < Config::Audio::waveformLodNumLevels; ++level) {
+        Level newLevel;
+        newLevel.blockSize = blockSize;
+        newLevel.numBlocks = (lengthInSamples + blockSize - 1) / blockSize;
+        newLevel.offset = totalFloats;
+        totalFloats += (size_t)newLevel.numBlocks * (size_t)numChannels * 2;
+        levels.push_back(newLevel);
+        blockSize *= Config::Audio::waveformLodLevelRatio;
+    }
+
+    storage.assign(totalFloats, 0.0f);
+    previewStorage.assign((size_t)levels.back().numBlocks * (size_t)numChannels * 2, 0.0f);
+}
+
+std::shared_ptr<WaveformLod> WaveformLod::fromData(const juce::MemoryBlock &data) {
+    LodHeader header{};
+    if (data.getSize() < sizeof(LodHeader))
+        return nullptr;
+    std::memcpy(&header, data.getData(), sizeof(LodHeader));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.baseBlockSize != Config::Audio::waveformLodBaseBlockSize ||
+        header.levelRatio != Config::Audio::waveformLodLevelRatio ||
+        header.numLevels != Config::Audio::waveformLodNumLevels || header.numChannels <= 0 ||
+        header.lengthInSamples <= 0)
+        return nullptr;
+
+    auto lod = std::make_shared<WaveformLod>(header.numChannels, header.lengthInSamples,
+                                             header.sampleRate);
+    const size_t numBytes = lod->storage.size() * sizeof(float);
+    if (header.numFloats != (juce::uint64)lod->storage.size() ||
+        data.getSize() != sizeof(LodHeader) + numBytes)
+        return nullptr;
+
+    const auto *payload = static_cast<const char *>(data.getData()) + sizeof(LodHeader);
+    std::memcpy(lod->storage.data(), payload, numBytes);
+    lod->samplesReady.store(lod->lengthInSamples, std::memory_order_release);
+    return lod;
+}
+
+void WaveformLod::saveTo(juce::MemoryBlock &data) const {
+    jassert(getNumSamplesReady() == lengthInSamples);
+
+    LodHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.numChannels = numChannels;
+    header.baseBlockSize = Config::Audio::waveformLodBaseBlockSize;
+    header.levelRatio = Config::Audio::waveformLodLevelRatio;
+    header.numLevels = Config::Audio::waveformLodNumLevels;
+    header.lengthInSamples = lengthInSamples;
+    header.sampleRate = sampleRate;
+    header.numFloats = (juce::uint64)storage.size();
+
+    data.setSize(0);
+    data.append(&header, sizeof(LodHeader));
+    data.append(storage.data(), storage.size() * sizeof(float));
+}
+
+int WaveformLod::getBaseBlockSize() const {
+    return levels.front().blockSize;
+}
+
+size_t WaveformLod::arrayOffset(int level, int channel, bool maxima) const {
+    const Level &info = levels[(size_t)level];
+    return info.offset + ((size_t)channel * 2 + (maxima ? 1 : 0)) * (size_t)info.numBlocks;
+}
+
+const float *WaveformLod::mins(int level, int channel) const {
+    return storage.data() + arrayOffset(level, channel, false);
+}
+
+const float *WaveformLod::maxs(int level, int channel) const {
+    return storage.data() + arrayOffset(level, channel, true);
+}
+
+void WaveformLod::addBlock(juce::int64 startSample, const juce::AudioBuffer<float> &buffer,
+                           int numSamples) {
+    jassert(startSample % levels.back().blockSize == 0);
+
+    const int channelsToRead = juce::jmin(numChannels, buffer.getNumChannels());
+    const juce::int64 endSample = juce::jmin(lengthInSamples, startSample + numSamples);
+    if (endSample <= startSample)
+        return;
+
+    const int baseBlockSize = getBaseBlockSize();
+    for (juce::int64 blockStart = startSample; blockStart < endSample;
+         blockStart += baseBlockSize) {
+        const size_t block = (size_t)(blockStart / baseBlockSize);
+        const int offset = (int)(blockStart - startSample);
+        const int blockLength =
+            (int)juce::jmin((juce::int64)baseBlockSize, endSample - blockStart);
+
+        for (int channel = 0; channel < channelsToRead; ++channel) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(
+                buffer.getReadPointer(channel, offset), blockLength);
+            storage[arrayOffset(0, channel, false) + block] = range.getStart();
+            storage[arrayOffset(0, channel, true) + block] = range.getEnd();
+        }
+    }
+
+    // Every coarser block starts inside this chunk, so it is derived from finer blocks only.
+    for (int level = 1; level < (int)levels.size(); ++level) {
+        const Level &finer = levels[(size_t)level - 1];
+        const Level &coarser = levels[(size_t)level];
+        const int ratio = coarser.blockSize / finer.blockSize;
+        const juce::int64 finerEnd = (endSample + finer.blockSize - 1) / finer.blockSize;
+
+        for (juce::int64 block = startSample / coarser.blockSize;
+             block * coarser.blockSize < endSample; ++block) {
+            const juce::int64 first = block * ratio;
+            const int count = (int)(juce::jmin(first + ratio, finerEnd) - first);
+
+            for (int channel = 0; channel < channelsToRead; ++channel) {
+                storage[arrayOffset(level, channel, false) + (size_t)block] =
+                    juce::FloatVectorOperations::findMinimum(mins(level - 1, channel) + first,
+                                                             count);
+                storage[arrayOffset(level, channel, true) + (size_t)block] =
+                    juce::FloatVectorOperations::findMaximum(maxs(level - 1, channel) + first,
+                                                             count);
+            }
+        }
+    }
+
+    samplesReady.store(endSample, std::memory_order_release);
+}
+
+juce::int64 WaveformLod::blocksReady(int level) const {
+    const juce::int64 ready = getNumSamplesReady();
+    const Level &info = levels[(size_t)level];
+    return ready >= lengthInSamples ? info.numBlocks : ready / info.blockSize;
+}
+
+int WaveformLod::chooseLevel(double samplesPerColumn) const {
+    int level = 0;
+    for (int candidate = 1; candidate < (int)levels.size(); ++candidate)
+        if ((double)levels[(size_t)candidate].blockSize <= samplesPerColumn)
+            level = candidate;
+    return level;
+}
+
+juce::Range<float> WaveformLod::blockRange(int level, int channel, juce::int64 firstBlock,
+                                           juce::int64 endBlock) const {
+    const juce::int64 first = juce::jmax((juce::int64)0, firstBlock);
+    const juce::int64 end = juce::jmin(blocksReady(level), endBlock);
+    if (end <= first)
+        return {};
+
+    const int count = (int)(end - first);
+    return {juce::FloatVectorOperations::findMinimum(mins(level, channel) + first, count),
+            juce::FloatVectorOperations::findMaximum(maxs(level, channel) + first, count)};
+}
+
+void WaveformLod::getColumns(int channel, double startSample, double samplesPerColumn,
+                             int numColumns, float *columnMins, float *columnMaxs) const {
+    if (channel < 0 || channel >= numChannels || samplesPerColumn <= 0.0) {
+        juce::FloatVectorOperations::clear(columnMins, numColumns);
+        juce::FloatVectorOperations::clear(columnMaxs, numColumns);
+        return;
+    }
+
+    const int level = chooseLevel(samplesPerColumn);
+    const double blockSize = (double)levels[(size_t)level].blockSize;
+    // Decoded blocks win; the preview only fills in past them.
+    const juce::int64 ready = getNumSamplesReady();
+    const double exactEnd = ready >= lengthInSamples
+                                ? (double)lengthInSamples
+                                : (double)(ready / levels[(size_t)level].blockSize) * blockSize;
+
+    for (int column = 0; column < numColumns; ++column) {
+        const double columnStart = startSample + samplesPerColumn * column;
+        if (columnStart >= (double)lengthInSamples || columnStart + samplesPerColumn <= 0.0) {
+            columnMins[column] = columnMaxs[column] = 0.0f;
+            continue;
+        }
+
+        const auto firstBlock = (juce::int64)std::floor(columnStart / blockSize);
+        const auto endBlock = juce::jmax(
+            firstBlock + 1,
+            (juce::int64)std::ceil((columnStart + samplesPerColumn) / blockSize));
+
+        juce::Range<float> range;
+        const bool decoded = (double)firstBlock * blockSize < exactEnd;
+        if (decoded)
+            range = blockRange(level, channel, firstBlock, endBlock);
+
+        juce::Range<float> preview;
+        const double columnEnd = columnStart + samplesPerColumn;
+        if (columnEnd > exactEnd &&
+            previewRange(channel, juce::jmax(columnStart, exactEnd), columnEnd, preview))
+            range = decoded ? range.getUnionWith(preview) : preview;
+
+        columnMins[column] = range.getStart();
+        columnMaxs[column] = range.getEnd();
+    }
+}
+
+bool WaveformLod::previewRange(int channel, double startSample, double endSample,
+                               juce::Range<float> &range) const {
+    const juce::int64 stride = previewStride.load(std::memory_order_acquire);
+    const Level &coarse = levels.back();
+    if (stride <= 0 || coarse.numBlocks <= 0)
+        return false;
+
+    const auto first = juce::jlimit((juce::int64)0, coarse.numBlocks - 1,
+                                    (juce::int64)std::floor(startSample / coarse.blockSize));
+    const auto last = juce::jlimit(first, coarse.numBlocks - 1,
+                                   (juce::int64)std::ceil(endSample / coarse.blockSize) - 1);
+
+    // Probes inside the range if there are any, else the nearest one before it.
+    juce::int64 probe = (first + stride - 1) / stride * stride;
+    if (probe > last)
+        probe = first / stride * stride;
+
+    const float *probeMins = previewStorage.data() + (size_t)channel * 2 * coarse.numBlocks;
+    const float *probeMaxs = probeMins + coarse.numBlocks;
+    range = {probeMins[probe], probeMaxs[probe]};
+    for (probe += stride; probe <= last; probe += stride)
+        range = range.getUnionWith({probeMins[probe], probeMaxs[probe]});
+    return true;
+}
+
+void WaveformLod::buildPreview(juce::AudioFormatReader &reader,
+                               const std::function<bool()> &shouldStop,
+                               const std::function<void()> &onPass) {
+    const Level &coarse = levels.back();
+    if (coarse.numBlocks <= 0 || numChannels <= 0)
+        return;
+
+    const int probeLength = juce::jmin(Config::Audio::waveformPreviewProbeSamples,
+                                       coarse.blockSize);
+    juce::AudioBuffer<float> probe(numChannels, probeLength);
+
+    const juce::int64 firstPassProbes = Config::Audio::waveformPreviewFirstPassProbes;
+    juce::int64 stride = 1;
+    while (stride * firstPassProbes < coarse.numBlocks)
+        stride *= 2;
+
+    for (int pass = 0; pass < Config::Audio::waveformPreviewNumPasses && stride > 0; ++pass) {
+        // Later passes only probe halfway between the blocks already published.
+        const juce::int64 firstBlock = pass == 0 ? 0 : stride;
+        const juce::int64 step = pass == 0 ? stride : stride * 2;
+
+        for (juce::int64 block = firstBlock; block < coarse.numBlocks; block += step) {
+            if (shouldStop != nullptr && shouldStop())
+                return;
+
+            const juce::int64 blockStart = block * coarse.blockSize;
+            const juce::int64 blockEnd = juce::jmin(lengthInSamples, blockStart + coarse.blockSize);
+            const int numSamples = (int)juce::jmin((juce::int64)probeLength, blockEnd - blockStart);
+            const juce::int64 start = blockStart + (blockEnd - blockStart - numSamples) / 2;
+            if (!reader.read(&probe, 0, numSamples, start, true, true))
+                return;
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const auto range = juce::FloatVectorOperations::findMinAndMax(
+                    probe.getReadPointer(channel), numSamples);
+                const size_t base = (size_t)channel * 2 * (size_t)coarse.numBlocks;
+                previewStorage[base + (size_t)block] = range.getStart();
+                previewStorage[base + (size_t)coarse.numBlocks + (size_t)block] = range.getEnd();
+            }
+        }
+
+        previewStride.store(stride, std::memory_order_release);
+        if (onPass != nullptr)
+            onPass();
+        stride /= 2;
+    }
+}
+
+juce::Range<float> WaveformLod::getMinMax(int channel, juce::int64 startSample,
+                                          juce::int64 numSamples) const {
+    if (channel < 0 || channel >= numChannels || numSamples <= 0)
+        return {};
+
+    const int level = chooseLevel((double)numSamples);
+    const juce::int64 blockSize = levels[(size_t)level].blockSize;
+    return blockRange(level, channel, startSample / blockSize,
+                      juce::jmax(startSample / blockSize + 1,
+                                 (startSample + numSamples + blockSize - 1) / blockSize));
+}
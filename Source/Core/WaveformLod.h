@@ -0,0 +1,143 @@
+#ifndef AUDIOFILER_WAVEFORMLOD_H
+#define AUDIOFILER_WAVEFORMLOD_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @file WaveformLod.h
+ * @ingroup AudioEngine
+ * @brief Min/max pyramid of an audio file for drawing its waveform at any zoom.
+ * @details Holds per-block minima and maxima at `Config::Audio::waveformLodBaseBlockSize`
+ *          samples and at each `waveformLodLevelRatio` multiple of it, per channel, in
+ *          structure-of-arrays layout (all minima of a channel and level contiguous, then all
+ *          maxima). A column of the waveform is answered from the coarsest level whose blocks
+ *          still fit inside it, so a full view of a long file touches a handful of floats per
+ *          pixel and a zoomed view stays exact down to the base block.
+ *
+ *          Unlike EnvelopeIndex it is drawn while it fills: `addBlock()` appends decoded
+ *          audio on the decoding thread and publishes how far the pyramid is valid, and readers
+ *          on any thread only look below that point. Storage is allocated up front, so readers
+ *          never see it move. It takes about 7% of the space of the same audio as 16-bit PCM.
+ *
+ *          Before the decode reaches a region, `buildPreview()` can fill it with an estimate
+ *          taken from short windows read at strided points across the whole file, refined in
+ *          passes. Columns past the decoded part are drawn from that estimate, so the whole
+ *          shape appears long before the decode finishes.
+ *
+ * @see WaveformManager
+ * @see WaveformRenderer
+ */
+class WaveformLod {
+  public:
+    WaveformLod(int numChannels, juce::int64 lengthInSamples, double sampleRate);
+
+    /**
+     * @brief Restores a pyramid written by saveTo().
+     * @return The complete pyramid, or nullptr if the data is malformed or was built with
+     *         different `Config::Audio` waveform settings.
+     */
+    static std::shared_ptr<WaveformLod> fromData(const juce::MemoryBlock &data);
+
+    /** @brief Serialises the pyramid, e.g. for the AnalysisCache. */
+    void saveTo(juce::MemoryBlock &data) const;
+
+    /**
+     * @brief Appends decoded audio and makes it visible to readers.
+     * @details Blocks must arrive in order and `startSample` must be a multiple of the coarsest
+     *          block size; only the final block of the file may be partial. One writer only.
+     */
+    void addBlock(juce::int64 startSample, const juce::AudioBuffer<float> &buffer,
+                  int numSamples);
+
+    int getNumChannels() const noexcept {
+        return numChannels;
+    }
+
+    juce::int64 getLengthInSamples() const noexcept {
+        return lengthInSamples;
+    }
+
+    double getSampleRate() const noexcept {
+        return sampleRate;
+    }
+
+    /**
+     * @brief Estimates the whole file from strided reads, coarse first, then finer.
+     * @details Reads `Config::Audio::waveformPreviewProbeSamples` around the centre of a
+     *          spread of coarsest-level blocks, doubling the number of blocks every pass. Each
+     *          finished pass is published to readers without locking and then reported through
+     *          `onPass`. Meant to run on the decoding thread before addBlock() starts.
+     * @param shouldStop Polled between reads; returning true abandons the preview.
+     */
+    void buildPreview(juce::AudioFormatReader &reader, const std::function<bool()> &shouldStop,
+                      const std::function<void()> &onPass);
+
+    /** @brief Samples from the start of the file that the pyramid covers so far. */
+    juce::int64 getNumSamplesReady() const noexcept {
+        return samplesReady.load(std::memory_order_acquire);
+    }
+
+    /** @brief Samples covered by one block at the finest level. */
+    int getBaseBlockSize() const;
+
+    /**
+     * @brief Min/max of `numColumns` adjacent columns of `samplesPerColumn` samples each.
+     * @details Columns outside the file get min = max = 0. Columns not yet decoded are taken
+     *          from the preview, or are 0 without one.
+     * @param mins Receives `numColumns` minima.
+     * @param maxs Receives `numColumns` maxima.
+     */
+    void getColumns(int channel, double startSample, double samplesPerColumn, int numColumns,
+                    float *mins, float *maxs) const;
+
+    /**
+     * @brief Min/max of a channel over a sample range, to the nearest base block.
+     * @details Decoded audio only; the preview is never consulted.
+     */
+    juce::Range<float> getMinMax(int channel, juce::int64 startSample,
+                                 juce::int64 numSamples) const;
+
+  private:
+    struct Level {
+        int blockSize{0};
+        juce::int64 numBlocks{0};
+        size_t offset{0};
+    };
+
+    size_t arrayOffset(int level, int channel, bool maxima) const;
+    const float *mins(int level, int channel) const;
+    const float *maxs(int level, int channel) const;
+    juce::int64 blocksReady(int level) const;
+    int chooseLevel(double samplesPerColumn) const;
+    juce::Range<float> blockRange(int level, int channel, juce::int64 firstBlock,
+                                  juce::int64 endBlock) const;
+    bool previewRange(int channel, double startSample, double endSample,
+                      juce::Range<float> &range) const;
+
+    int numChannels{0};
+    juce::int64 lengthInSamples{0};
+    double sampleRate{0.0};
+    std::vector<Level> levels;
+    std::vector<float> storage;
+    std::atomic<juce::int64> samplesReady{0};
+
+    /** Per coarsest block, same layout as one level of `storage`. */
+    std::vector<float> previewStorage;
+    /** Blocks whose index is a multiple of this hold a probe; 0 before the first pass. */
+    std::atomic<juce::int64> previewStride{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformLod)
+};
+
+#endif
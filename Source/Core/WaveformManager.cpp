@@ -1,27 +1,140 @@
-
-
 #include "Core/WaveformManager.h"
 
+#include <utility>
+
 WaveformManager::WaveformManager(juce::AudioFormatManager &formatManagerIn)
     : formatManager(formatManagerIn) {
 }
 
-void WaveformManager::loadFile(const juce::File &file) {
-    thumbnail.setSource(new juce::FileInputSource(file));
+WaveformManager::LoadId WaveformManager::beginStreamingLoad(int numChannels, double sampleRate,
+                                                            juce::int64 lengthInSamples) {
+    thumbnail.reset(numChannels, sampleRate, lengthInSamples);
+    LoadId load = 0;
+    {
+        std::lock_guard<std::mutex> lock(lodMutex);
+        lod = std::make_shared<WaveformLod>(numChannels, lengthInSamples, sampleRate);
+        load = ++currentLoad;
+        detail.reset();
+    }
+    ++detailGeneration;
+    requestedDetail = {};
+    sendChangeMessage();
+    return load;
 }
 
-juce::AudioThumbnail &WaveformManager::getThumbnail() {
-    return thumbnail;
+std::shared_ptr<WaveformLod> WaveformManager::lodFor(LoadId load) const {
+    std::lock_guard<std::mutex> lock(lodMutex);
+    return load == currentLoad ? lod : nullptr;
 }
 
-const juce::AudioThumbnail &WaveformManager::getThumbnail() const {
-    return thumbnail;
+void WaveformManager::addBlock(LoadId load, juce::int64 startSample,
+                               const juce::AudioBuffer<float> &buffer, int numSamples) {
+    // A load superseded after this check writes into its own, already replaced, waveform.
+    if (auto target = lodFor(load)) {
+        target->addBlock(startSample, buffer, numSamples);
+        sendChangeMessage();
+    }
+}
+
+void WaveformManager::buildPreview(LoadId load, juce::AudioFormatReader &reader,
+                                   const std::function<bool()> &shouldStop) {
+    if (auto target = lodFor(load))
+        target->buildPreview(reader, shouldStop, [this] { sendChangeMessage(); });
+}
+
+bool WaveformManager::loadFrom(LoadId load, const juce::MemoryBlock &data) {
+    auto restored = WaveformLod::fromData(data);
+    if (restored == nullptr)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(lodMutex);
+        if (load != currentLoad)
+            return false;
+        if (lod != nullptr && (lod->getNumChannels() != restored->getNumChannels() ||
+                               lod->getLengthInSamples() != restored->getLengthInSamples()))
+            return false;
+        lod = std::move(restored);
+    }
+    sendChangeMessage();
+    return true;
+}
+
+bool WaveformManager::saveTo(LoadId load, juce::MemoryBlock &data) const {
+    auto current = lodFor(load);
+    if (current == nullptr)
+        return false;
+    current->saveTo(data);
+    return true;
+}
+
+std::shared_ptr<const WaveformLod> WaveformManager::getLod() const {
+    std::lock_guard<std::mutex> lock(lodMutex);
+    return lod;
 }
 
-void WaveformManager::addChangeListener(juce::ChangeListener *listener) {
-    thumbnail.addChangeListener(listener);
+void WaveformManager::setDetailReader(std::unique_ptr<juce::AudioFormatReader> reader) {
+    // The old reader is closed on the detail thread, after any read still using it.
+    if (auto retired = std::exchange(detailReader, std::move(reader)))
+        detailPool.addJob([retired] {});
+    ++detailGeneration;
+    requestedDetail = {};
 }
 
-void WaveformManager::removeChangeListener(juce::ChangeListener *listener) {
-    thumbnail.removeChangeListener(listener);
+std::shared_ptr<const WaveformManager::DetailBlock>
+WaveformManager::getDetail(juce::int64 firstSample, int numSamples) const {
+    if (detailReader == nullptr || numSamples <= 0)
+        return nullptr;
+
+    const juce::Range<juce::int64> file(0, detailReader->lengthInSamples);
+    const auto wanted = file.getIntersectionWith({firstSample, firstSample + numSamples});
+    if (wanted.isEmpty())
+        return nullptr;
+
+    LoadId load = 0;
+    {
+        std::lock_guard<std::mutex> lock(lodMutex);
+        if (detail != nullptr && detail->covers(wanted))
+            return detail;
+        load = currentLoad;
+    }
+
+    // Already on its way; the paint after it arrives finds it.
+    if (requestedDetail.contains(wanted))
+        return nullptr;
+
+    const auto margin = (juce::int64)(numSamples * Config::Audio::waveformDetailMargin);
+    const auto span = file.getIntersectionWith(
+        {wanted.getStart() - margin, wanted.getEnd() + margin});
+    requestedDetail = span;
+    const juce::uint32 generation = ++detailGeneration;
+
+    detailPool.addJob([this, reader = detailReader, span, generation, load] {
+        if (detailGeneration.load() != generation)
+            return;
+
+        auto block = std::make_shared<DetailBlock>();
+        block->firstSample = span.getStart();
+        block->samples.setSize((int)reader->numChannels, (int)span.getLength());
+        if (!reader->read(&block->samples, 0, (int)span.getLength(), span.getStart(), true,
+                          true))
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(lodMutex);
+            if (load != currentLoad || detailGeneration.load() != generation)
+                return;
+            detail = std::move(block);
+        }
+        sendChangeMessage();
+    });
+    return nullptr;
+}
+
+juce::AudioThumbnail &WaveformManager::getThumbnail() {
+    return thumbnail;
+}
+
+const juce::AudioThumbnail &WaveformManager::getThumbnail() const {
+    return thumbnail;
 }
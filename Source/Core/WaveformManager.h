@@ -1,5 +1,3 @@
-
-
 #ifndef AUDIOFILER_WAVEFORMMANAGER_H
 #define AUDIOFILER_WAVEFORMMANAGER_H
 
@@ -13,24 +11,133 @@
 #include <JuceHeader.h>
 #endif
 
-class WaveformManager {
+#include "Core/WaveformLod.h"
+#include "Utils/Config.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @file WaveformManager.h
+ * @ingroup AudioEngine
+ * @brief Owns the drawable waveform of the loaded file.
+ * @details The waveform is a WaveformLod fed by the same decode that builds the EnvelopeIndex,
+ *          or restored from the AnalysisCache. Listeners are told whenever more of it becomes
+ *          visible. For zoom levels finer than the pyramid's base block, a private reader of the
+ *          file supplies the samples themselves, read on a background thread around the view.
+ *
+ *          The `juce::AudioThumbnail` is kept only as the timeline: it carries the loaded
+ *          length that presenters and views query, but no longer holds or draws any data.
+ *
+ * @see WaveformLod
+ * @see WaveformRenderer
+ */
+class WaveformManager : public juce::ChangeBroadcaster {
   public:
+    /**
+     * @brief Names one load. The builder-thread calls below take the id of the load they feed
+     *        and do nothing once a newer load has begun, so a superseded decode that is still
+     *        winding down never writes into the next file's waveform.
+     */
+    using LoadId = juce::uint32;
+
     explicit WaveformManager(juce::AudioFormatManager &formatManagerIn);
 
-    void loadFile(const juce::File &file);
+    /**
+     * @brief Starts an empty waveform for a file that will be streamed in via addBlock().
+     * @details The waveform is not decoded here; it is fed by the decode that builds the
+     *          EnvelopeIndex. Message thread.
+     * @return The id the decode passes back with every call for this file.
+     */
+    LoadId beginStreamingLoad(int numChannels, double sampleRate, juce::int64 lengthInSamples);
 
-    juce::AudioThumbnail &getThumbnail();
+    /** @brief Adds decoded samples to the waveform. Safe to call from the builder thread. */
+    void addBlock(LoadId load, juce::int64 startSample, const juce::AudioBuffer<float> &buffer,
+                  int numSamples);
 
-    const juce::AudioThumbnail &getThumbnail() const;
+    /**
+     * @brief Fills the waveform with a strided preview read from `reader`. Builder thread.
+     * @details Runs before the decode, so the whole file shows at once; decoded blocks replace
+     *          the preview as addBlock() reaches them. Stops early once `shouldStop` is true.
+     */
+    void buildPreview(LoadId load, juce::AudioFormatReader &reader,
+                      const std::function<bool()> &shouldStop);
+
+    /**
+     * @brief Restores a waveform previously produced by saveTo(). Any thread.
+     * @return False if the data is unreadable, does not match the file being loaded or
+     *         `load` has been superseded.
+     */
+    bool loadFrom(LoadId load, const juce::MemoryBlock &data);
+
+    /**
+     * @brief Serialises the finished waveform so it can be cached alongside the envelope.
+     * @return False, leaving `data` alone, if `load` has been superseded.
+     */
+    bool saveTo(LoadId load, juce::MemoryBlock &data) const;
+
+    /** @brief The current waveform, or nullptr before the first load. Any thread. */
+    std::shared_ptr<const WaveformLod> getLod() const;
 
-    void addChangeListener(juce::ChangeListener *listener);
+    /**
+     * @brief Takes the private reader used for sample-level zoom. Message thread only.
+     * @details The reader is opened by the caller, off the message thread, through
+     *          `AudioReaderFactory`, so uncompressed files are read straight from the page cache.
+     */
+    void setDetailReader(std::unique_ptr<juce::AudioFormatReader> reader);
 
-    void removeChangeListener(juce::ChangeListener *listener);
+    /** @brief Samples of every channel from `firstSample` on, read for sample-level zoom. */
+    struct DetailBlock {
+        juce::int64 firstSample{0};
+        juce::AudioBuffer<float> samples;
+
+        bool covers(juce::Range<juce::int64> range) const {
+            return range.getStart() >= firstSample &&
+                   range.getEnd() <= firstSample + samples.getNumSamples();
+        }
+    };
+
+    /**
+     * @brief Samples covering `[firstSample, firstSample + numSamples)`, as far as the file
+     *        reaches, or nullptr while they are being read. Message thread only.
+     * @details Paints call this, so it never reads: a background thread reads the span, with
+     *          `Config::Audio::waveformDetailMargin` to spare on each side, through the reader
+     *          passed to setDetailReader(). Listeners are told once it is there, as they are
+     *          for the waveform. Only the latest request is read.
+     */
+    std::shared_ptr<const DetailBlock> getDetail(juce::int64 firstSample, int numSamples) const;
+
+    juce::AudioThumbnail &getThumbnail();
+
+    const juce::AudioThumbnail &getThumbnail() const;
 
   private:
     juce::AudioFormatManager &formatManager;
-    juce::AudioThumbnailCache thumbnailCache{5};
-    juce::AudioThumbnail thumbnail{512, formatManager, thumbnailCache};
+    juce::AudioThumbnailCache thumbnailCache{Config::Audio::thumbnailCacheSize};
+    juce::AudioThumbnail thumbnail{Config::Audio::thumbnailSizePixels, formatManager,
+                                   thumbnailCache};
+
+    /** Returns the waveform of `load`, or nullptr once a newer load has begun. */
+    std::shared_ptr<WaveformLod> lodFor(LoadId load) const;
+
+    mutable std::mutex lodMutex;
+    std::shared_ptr<WaveformLod> lod;
+    /** Guarded by `lodMutex`, like `lod`. */
+    LoadId currentLoad{0};
+    /** Guarded by `lodMutex`; the samples last read for the current load. */
+    std::shared_ptr<const DetailBlock> detail;
+
+    /** Shared with the read in flight, which may outlive a newer setDetailReader(). */
+    std::shared_ptr<juce::AudioFormatReader> detailReader;
+    /** The span last asked for; message thread only. */
+    mutable juce::Range<juce::int64> requestedDetail;
+    /** Bumped by every request and load; a read only publishes if it is still the latest. */
+    mutable std::atomic<juce::uint32> detailGeneration{0};
+    /** Declared last, so its reads finish before anything they use is destroyed. */
+    mutable juce::ThreadPool detailPool{juce::ThreadPoolOptions()
+                                            .withThreadName("WaveformDetail")
+                                            .withNumberOfThreads(1)};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformManager)
 };
@@ -6,6 +6,13 @@
 #include "Utils/Config.h"
 #include "Utils/TimeUtils.h"
 
+#include <cmath>
+
+namespace {
+constexpr int kExportStopTimeoutMs = 4000;
+constexpr int kFolderListStopTimeoutMs = 4000;
+} // namespace
+
 MainComponent::MainComponent() {
     audioPlayer = std::make_unique<AudioPlayer>(sessionState);
     audioPlayer->addChangeListener(this);
@@ -15,6 +22,18 @@ MainComponent::MainComponent() {
 
     keybindHandler = std::make_unique<KeybindHandler>(*this, *audioPlayer, *controlPanel);
 
+    prefetcher = std::make_unique<FilePrefetcher>(audioPlayer->getFormatManager(),
+                                                  audioPlayer->getAnalysisCache());
+    audioPlayer->onEnvelopeReady = [this] {
+        controlPanel->updateStatsFromAudio();
+        // The current file is decoded; the next ones may use the disk and CPU now.
+        if (!audioPlayer->isLoading())
+            prefetcher->prefetch(playlist.getUpcoming(Config::Cache::prefetchAheadFiles));
+    };
+
+    regionRenderer = std::make_unique<RegionRenderer>(audioPlayer->getFormatManager());
+    lifeToken = std::make_shared<bool>(true);
+
     setAudioChannels(0, 2);
 
     setSize(Config::Layout::Window::width, Config::Layout::Window::height);
@@ -24,7 +43,14 @@ MainComponent::MainComponent() {
 }
 
 MainComponent::~MainComponent() {
+    exportCancelled = true;
+    lifeToken.reset();
+    exportPool.removeAllJobs(true, kExportStopTimeoutMs);
+    folderListPool.removeAllJobs(true, kFolderListStopTimeoutMs);
+    prefetcher.reset();
+
     openGLContext.detach();
+    audioPlayer->onEnvelopeReady = nullptr;
     audioPlayer->removeChangeListener(this);
 
     shutdownAudio();
@@ -60,27 +86,134 @@ void MainComponent::changeListenerCallback(juce::ChangeBroadcaster *source) {
 }
 
 void MainComponent::openButtonClicked() {
+    const juce::String wildcard = audioPlayer->getFormatManager().getWildcardForAllFormats();
     chooser = std::make_unique<juce::FileChooser>(
         "Select Audio...", juce::File::getSpecialLocation(juce::File::userHomeDirectory),
-        audioPlayer->getFormatManager().getWildcardForAllFormats());
-
-    auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
-
-    chooser->launchAsync(flags, [this](const juce::FileChooser &fc) {
-        auto file = fc.getResult();
-        if (file.exists()) {
-            auto result = audioPlayer->loadFile(file);
-            if (result.wasOk()) {
-                controlPanel->setTotalTimeStaticString(
-                    TimeUtils::formatTime(audioPlayer->getThumbnail().getTotalLength()));
-
-                controlPanel->refreshLabels();
-                controlPanel->updateComponentStates();
-                controlPanel->updateStatsFromAudio();
-            } else {
-                controlPanel->setStatsDisplayText(result.getErrorMessage(),
-                                                  Config::Colors::statsErrorText);
+        wildcard);
+
+    auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles |
+                 juce::FileBrowserComponent::canSelectMultipleItems;
+
+    chooser->launchAsync(flags, [this, wildcard](const juce::FileChooser &fc) {
+        const auto files = fc.getResults();
+        ++folderListGeneration;
+        if (!files.isEmpty())
+            playlist.setFiles(files, files.getFirst());
+        if (files.size() == 1)
+            listFolderOf(files.getFirst(), wildcard);
+
+        if (!files.isEmpty())
+            loadFile(playlist.getCurrent());
+
+        grabKeyboardFocus();
+    });
+}
+
+void MainComponent::listFolderOf(const juce::File &file, const juce::String &wildcard) {
+    const juce::uint32 generation = folderListGeneration;
+    std::weak_ptr<bool> weakToken = lifeToken;
+    folderListPool.addJob([this, file, wildcard, generation, weakToken] {
+        const auto siblings = Playlist::listFolderOf(file, wildcard);
+
+        juce::MessageManager::callAsync([this, file, generation, weakToken, siblings] {
+            if (auto token = weakToken.lock()) {
+                // A later pick replaced the playlist while the folder was being listed.
+                if (generation != folderListGeneration)
+                    return;
+
+                playlist.setFiles(siblings, file);
+                if (audioPlayer->getEnvelopeIndex() != nullptr && !audioPlayer->isLoading())
+                    prefetcher->prefetch(playlist.getUpcoming(Config::Cache::prefetchAheadFiles));
             }
+        });
+    });
+}
+
+void MainComponent::nextFileClicked() {
+    const auto file = playlist.moveToNext();
+    if (file != juce::File())
+        loadFile(file);
+}
+
+void MainComponent::previousFileClicked() {
+    const auto file = playlist.moveToPrevious();
+    if (file != juce::File())
+        loadFile(file);
+}
+
+void MainComponent::loadFile(const juce::File &file) {
+    if (!file.exists())
+        return;
+
+    // Keep the disk for this load; the prefetch resumes once its envelope is ready.
+    prefetcher->cancel();
+
+    // The previous file keeps playing until the new one is open; a later pick supersedes this.
+    controlPanel->setStatsDisplayText("Loading " + file.getFileName() + "...",
+                                      Config::Colors::statsText);
+    audioPlayer->loadFileAsync(file, [this](const juce::Result &result) {
+        if (result.wasOk()) {
+            controlPanel->setTotalTimeStaticString(
+                TimeUtils::formatTime(audioPlayer->getThumbnail().getTotalLength()));
+
+            controlPanel->refreshLabels();
+            controlPanel->updateComponentStates();
+            controlPanel->updateStatsFromAudio();
+        } else {
+            controlPanel->setStatsDisplayText(result.getErrorMessage(),
+                                              Config::Colors::statsErrorText);
+        }
+    });
+}
+
+void MainComponent::exportRegionClicked() {
+    double sampleRate = 0.0;
+    juce::int64 lengthInSamples = 0;
+    const juce::File source = audioPlayer->getLoadedFile();
+    if (!audioPlayer->getReaderInfo(sampleRate, lengthInSamples) || sampleRate <= 0.0)
+        return;
+
+    chooser = std::make_unique<juce::FileChooser>(
+        Config::Labels::exportChooserTitle,
+        source.getSiblingFile(source.getFileNameWithoutExtension() +
+                              Config::Labels::exportFileSuffix + ".wav"),
+        "*.wav;*.flac;*.ogg");
+
+    auto flags = juce::FileBrowserComponent::saveMode |
+                 juce::FileBrowserComponent::canSelectFiles |
+                 juce::FileBrowserComponent::warnAboutOverwriting;
+
+    chooser->launchAsync(flags, [this, source, sampleRate](const juce::FileChooser &fc) {
+        const juce::File target = fc.getResult();
+        if (target != juce::File()) {
+            RegionRenderer::Request request;
+            request.source = source;
+            request.destination = target;
+            request.startSample = (juce::int64)std::llround(audioPlayer->getCutIn() * sampleRate);
+            request.endSample = (juce::int64)std::llround(audioPlayer->getCutOut() * sampleRate);
+            request.fadeInSamples = (int)(Config::Audio::exportFadeSeconds * sampleRate);
+            request.fadeOutSamples = request.fadeInSamples;
+
+            controlPanel->setStatsDisplayText("Exporting " + target.getFileName() + "...",
+                                              Config::Colors::statsText);
+
+            std::weak_ptr<bool> weakToken = lifeToken;
+            exportPool.addJob([this, request, weakToken] {
+                const juce::Result result =
+                    regionRenderer->render(request, [this] { return exportCancelled.load(); });
+
+                juce::MessageManager::callAsync([this, weakToken, result, request] {
+                    if (auto token = weakToken.lock()) {
+                        if (result.wasOk())
+                            controlPanel->setStatsDisplayText(
+                                "Exported " + request.destination.getFileName(),
+                                Config::Colors::statsText);
+                        else
+                            controlPanel->setStatsDisplayText(result.getErrorMessage(),
+                                                              Config::Colors::statsErrorText);
+                    }
+                });
+            });
         }
 
         grabKeyboardFocus();
@@ -99,6 +232,9 @@ void MainComponent::seekToPosition(int x) {
 }
 
 bool MainComponent::keyPressed(const juce::KeyPress &key) {
+    // Key holds such as Z are checked on the frames this wakes.
+    if (controlPanel != nullptr)
+        controlPanel->getPlaybackTimerManager().wake();
     if (keybindHandler != nullptr)
         return keybindHandler->handleKeyPress(key);
     return false;
@@ -10,8 +10,13 @@
 
 #include "Core/AppEnums.h"
 #include "Core/AudioPlayer.h"
+#include "Core/Playlist.h"
+#include "Core/RegionRenderer.h"
 #include "Core/SessionState.h"
 #include "UI/ControlPanel.h"
+#include "Workers/FilePrefetcher.h"
+#include <atomic>
+#include <memory>
 
 class KeybindHandler;
 
@@ -43,9 +48,14 @@ class KeybindHandler;
  *          It implements `juce::AudioAppComponent` to handle audio callbacks and
  *          `juce::ChangeListener` to respond to transport changes.
  *
+ *          Files are opened through a `Playlist`. Once the current file's envelope is ready,
+ *          a `FilePrefetcher` prepares the next `Config::Cache::prefetchAheadFiles` files in
+ *          the background, so stepping to them does not start from zero.
+ *
  * @see AudioPlayer
  * @see ControlPanel
  * @see SessionState
+ * @see Playlist
  */
 class MainComponent : public juce::AudioAppComponent, public juce::ChangeListener {
   public:
@@ -69,8 +79,26 @@ class MainComponent : public juce::AudioAppComponent, public juce::ChangeListene
 
     bool keyPressed(const juce::KeyPress &key) override;
 
+    /**
+     * @brief Asks for files and opens the first of them.
+     * @details Several files become the playlist; a single file brings the audio files of its
+     *          folder along once a background thread has listed it.
+     */
     void openButtonClicked();
 
+    /** @brief Opens the next file of the playlist, if there is one. */
+    void nextFileClicked();
+
+    /** @brief Opens the previous file of the playlist, if there is one. */
+    void previousFileClicked();
+
+    /**
+     * @brief Asks for a destination and writes the cut region of the loaded file there.
+     * @details The render runs on a background thread; the outcome is shown in the stats
+     *          display. The format follows the chosen extension (WAV, FLAC or Ogg Vorbis).
+     */
+    void exportRegionClicked();
+
     void seekToPosition(int x);
 
     AudioPlayer *getAudioPlayer() const {
@@ -78,13 +106,41 @@ class MainComponent : public juce::AudioAppComponent, public juce::ChangeListene
     }
 
   private:
-    SessionState sessionState;
+    /**
+     * @brief Starts loading `file` in the background; refreshes the panel or shows the error
+     *        once it is open.
+     */
+    void loadFile(const juce::File &file);
+
+    /**
+     * @brief Lists `file`'s folder on a background thread and makes it the playlist, `file`
+     *        current, unless another pick has replaced the playlist by then.
+     */
+    void listFolderOf(const juce::File &file, const juce::String &wildcard);
+
+    SessionState sessionState{
+        std::make_unique<MetadataStore>(MetadataStore::getDefaultDirectory())};
     std::unique_ptr<AudioPlayer> audioPlayer;
+    Playlist playlist;
+    /** Declared after audioPlayer, whose cache and format manager it uses. */
+    std::unique_ptr<FilePrefetcher> prefetcher;
     std::unique_ptr<juce::FileChooser> chooser;
     std::unique_ptr<ControlPanel> controlPanel;
     std::unique_ptr<KeybindHandler> keybindHandler;
     juce::OpenGLContext openGLContext;
 
+    std::unique_ptr<RegionRenderer> regionRenderer;
+    juce::ThreadPool exportPool{
+        juce::ThreadPoolOptions().withThreadName("RegionExport").withNumberOfThreads(1)};
+    std::atomic<bool> exportCancelled{false};
+
+    /** Lists the folder of a single picked file; a slow volume must not stall the UI. */
+    juce::ThreadPool folderListPool{
+        juce::ThreadPoolOptions().withThreadName("FolderList").withNumberOfThreads(1)};
+    /** Bumped by every pick; a listing only replaces the playlist if it is still current. */
+    juce::uint32 folderListGeneration{0};
+    std::shared_ptr<bool> lifeToken;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
 };
 
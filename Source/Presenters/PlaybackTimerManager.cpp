@@ -6,14 +6,91 @@
 #include "Utils/Config.h"
 #include "Utils/UIAnimationHelper.h"
 
+#include <cmath>
+
 PlaybackTimerManager::PlaybackTimerManager(SessionState &sessionStateIn, AudioPlayer &audioPlayerIn,
                                            InteractionCoordinator &coordinatorIn)
     : sessionState(sessionStateIn), audioPlayer(audioPlayerIn),
-      interactionCoordinator(coordinatorIn) {
-    startTimerHz(60);
+      interactionCoordinator(coordinatorIn), startMs(juce::Time::getMillisecondCounterHiRes()) {
+    sessionState.addListener(this);
+    audioPlayer.addChangeListener(this);
+    juce::Desktop::getInstance().addGlobalMouseListener(this);
+
+    // Start awake so the first frames after launch are smooth.
+    lastActivityMs = startMs;
+    applyPace(Pace::Active);
 }
+
 PlaybackTimerManager::~PlaybackTimerManager() {
+    stop();
+    juce::Desktop::getInstance().removeGlobalMouseListener(this);
+    audioPlayer.removeChangeListener(this);
+    sessionState.removeListener(this);
+}
+
+void PlaybackTimerManager::attachToDisplay(juce::Component &component) {
+    display = &component;
+    if (pace == Pace::Active)
+        applyPace(Pace::Active);
+}
+
+void PlaybackTimerManager::stop() {
+    stopped = true;
     stopTimer();
+    vblank.reset();
+}
+
+void PlaybackTimerManager::wake() {
+    JUCE_ASSERT_MESSAGE_THREAD
+    lastActivityMs = juce::Time::getMillisecondCounterHiRes();
+    if (pace != Pace::Active)
+        applyPace(Pace::Active);
+}
+
+void PlaybackTimerManager::applyPace(Pace newPace) {
+    pace = newPace;
+    if (stopped)
+        return;
+
+    if (pace == Pace::Active && display != nullptr) {
+        if (vblank == nullptr)
+            vblank = std::make_unique<juce::VBlankAttachment>(display, [this] { frame(); });
+
+        // No vblank arrives while the window is hidden; a slow tick still notices changes
+        // such as playback reaching the end.
+        startTimerHz(Config::Animation::idleFrameRateHz);
+        return;
+    }
+
+    vblank.reset();
+    switch (pace) {
+    case Pace::Active:
+        startTimerHz(Config::Animation::activeFrameRateHz);
+        break;
+    case Pace::Animating:
+        startTimerHz(Config::Animation::animatingFrameRateHz);
+        break;
+    case Pace::Idle:
+        startTimerHz(Config::Animation::idleFrameRateHz);
+        break;
+    }
+}
+
+PlaybackTimerManager::Pace PlaybackTimerManager::choosePace(double nowMs) const {
+    const bool isBusy =
+        audioPlayer.isPlaying() || m_isZKeyDown ||
+        interactionCoordinator.getActiveZoomPoint() != AppEnums::ActiveZoomPoint::None ||
+        juce::ModifierKeys::currentModifiers.isAnyMouseButtonDown() ||
+        nowMs - lastActivityMs < Config::Animation::activityHoldSeconds * 1000.0;
+    if (isBusy)
+        return Pace::Active;
+
+    const juce::ScopedLock lock(listenerLock);
+    for (auto *listener : listeners.getListeners())
+        if (listener->isAnimating())
+            return Pace::Animating;
+
+    return Pace::Idle;
 }
 
 void PlaybackTimerManager::addListener(Listener *l) {
@@ -27,8 +104,23 @@ void PlaybackTimerManager::removeListener(Listener *l) {
 }
 
 void PlaybackTimerManager::timerCallback() {
+    // With vblank attached the timer is only a fallback for when no vblank arrives.
+    const double fallbackMs = 1000.0 / Config::Animation::idleFrameRateHz;
+    if (vblank != nullptr && juce::Time::getMillisecondCounterHiRes() - lastFrameMs < fallbackMs)
+        return;
+
+    frame();
+}
+
+void PlaybackTimerManager::frame() {
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    lastFrameMs = nowMs;
+
+    // A Z press arrives as a key event, which wakes the manager, so the key only needs
+    // checking at the active rate.
     const bool isZDown =
-        juce::KeyPress::isKeyCurrentlyDown('z') || juce::KeyPress::isKeyCurrentlyDown('Z');
+        pace == Pace::Active &&
+        (juce::KeyPress::isKeyCurrentlyDown('z') || juce::KeyPress::isKeyCurrentlyDown('Z'));
 
     const auto lastActivePoint = interactionCoordinator.getActiveZoomPoint();
 
@@ -57,17 +149,59 @@ void PlaybackTimerManager::timerCallback() {
     if (m_repeatController != nullptr)
         m_repeatController->tick();
 
-    // Update master animation clock
+    // The master animation clock is wall-clock time, so it is independent of the frame rate.
     const float duration = Config::Animation::masterPhaseDurationSeconds;
-    m_masterPhase += (1.0f / (60.0f * duration));
-    if (m_masterPhase >= 1.0f)
-        m_masterPhase = 0.0f;
+    const double elapsedSeconds = (nowMs - startMs) / 1000.0;
+    m_masterPhase = (float)(std::fmod(elapsedSeconds, (double)duration) / duration);
 
     // Calculate breathing pulse at 1Hz (multiplier = duration since cycle is 'duration' seconds)
     m_breathingPulse = UIAnimationHelper::getSinePulse(m_masterPhase, duration);
 
     // Notify all high-frequency listeners
-    const juce::ScopedLock lock(listenerLock);
-    listeners.call(&Listener::playbackTimerTick);
-    listeners.call(&Listener::animationUpdate, m_breathingPulse);
+    {
+        const juce::ScopedLock lock(listenerLock);
+        listeners.call(&Listener::playbackTimerTick);
+        listeners.call(&Listener::animationUpdate, m_breathingPulse);
+    }
+
+    repaintScheduler.flush();
+
+    const auto nextPace = choosePace(nowMs);
+    if (nextPace != pace)
+        applyPace(nextPace);
+}
+
+void PlaybackTimerManager::changeListenerCallback(juce::ChangeBroadcaster *source) {
+    // The transport started or stopped.
+    if (source == &audioPlayer)
+        wake();
+}
+
+void PlaybackTimerManager::mouseMove(const juce::MouseEvent &) {
+    wake();
+}
+
+void PlaybackTimerManager::mouseDown(const juce::MouseEvent &) {
+    wake();
+}
+
+void PlaybackTimerManager::mouseDrag(const juce::MouseEvent &) {
+    wake();
+}
+
+void PlaybackTimerManager::mouseUp(const juce::MouseEvent &) {
+    wake();
+}
+
+void PlaybackTimerManager::mouseWheelMove(const juce::MouseEvent &,
+                                          const juce::MouseWheelDetails &) {
+    wake();
+}
+
+void PlaybackTimerManager::fileChanged(const juce::String &) {
+    wake();
+}
+
+void PlaybackTimerManager::cutPreferenceChanged(const MainDomain::CutPreferences &) {
+    wake();
 }
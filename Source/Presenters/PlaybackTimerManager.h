@@ -4,28 +4,43 @@
 #if defined(JUCE_HEADLESS)
 #include <juce_core/juce_core.h>
 #include <juce_events/juce_events.h>
+#include <juce_gui_basics/juce_gui_basics.h>
 #else
 #include <JuceHeader.h>
 #endif
 
 #include "Core/AppEnums.h"
+#include "Core/SessionState.h"
+#include "UI/RepaintScheduler.h"
 #include <functional>
+#include <memory>
 
-class SessionState;
 class AudioPlayer;
 class PlaybackRepeatController;
 class InteractionCoordinator;
 
 /**
  * @class PlaybackTimerManager
- * @brief A domain-level utility that manages high-frequency (60Hz) UI heartbeats.
+ * @brief A domain-level utility that manages the UI frame heartbeat.
  *
  * This manager evacuates high-frequency polling from the UI layer. It monitors
- * playback progress and keyboard state, notifying registered listeners at 60Hz.
+ * playback progress and keyboard state, notifying registered listeners once per frame.
+ * Listeners invalidate what they need redrawn through getRepaintScheduler(), which
+ * is flushed once at the end of every tick.
+ *
+ * The frame rate follows what the user is doing (see Pace). While playing, dragging,
+ * zooming or shortly after any input, frames follow the display's vblank once
+ * attachToDisplay() has been called. When idle it drops to a slow timer, and only keeps
+ * a smooth rate if a listener reports that it is animating. Mouse events anywhere in the
+ * app, transport changes and session changes wake it straight back up. Animations are a
+ * function of wall-clock time, so they run at the same speed at any rate.
  *
  * @ingroup Logic
  */
-class PlaybackTimerManager final : public juce::Timer {
+class PlaybackTimerManager final : public juce::Timer,
+                                   private juce::ChangeListener,
+                                   private juce::MouseListener,
+                                   private SessionState::Listener {
   public:
     /**
      * @class Listener
@@ -35,16 +50,31 @@ class PlaybackTimerManager final : public juce::Timer {
       public:
         virtual ~Listener() = default;
 
-        /** @brief Called at a 60Hz frequency to trigger UI updates. */
+        /** @brief Called once per frame to trigger UI updates. */
         virtual void playbackTimerTick() = 0;
 
-        /** @brief Called at a 60Hz frequency to broadcast the master pulse. */
+        /** @brief Called once per frame to broadcast the master pulse. */
         virtual void animationUpdate(float breathingPulse) = 0;
 
         /** @brief Called when the active zoom point changes (e.g., via 'Z' key). */
         virtual void activeZoomPointChanged(AppEnums::ActiveZoomPoint newPoint) {
             juce::ignoreUnused(newPoint);
         }
+
+        /** @brief True while something this listener draws still changes on its own. */
+        virtual bool isAnimating() const {
+            return false;
+        }
+    };
+
+    /** @brief How often frames are produced. */
+    enum class Pace {
+        /** Nothing moves: `Config::Animation::idleFrameRateHz`. */
+        Idle,
+        /** Only pulses move: `Config::Animation::animatingFrameRateHz`. */
+        Animating,
+        /** Playback, drags, zooming or recent input: the display's refresh rate. */
+        Active
     };
 
     /**
@@ -59,6 +89,23 @@ class PlaybackTimerManager final : public juce::Timer {
     /** @brief Destructor. stops the timer. */
     ~PlaybackTimerManager() override;
 
+    /**
+     * @brief Syncs active frames to the vblank of the display `component` is shown on.
+     * @details Without it, active frames come from a timer at
+     *          `Config::Animation::activeFrameRateHz`.
+     */
+    void attachToDisplay(juce::Component &component);
+
+    /** @brief Stops producing frames, e.g. before the listeners are destroyed. */
+    void stop();
+
+    /** @brief Switches to the active rate at once; call on input the manager cannot see. */
+    void wake();
+
+    Pace getPace() const {
+        return pace;
+    }
+
     /** @brief Sets the repeat controller to be ticked by this manager. */
     void setRepeatController(PlaybackRepeatController *controller) {
         m_repeatController = controller;
@@ -90,19 +137,47 @@ class PlaybackTimerManager final : public juce::Timer {
         return m_breathingPulse;
     }
 
+    /** @brief The per-frame repaint queue the views invalidate into. */
+    RepaintScheduler &getRepaintScheduler() {
+        return repaintScheduler;
+    }
+
     /** @brief Internal timer callback. */
     void timerCallback() override;
 
   private:
+    void frame();
+    Pace choosePace(double nowMs) const;
+    void applyPace(Pace newPace);
+
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
+    void mouseMove(const juce::MouseEvent &event) override;
+    void mouseDown(const juce::MouseEvent &event) override;
+    void mouseDrag(const juce::MouseEvent &event) override;
+    void mouseUp(const juce::MouseEvent &event) override;
+    void mouseWheelMove(const juce::MouseEvent &event,
+                        const juce::MouseWheelDetails &wheel) override;
+    void fileChanged(const juce::String &filePath) override;
+    void cutPreferenceChanged(const MainDomain::CutPreferences &prefs) override;
+
     SessionState &sessionState;
     AudioPlayer &audioPlayer;
     InteractionCoordinator &interactionCoordinator;
     PlaybackRepeatController *m_repeatController = nullptr;
     std::function<AppEnums::ActiveZoomPoint()> m_zoomPointProvider;
 
+    RepaintScheduler repaintScheduler;
     juce::ListenerList<Listener> listeners;
     juce::CriticalSection listenerLock;
 
+    juce::Component *display = nullptr;
+    std::unique_ptr<juce::VBlankAttachment> vblank;
+    Pace pace = Pace::Idle;
+    bool stopped = false;
+    const double startMs;
+    double lastFrameMs = 0.0;
+    double lastActivityMs = 0.0;
+
     bool m_isZKeyDown = false;
     float m_masterPhase = 0.0f;
     float m_breathingPulse = 0.0f;
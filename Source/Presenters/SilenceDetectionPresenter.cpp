@@ -3,16 +3,25 @@
 #include "Presenters/SilenceDetectionPresenter.h"
 
 #include "Core/AudioPlayer.h"
+#include "Core/AudioReaderFactory.h"
+#include "Core/FileMetadata.h"
 #include "Core/SessionState.h"
-#include "Core/SilenceAnalysisWorker.h"
 #include "UI/ControlPanel.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
 #include "Workers/SilenceDetector.h"
 
 SilenceDetectionPresenter::SilenceDetectionPresenter(ControlPanel &ownerPanel,
                                                      SessionState &sessionStateIn,
                                                      AudioPlayer &audioPlayerIn)
     : owner(ownerPanel), sessionState(sessionStateIn), audioPlayer(audioPlayerIn),
-      silenceWorker(*this, sessionStateIn) {
+      analysisService(
+          [&audioPlayerIn](const juce::File &file) {
+              return AudioReaderFactory::createReader(audioPlayerIn.getFormatManager(), file);
+          },
+          [&audioPlayerIn](const juce::File &file, const std::function<bool()> &shouldAbort) {
+              // Coalesce onto the load-time decode instead of reading the file again.
+              return audioPlayerIn.waitForEnvelopeIndex(file, shouldAbort);
+          }) {
     sessionState.addListener(this);
     owner.getPlaybackTimerManager().addListener(this);
 
@@ -49,12 +58,20 @@ void SilenceDetectionPresenter::animationUpdate(float breathingPulse) {
     };
 
     updateButton(owner.getAutoCutInButton(), autoCut.inActive,
-                 silenceWorker.isBusy() && silenceWorker.isDetectingIn());
+                 analysisService.isBusy(AnalysisService::Kind::SilenceIn));
     updateButton(owner.getAutoCutOutButton(), autoCut.outActive,
-                 silenceWorker.isBusy() && !silenceWorker.isDetectingIn());
+                 analysisService.isBusy(AnalysisService::Kind::SilenceOut));
+}
+
+bool SilenceDetectionPresenter::isAnimating() const {
+    const auto autoCut = sessionState.getCutPrefs().autoCut;
+    return autoCut.inActive || autoCut.outActive || analysisService.isBusy();
 }
 
 void SilenceDetectionPresenter::fileChanged(const juce::String &filePath) {
+    // Results for the previous file must not land on this one.
+    analysisService.cancelAll();
+
     if (filePath.isEmpty())
         return;
 
@@ -86,9 +103,13 @@ void SilenceDetectionPresenter::cutPreferenceChanged(const MainDomain::CutPrefer
 
     if (shouldAnalyzeIn)
         startSilenceAnalysis(autoCut.thresholdIn, true);
+    else if (!autoCut.inActive)
+        analysisService.cancel(AnalysisService::Kind::SilenceIn);
 
     if (shouldAnalyzeOut)
         startSilenceAnalysis(autoCut.thresholdOut, false);
+    else if (!autoCut.outActive)
+        analysisService.cancel(AnalysisService::Kind::SilenceOut);
 
     lastAutoCutThresholdIn = autoCut.thresholdIn;
     lastAutoCutThresholdOut = autoCut.thresholdOut;
@@ -105,16 +126,63 @@ void SilenceDetectionPresenter::handleAutoCutOutToggle(bool isActive) {
 }
 
 void SilenceDetectionPresenter::startSilenceAnalysis(float threshold, bool detectingIn) {
-    if (silenceWorker.isBusy()) {
-        // If it's busy with the same thing, ignore.
-        if (silenceWorker.isDetectingIn() == detectingIn)
-            return;
+    const juce::File file = audioPlayer.getLoadedFile();
+    if (file == juce::File())
+        return;
 
-        // If it's busy with the OTHER thing, we might want to queue it or just wait.
-        // For now, let's at least log it.
+    const auto kind =
+        detectingIn ? AnalysisService::Kind::SilenceIn : AnalysisService::Kind::SilenceOut;
+    analysisService.submit({file, kind, threshold}, [this](const AnalysisService::Result &result) {
+        applySilenceResult(result);
+    });
+}
+
+void SilenceDetectionPresenter::applySilenceResult(const AnalysisService::Result &result) {
+    if (!result.readerOpened) {
+        logStatusMessage("No audio loaded.", true);
+        return;
+    }
+    if (result.lengthInSamples <= 0) {
+        logStatusMessage("Error: Audio file has zero length.", true);
         return;
     }
-    silenceWorker.startAnalysis(threshold, detectingIn);
+
+    const bool detectingIn = result.request.kind == AnalysisService::Kind::SilenceIn;
+    const bool stillActive = detectingIn ? isAutoCutInActive() : isAutoCutOutActive();
+    const juce::String filePath = result.request.file.getFullPathName();
+
+    FileMetadata metadata = sessionState.getMetadataForFile(filePath);
+    if (result.sample != -1) {
+        if (detectingIn) {
+            const double resultSeconds = (double)result.sample / result.sampleRate;
+            if (stillActive) {
+                metadata.cutIn = resultSeconds;
+                setCutStart((int)result.sample);
+                logStatusMessage(juce::String("Silence Boundary (Start) set to sample ") +
+                                 juce::String(result.sample));
+
+                if (isCutModeActive())
+                    audioPlayer.setPlayheadPosition(resultSeconds);
+            }
+        } else {
+            const juce::int64 finalEndPoint = SilenceAnalysisAlgorithms::cutOutWithTail(
+                result.sample, result.sampleRate, result.lengthInSamples);
+
+            if (stillActive) {
+                metadata.cutOut = (double)finalEndPoint / result.sampleRate;
+                setCutEnd((int)finalEndPoint);
+                logStatusMessage(juce::String("Silence Boundary (End) set to sample ") +
+                                 juce::String(finalEndPoint));
+            }
+        }
+    } else {
+        logStatusMessage("No Silence Boundaries detected.");
+    }
+
+    if (stillActive) {
+        metadata.isAnalyzed = true;
+        sessionState.setMetadataForFile(filePath, metadata);
+    }
 }
 
 AudioPlayer &SilenceDetectionPresenter::getAudioPlayer() {
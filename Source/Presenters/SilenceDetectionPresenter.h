@@ -9,8 +9,8 @@
 #include <JuceHeader.h>
 #endif
 
+#include "Core/AnalysisService.h"
 #include "Core/SessionState.h"
-#include "Core/SilenceAnalysisWorker.h"
 #include "Presenters/PlaybackTimerManager.h"
 #include "Workers/SilenceWorkerClient.h"
 
@@ -26,12 +26,15 @@ class SilenceDetectionPresenter final : public SilenceWorkerClient,
                               AudioPlayer &audioPlayer);
     ~SilenceDetectionPresenter() override;
 
-    /** @brief Called when the playback timer ticks at 60Hz. */
+    /** @brief Called on every frame of the playback timer. */
     void playbackTimerTick() override;
 
     /** @brief Updates the UI animation state based on the master pulse. */
     void animationUpdate(float breathingPulse) override;
 
+    /** @brief True while an auto-cut button pulses (auto-cut on or analysis running). */
+    bool isAnimating() const override;
+
     /** @brief Triggered when the current file in SessionState changes. */
     void fileChanged(const juce::String &filePath) override;
 
@@ -44,12 +47,16 @@ class SilenceDetectionPresenter final : public SilenceWorkerClient,
     /** @brief Toggles the auto-cut-out feature in SessionState. */
     void handleAutoCutOutToggle(bool isActive);
 
-    /** @brief Manually triggers silence analysis with the specified threshold. */
+    /**
+     * @brief Queues a silence analysis of the loaded file with the specified threshold.
+     * @details In and Out requests run concurrently; a new threshold supersedes the pending
+     *          request of the same direction.
+     */
     void startSilenceAnalysis(float threshold, bool detectingIn);
 
-    /** @brief Returns true if a silence analysis task is currently running. */
+    /** @brief Returns true if a silence analysis task is pending or running. */
     bool isAnalyzing() const {
-        return silenceWorker.isBusy();
+        return analysisService.isBusy();
     }
 
     /** @brief Provides access to the audio engine for analysis workers. */
@@ -76,10 +83,13 @@ class SilenceDetectionPresenter final : public SilenceWorkerClient,
   private:
     bool hasLoadedAudio() const;
 
+    /** Applies a finished analysis to the file it was requested for. */
+    void applySilenceResult(const AnalysisService::Result &result);
+
     ControlPanel &owner;
     SessionState &sessionState;
     AudioPlayer &audioPlayer;
-    SilenceAnalysisWorker silenceWorker;
+    AnalysisService analysisService;
 
     float lastAutoCutThresholdIn{-1.0f};
     float lastAutoCutThresholdOut{-1.0f};
@@ -79,20 +79,42 @@ juce::String StatsPresenter::buildStatsString() const {
         stats << "Channels: " << thumbnail.getNumChannels() << "\n";
         stats << "Length: " << owner.formatTime(thumbnail.getTotalLength()) << "\n";
 
-        float minVal = 0.0f;
-        float maxVal = 0.0f;
-        thumbnail.getApproximateMinMax(0.0, thumbnail.getTotalLength(), 0, minVal, maxVal);
-        stats << "Approx Peak (Ch 0): " << juce::jmax(std::abs(minVal), std::abs(maxVal)) << "\n";
-        stats << "Min: " << minVal << ", Max: " << maxVal << "\n";
-
-        if (thumbnail.getNumChannels() > 1) {
-            thumbnail.getApproximateMinMax(0.0, thumbnail.getTotalLength(), 1, minVal, maxVal);
-            stats << "Approx Peak (Ch 1): " << juce::jmax(std::abs(minVal), std::abs(maxVal))
-                  << "\n";
-            stats << "Min: " << minVal << ", Max: " << maxVal << "\n";
+        if (auto envelope = audioPlayer.getEnvelopeIndex()) {
+            for (int channel = 0; channel < envelope->getNumChannels(); ++channel) {
+                const auto range = envelope->getMinMax(channel, 0, lengthInSamples);
+                stats << "Peak (Ch " << channel << "): "
+                      << juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()))
+                      << ", RMS: " << envelope->getRms(channel, 0, lengthInSamples) << "\n";
+                stats << "Min: " << range.getStart() << ", Max: " << range.getEnd() << "\n";
+            }
+        } else if (auto lod = audioPlayer.getWaveformManager().getLod()) {
+            for (int channel = 0; channel < juce::jmin(2, lod->getNumChannels()); ++channel) {
+                const auto range = lod->getMinMax(channel, 0, lengthInSamples);
+                stats << "Approx Peak (Ch " << channel << "): "
+                      << juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd())) << "\n";
+                stats << "Min: " << range.getStart() << ", Max: " << range.getEnd() << "\n";
+            }
         }
     } else {
-        stats << "No file loaded or error reading audio.";
+        stats << "No file loaded or error reading audio.\n";
+    }
+
+    auto &timerManager = owner.getPlaybackTimerManager();
+    const auto frames = timerManager.getRepaintScheduler().getStats();
+    stats << "Frames: " << frames.framesPainted << " painted, " << frames.framesSkipped
+          << " skipped\n";
+    stats << "Paint: " << juce::String(frames.averagePaintMs, 2) << " ms avg, "
+          << juce::String(frames.lastPaintMs, 2) << " ms last\n";
+    switch (timerManager.getPace()) {
+    case PlaybackTimerManager::Pace::Active:
+        stats << "Frame Rate: display refresh (active)";
+        break;
+    case PlaybackTimerManager::Pace::Animating:
+        stats << "Frame Rate: " << Config::Animation::animatingFrameRateHz << " Hz";
+        break;
+    case PlaybackTimerManager::Pace::Idle:
+        stats << "Frame Rate: " << Config::Animation::idleFrameRateHz << " Hz (idle)";
+        break;
     }
 
     return stats;
@@ -148,11 +148,13 @@ void ControlPanel::setupListeners() {
 
     inStrip->setPresenter(boundaryLogicPresenter.get());
     outStrip->setPresenter(boundaryLogicPresenter.get());
+
+    playbackTimerManager->attachToDisplay(*this);
 }
 
 ControlPanel::~ControlPanel() {
     if (playbackTimerManager != nullptr) {
-        playbackTimerManager->stopTimer();
+        playbackTimerManager->stop();
     }
 
     sessionState.removeListener(this);
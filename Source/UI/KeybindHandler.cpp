@@ -39,6 +39,14 @@ bool KeybindHandler::handleGlobalKeybinds(const juce::KeyPress &key) {
         mainComponent.openButtonClicked();
         return true;
     }
+    if (keyChar == 'n' || keyChar == 'N') {
+        mainComponent.nextFileClicked();
+        return true;
+    }
+    if (keyChar == 'b' || keyChar == 'B') {
+        mainComponent.previousFileClicked();
+        return true;
+    }
     return false;
 }
 
@@ -102,6 +110,10 @@ bool KeybindHandler::handleCutKeybinds(const juce::KeyPress &key) {
             return true;
         }
     }
+    if (keyChar == 'w' || keyChar == 'W') {
+        mainComponent.exportRegionClicked();
+        return true;
+    }
     if (keyChar == 'u' || keyChar == 'U') {
         controlPanel.resetIn();
         return true;
@@ -46,7 +46,8 @@ void MouseHandler::mouseMove(const juce::MouseEvent &event) {
         isScrubbingState = false;
         hoveredHandle = CutMarkerHandle::None;
     }
-    owner.repaint();
+    // No repaint: the views compare the hover state on the next frame and invalidate only what
+    // changed through the RepaintScheduler.
 }
 
 void MouseHandler::mouseDown(const juce::MouseEvent &event) {
@@ -274,7 +275,6 @@ void MouseHandler::mouseExit(const juce::MouseEvent &) {
     mouseCursorTime = 0.0;
     isScrubbingState = false;
     hoveredHandle = CutMarkerHandle::None;
-    owner.repaint();
 }
 
 void MouseHandler::mouseWheelMove(const juce::MouseEvent &event,
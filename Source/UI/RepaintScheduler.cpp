@@ -0,0 +1,86 @@
+#include "UI/RepaintScheduler.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+
+RepaintScheduler::ScopedPaintTimer::ScopedPaintTimer(RepaintScheduler &schedulerIn)
+    : scheduler(schedulerIn), startMs(juce::Time::getMillisecondCounterHiRes()) {
+}
+
+RepaintScheduler::ScopedPaintTimer::~ScopedPaintTimer() {
+    scheduler.paintMsThisFrame += juce::Time::getMillisecondCounterHiRes() - startMs;
+}
+
+void RepaintScheduler::invalidate(juce::Component &component, juce::Rectangle<int> area) {
+    const auto clipped = area.getIntersection(component.getLocalBounds());
+    if (!clipped.isEmpty())
+        areaFor(component).add(clipped);
+}
+
+void RepaintScheduler::invalidate(juce::Component &component,
+                                  const juce::RectangleList<int> &area) {
+    for (const auto &rect : area)
+        invalidate(component, rect);
+}
+
+void RepaintScheduler::invalidateAll(juce::Component &component) {
+    auto &area = areaFor(component);
+    area.clear();
+    area.add(component.getLocalBounds());
+}
+
+juce::RectangleList<int> &RepaintScheduler::areaFor(juce::Component &component) {
+    const auto existing = std::find_if(entries.begin(), entries.end(), [&](const Entry &entry) {
+        return entry.component.getComponent() == &component;
+    });
+    if (existing != entries.end())
+        return existing->area;
+
+    entries.push_back({&component, {}});
+    return entries.back().area;
+}
+
+void RepaintScheduler::flush() {
+    bool painted = false;
+
+    for (auto &entry : entries) {
+        auto *component = entry.component.getComponent();
+        if (component == nullptr || entry.area.isEmpty())
+            continue;
+
+        entry.area.consolidate();
+        if (entry.area.getNumRectangles() > Config::Layout::Repaint::maxRectsPerView) {
+            component->repaint(entry.area.getBounds());
+            ++stats.rectsRepainted;
+        } else {
+            for (const auto &rect : entry.area)
+                component->repaint(rect);
+            stats.rectsRepainted += entry.area.getNumRectangles();
+        }
+
+        entry.area.clear();
+        painted = true;
+    }
+
+    // Forget views that have been deleted.
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const Entry &entry) { return entry.component == nullptr; }),
+                  entries.end());
+
+    // JUCE paints after the repaints that ask for it, so this is the cost of earlier frames.
+    if (paintMsThisFrame > 0.0) {
+        const double weight = Config::Layout::Repaint::paintCostSmoothing;
+        stats.lastPaintMs = paintMsThisFrame;
+        stats.averagePaintMs = stats.averagePaintMs * (1.0 - weight) + paintMsThisFrame * weight;
+        paintMsThisFrame = 0.0;
+    }
+
+    if (painted)
+        ++stats.framesPainted;
+    else
+        ++stats.framesSkipped;
+}
+
+RepaintScheduler::Stats RepaintScheduler::getStats() const {
+    return stats;
+}
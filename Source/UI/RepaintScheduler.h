@@ -0,0 +1,83 @@
+#ifndef AUDIOFILER_REPAINTSCHEDULER_H
+#define AUDIOFILER_REPAINTSCHEDULER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <vector>
+
+/**
+ * @file RepaintScheduler.h
+ * @ingroup UI
+ * @brief Collects dirty rectangles from the views and repaints them once per frame.
+ * @details Views report what changed with invalidate() instead of calling `repaint()` on
+ *          themselves. The PlaybackTimerManager calls flush() at the end of every tick, which
+ *          merges each view's rectangles and hands them to JUCE in one go; a frame in which
+ *          nothing was invalidated costs nothing. Views that time their `paint()` with a
+ *          ScopedPaintTimer feed the frame cost shown by the StatsPresenter.
+ *
+ *          Components are held through `SafePointer`, so a view may be destroyed with
+ *          rectangles still pending. Message thread only.
+ *
+ * @see PlaybackTimerManager
+ */
+class RepaintScheduler {
+  public:
+    struct Stats {
+        juce::int64 framesPainted{0};
+        juce::int64 framesSkipped{0};
+        juce::int64 rectsRepainted{0};
+        /** Time spent in timed `paint()` calls between the last two flushes that saw any. */
+        double lastPaintMs{0.0};
+        double averagePaintMs{0.0};
+    };
+
+    /** @brief Adds the lifetime of its scope to the cost of the current frame. */
+    class ScopedPaintTimer {
+      public:
+        explicit ScopedPaintTimer(RepaintScheduler &scheduler);
+        ~ScopedPaintTimer();
+
+      private:
+        RepaintScheduler &scheduler;
+        double startMs;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedPaintTimer)
+    };
+
+    RepaintScheduler() = default;
+
+    /** @brief Marks `area`, in the component's own coordinates, for the next frame. */
+    void invalidate(juce::Component &component, juce::Rectangle<int> area);
+
+    /** @brief Marks every rectangle of `area` for the next frame. */
+    void invalidate(juce::Component &component, const juce::RectangleList<int> &area);
+
+    /** @brief Marks the whole component for the next frame. */
+    void invalidateAll(juce::Component &component);
+
+    /** @brief Repaints everything invalidated since the previous call. */
+    void flush();
+
+    Stats getStats() const;
+
+  private:
+    struct Entry {
+        juce::Component::SafePointer<juce::Component> component;
+        juce::RectangleList<int> area;
+    };
+
+    juce::RectangleList<int> &areaFor(juce::Component &component);
+
+    std::vector<Entry> entries;
+    Stats stats;
+    double paintMsThisFrame{0.0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RepaintScheduler)
+};
+
+#endif
@@ -30,14 +30,51 @@ CutLayerView::~CutLayerView() {
 }
 
 void CutLayerView::changeListenerCallback(juce::ChangeBroadcaster *source) {
-    if (source == &waveformManager.getThumbnail())
+    if (source == &waveformManager)
 
         repaint();
 }
 
+bool CutLayerView::DrawState::operator==(const DrawState &other) const {
+    return cutIn == other.cutIn && cutOut == other.cutOut && thresholdIn == other.thresholdIn &&
+           thresholdOut == other.thresholdOut && autoCutIn == other.autoCutIn &&
+           autoCutOut == other.autoCutOut && eyeCandy == other.eyeCandy &&
+           placementMode == other.placementMode && hovered == other.hovered &&
+           dragged == other.dragged;
+}
+
+CutLayerView::DrawState CutLayerView::captureDrawState() const {
+    DrawState state;
+    state.cutIn = sessionState.getCutIn();
+    state.cutOut = sessionState.getCutOut();
+    state.thresholdIn = silenceDetector.getCurrentInSilenceThreshold();
+    state.thresholdOut = silenceDetector.getCurrentOutSilenceThreshold();
+    state.autoCutIn = silenceDetector.getIsAutoCutInActive();
+    state.autoCutOut = silenceDetector.getIsAutoCutOutActive();
+    state.eyeCandy = interactionCoordinator.shouldShowEyeCandy();
+    state.placementMode = interactionCoordinator.getPlacementMode();
+    if (mouseHandler != nullptr) {
+        state.hovered = mouseHandler->getHoveredHandle();
+        state.dragged = mouseHandler->getDraggedHandle();
+    }
+    return state;
+}
+
 void CutLayerView::animationUpdate(float breathingPulse) {
     juce::ignoreUnused(breathingPulse);
-    repaint();
+    if (!markersVisible)
+        return;
+
+    auto &scheduler = owner.getPlaybackTimerManager().getRepaintScheduler();
+    const DrawState state = captureDrawState();
+    if (!(state == lastDrawState)) {
+        lastDrawState = state;
+        scheduler.invalidateAll(*this);
+        return;
+    }
+
+    // With nothing else changed, only the pulsing glows differ from the previous frame.
+    scheduler.invalidate(*this, pulseArea);
 }
 
 void CutLayerView::setChannelMode(AppEnums::ChannelViewMode mode) {
@@ -49,9 +86,16 @@ void CutLayerView::setChannelMode(AppEnums::ChannelViewMode mode) {
 }
 
 void CutLayerView::paint(juce::Graphics &g) {
+    const RepaintScheduler::ScopedPaintTimer paintTimer(
+        owner.getPlaybackTimerManager().getRepaintScheduler());
+    pulseArea.clear();
     if (!markersVisible)
         return;
 
+    const auto addPulseArea = [this](juce::Rectangle<float> area, float margin) {
+        pulseArea.add(area.expanded(margin).getSmallestIntegerContainer());
+    };
+
     const auto bounds = getLocalBounds();
     const float audioLength = (float)waveformManager.getThumbnail().getTotalLength();
     if (audioLength <= 0.0f)
@@ -91,8 +135,14 @@ void CutLayerView::paint(juce::Graphics &g) {
             g.setColour(glowColor);
 
             // Draw a wider rectangle behind the line for a glow effect
-            g.fillRect(lineStartX, topThresholdY - 2.5f, currentLineWidth, 5.0f);
-            g.fillRect(lineStartX, bottomThresholdY - 2.5f, currentLineWidth, 5.0f);
+            const juce::Rectangle<float> topGlow(lineStartX, topThresholdY - 2.5f,
+                                                 currentLineWidth, 5.0f);
+            const juce::Rectangle<float> bottomGlow(lineStartX, bottomThresholdY - 2.5f,
+                                                    currentLineWidth, 5.0f);
+            g.fillRect(topGlow);
+            g.fillRect(bottomGlow);
+            addPulseArea(topGlow, 1.0f);
+            addPulseArea(bottomGlow, 1.0f);
         }
 
         g.setColour(Config::Colors::thresholdLine);
@@ -200,11 +250,14 @@ void CutLayerView::paint(juce::Graphics &g) {
             const juce::Colour glowColor = Config::Colors::cutLine.withAlpha(
                 Config::Colors::cutLine.getFloatAlpha() * (0.2f + 0.8f * pulse));
             g.setColour(glowColor);
-            g.fillRect(x - (Config::Layout::Glow::cutLineGlowThickness *
-                                Config::Layout::Glow::offsetFactor -
-                            0.5f),
-                       (float)bounds.getY() + boxHeight, Config::Layout::Glow::cutLineGlowThickness,
-                       (float)bounds.getHeight() - (2.0f * boxHeight));
+            const juce::Rectangle<float> glow(
+                x - (Config::Layout::Glow::cutLineGlowThickness *
+                         Config::Layout::Glow::offsetFactor -
+                     0.5f),
+                (float)bounds.getY() + boxHeight, Config::Layout::Glow::cutLineGlowThickness,
+                (float)bounds.getHeight() - (2.0f * boxHeight));
+            g.fillRect(glow);
+            addPulseArea(glow, 1.0f);
         } else {
             g.setColour(Config::Colors::cutLine.withAlpha(0.3f));
             g.fillRect(x - 0.5f, (float)bounds.getY() + boxHeight, 1.0f,
@@ -246,7 +299,8 @@ void CutLayerView::paint(juce::Graphics &g) {
         }
     }
 
-    if (regionActive && interactionCoordinator.shouldShowEyeCandy())
+    const bool regionPulses = regionActive && interactionCoordinator.shouldShowEyeCandy();
+    if (regionPulses)
         g.setColour(hollowColor.withAlpha(0.5f + 0.5f * glowAlphaProvider()));
     else
         g.setColour(hollowColor.withAlpha(0.4f));
@@ -255,6 +309,12 @@ void CutLayerView::paint(juce::Graphics &g) {
     const float startX = inX + halfBoxWidth;
     const float endX = outX - halfBoxWidth;
 
+    if (regionPulses && startX < endX) {
+        addPulseArea({startX, (float)bounds.getY(), endX - startX, boxHeight}, hollowThickness);
+        addPulseArea({startX, (float)bounds.getBottom() - boxHeight, endX - startX, boxHeight},
+                     hollowThickness);
+    }
+
     if (startX < endX) {
         g.drawLine(startX, (float)bounds.getY(), endX, (float)bounds.getY(), hollowThickness);
         g.drawLine(startX, (float)bounds.getY() + boxHeight, endX, (float)bounds.getY() + boxHeight,
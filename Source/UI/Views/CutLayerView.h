@@ -14,13 +14,12 @@
 #include "Utils/Config.h"
 
 #include "UI/InteractionCoordinator.h"
+#include "UI/MouseHandler.h"
 
 class SessionState;
 
 class SilenceDetector;
 
-class MouseHandler;
-
 class WaveformManager;
 
 class ControlPanel;
@@ -53,8 +52,29 @@ class CutLayerView : public juce::Component,
     void playbackTimerTick() override {
     }
     void animationUpdate(float breathingPulse) override;
+    bool isAnimating() const override {
+        return !pulseArea.isEmpty();
+    }
 
   private:
+    /** Everything outside this view that its drawing depends on, compared once per frame. */
+    struct DrawState {
+        double cutIn{0.0};
+        double cutOut{0.0};
+        float thresholdIn{0.0f};
+        float thresholdOut{0.0f};
+        bool autoCutIn{false};
+        bool autoCutOut{false};
+        bool eyeCandy{false};
+        AppEnums::PlacementMode placementMode{AppEnums::PlacementMode::None};
+        MouseHandler::CutMarkerHandle hovered{MouseHandler::CutMarkerHandle::None};
+        MouseHandler::CutMarkerHandle dragged{MouseHandler::CutMarkerHandle::None};
+
+        bool operator==(const DrawState &other) const;
+    };
+
+    DrawState captureDrawState() const;
+
     ControlPanel &owner;
     SessionState &sessionState;
     SilenceDetector &silenceDetector;
@@ -63,6 +83,9 @@ class CutLayerView : public juce::Component,
     WaveformManager &waveformManager;
     std::function<float()> glowAlphaProvider;
     bool markersVisible = false;
+    DrawState lastDrawState;
+    /** What the last paint drew with the breathing pulse, so only that is redrawn per frame. */
+    juce::RectangleList<int> pulseArea;
 
     AppEnums::ChannelViewMode currentChannelMode = AppEnums::ChannelViewMode::Mono;
 
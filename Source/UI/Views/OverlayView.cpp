@@ -16,11 +16,15 @@ OverlayView::~OverlayView() {
 
 void OverlayView::animationUpdate(float breathingPulse) {
     juce::ignoreUnused(breathingPulse);
-    if (owner.getInteractionCoordinator().shouldShowEyeCandy())
-        repaint();
+    // Also runs once after eye candy is switched off, so the last glow is cleared.
+    owner.getPlaybackTimerManager().getRepaintScheduler().invalidate(*this, pulseArea);
 }
 
 void OverlayView::paint(juce::Graphics &g) {
+    const RepaintScheduler::ScopedPaintTimer paintTimer(
+        owner.getPlaybackTimerManager().getRepaintScheduler());
+    pulseArea.clear();
+
     auto &coordinator = owner.getInteractionCoordinator();
     if (!coordinator.shouldShowEyeCandy())
         return;
@@ -68,9 +72,14 @@ void OverlayView::paint(juce::Graphics &g) {
         float btnCenterX = (float)btnBounds.getCentreX();
         float btnBottomY = (float)btnBounds.getBottom();
 
+        const juce::Line<float> line(
+            btnCenterX, btnBottomY, x,
+            toTop ? (float)waveformBounds.getY() : (float)waveformBounds.getBottom());
         g.setColour(blueColor);
-        g.drawLine(btnCenterX, btnBottomY, x,
-                   toTop ? (float)waveformBounds.getY() : (float)waveformBounds.getBottom(), 2.0f);
+        g.drawLine(line, 2.0f);
+        pulseArea.add(juce::Rectangle<float>(line.getStart(), line.getEnd())
+                          .expanded(2.0f)
+                          .getSmallestIntegerContainer());
     };
 
     auto *inStrip = owner.getInStrip();
@@ -107,6 +116,12 @@ void OverlayView::paint(juce::Graphics &g) {
         if (!first) {
             g.setColour(blueColor);
             g.drawRect(groupBounds.expanded(3).toFloat(), 2.0f);
+            // Only the outline is drawn, so only its four edges need redrawing.
+            const auto outline = groupBounds.expanded(4);
+            pulseArea.add(outline.withHeight(3));
+            pulseArea.add(outline.withTop(outline.getBottom() - 3));
+            pulseArea.add(outline.withWidth(3));
+            pulseArea.add(outline.withLeft(outline.getRight() - 3));
         }
     };
 
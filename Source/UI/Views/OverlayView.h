@@ -28,9 +28,14 @@ class OverlayView : public juce::Component, public PlaybackTimerManager::Listene
     void playbackTimerTick() override {
     }
     void animationUpdate(float breathingPulse) override;
+    bool isAnimating() const override {
+        return !pulseArea.isEmpty();
+    }
 
   private:
     ControlPanel &owner;
+    /** Everything the last paint drew; all of it pulses, so this is redrawn each frame. */
+    juce::RectangleList<int> pulseArea;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OverlayView)
 };
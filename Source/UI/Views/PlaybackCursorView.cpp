@@ -28,11 +28,13 @@ void PlaybackCursorView::playbackTimerTick() {
         const int currentX = juce::roundToInt(x);
 
         if (currentX != lastCursorX) {
+            auto &scheduler = owner.getPlaybackTimerManager().getRepaintScheduler();
             const int glowWidth = juce::roundToInt(Config::Layout::Glow::thickness) + 1;
             if (lastCursorX >= 0)
-                repaint(lastCursorX - glowWidth, 0, glowWidth * 2, getHeight());
+                scheduler.invalidate(*this, {lastCursorX - glowWidth, 0, glowWidth * 2,
+                                             getHeight()});
 
-            repaint(currentX - glowWidth, 0, glowWidth * 2, getHeight());
+            scheduler.invalidate(*this, {currentX - glowWidth, 0, glowWidth * 2, getHeight()});
 
             lastCursorX = currentX;
         }
@@ -54,12 +56,20 @@ void PlaybackCursorView::playbackTimerTick() {
 
 void PlaybackCursorView::animationUpdate(float breathingPulse) {
     juce::ignoreUnused(breathingPulse);
-    if (lastCursorX >= 0)
-        repaint(lastCursorX - Config::Layout::Glow::glowRadius, 0,
-                Config::Layout::Glow::glowRadius * 2, getHeight());
+    // The cursor only pulses with eye candy on; otherwise it changes only when it moves.
+    if (isAnimating())
+        owner.getPlaybackTimerManager().getRepaintScheduler().invalidate(
+            *this, {lastCursorX - Config::Layout::Glow::glowRadius, 0,
+                    Config::Layout::Glow::glowRadius * 2, getHeight()});
+}
+
+bool PlaybackCursorView::isAnimating() const {
+    return lastCursorX >= 0 && owner.getInteractionCoordinator().shouldShowEyeCandy();
 }
 
 void PlaybackCursorView::paint(juce::Graphics &g) {
+    const RepaintScheduler::ScopedPaintTimer paintTimer(
+        owner.getPlaybackTimerManager().getRepaintScheduler());
     auto &audioPlayer = owner.getAudioPlayer();
     const double audioLength = audioPlayer.getWaveformManager().getThumbnail().getTotalLength();
     if (audioLength <= 0.0)
@@ -22,6 +22,7 @@ class PlaybackCursorView : public juce::Component, public PlaybackTimerManager::
 
     void playbackTimerTick() override;
     void animationUpdate(float breathingPulse) override;
+    bool isAnimating() const override;
 
   private:
     ControlPanel &owner;
@@ -0,0 +1,146 @@
+#include "UI/Views/WaveformRenderer.h"
+#include "Core/WaveformManager.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+#include <cmath>
+
+void WaveformRenderer::drawChannel(juce::Graphics &g, const WaveformManager &waveformManager,
+                                   juce::Rectangle<int> bounds, double startTime,
+                                   double endTime, int channel) {
+    const auto lod = waveformManager.getLod();
+    if (lod == nullptr || bounds.isEmpty() || endTime <= startTime || lod->getSampleRate() <= 0.0)
+        return;
+
+    const int numColumns = bounds.getWidth();
+    const double startSample = startTime * lod->getSampleRate();
+    const double samplesPerColumn = (endTime - startTime) * lod->getSampleRate() / numColumns;
+
+    if ((size_t)numColumns > columnMins.size()) {
+        columnMins.resize((size_t)numColumns);
+        columnMaxs.resize((size_t)numColumns);
+    }
+
+    // Samples are read in the background; until they arrive the pyramid stands in for them.
+    std::shared_ptr<const WaveformManager::DetailBlock> detail;
+    const auto firstSample = (juce::int64)std::floor(startSample);
+    const int numSamples = (int)std::ceil(samplesPerColumn * numColumns) + 2;
+    if (samplesPerColumn < (double)lod->getBaseBlockSize())
+        detail = waveformManager.getDetail(firstSample, numSamples);
+
+    if (detail != nullptr) {
+        if (!copySamples(*detail, channel, firstSample, numSamples))
+            return;
+
+        const double offset = startSample - (double)firstSample;
+        if (samplesPerColumn < 1.0) {
+            strokeSamples(g, bounds, offset, samplesPerColumn, numSamples);
+            return;
+        }
+        columnsFromSamples(offset, samplesPerColumn, numColumns);
+    } else {
+        lod->getColumns(channel, startSample, samplesPerColumn, numColumns, columnMins.data(),
+                        columnMaxs.data());
+    }
+
+    fillColumns(g, bounds, numColumns);
+}
+
+void WaveformRenderer::drawChannels(juce::Graphics &g, const WaveformManager &waveformManager,
+                                    juce::Rectangle<int> bounds, double startTime,
+                                    double endTime) {
+    const auto lod = waveformManager.getLod();
+    if (lod == nullptr || lod->getNumChannels() <= 0)
+        return;
+
+    const int numChannels = lod->getNumChannels();
+    for (int channel = 0; channel < numChannels; ++channel) {
+        const int top = bounds.getY() + bounds.getHeight() * channel / numChannels;
+        const int bottom = bounds.getY() + bounds.getHeight() * (channel + 1) / numChannels;
+        drawChannel(g, waveformManager, bounds.withTop(top).withBottom(bottom), startTime,
+                    endTime, channel);
+    }
+}
+
+bool WaveformRenderer::copySamples(const WaveformManager::DetailBlock &detail, int channel,
+                                   juce::int64 firstSample, int numSamples) {
+    if (channel < 0 || channel >= detail.samples.getNumChannels())
+        return false;
+
+    if ((size_t)numSamples > samples.size())
+        samples.resize((size_t)numSamples);
+
+    // Whatever lies outside the file, and so outside the block, is silence.
+    const juce::Range<juce::int64> wanted(firstSample, firstSample + numSamples);
+    const auto held = wanted.getIntersectionWith(
+        {detail.firstSample, detail.firstSample + detail.samples.getNumSamples()});
+    std::fill(samples.begin(), samples.begin() + numSamples, 0.0f);
+    if (!held.isEmpty())
+        std::copy_n(detail.samples.getReadPointer(channel,
+                                                  (int)(held.getStart() - detail.firstSample)),
+                    (size_t)held.getLength(),
+                    samples.begin() + (held.getStart() - firstSample));
+    return true;
+}
+
+void WaveformRenderer::columnsFromSamples(double offset, double samplesPerColumn,
+                                          int numColumns) {
+    const int numSamples = (int)std::ceil(samplesPerColumn * numColumns) + 2;
+
+    for (int column = 0; column < numColumns; ++column) {
+        const double columnStart = offset + samplesPerColumn * column;
+        const int begin = juce::jlimit(0, numSamples, (int)std::floor(columnStart));
+        const int end = juce::jlimit(
+            begin, numSamples,
+            juce::jmax(begin + 1, (int)std::ceil(columnStart + samplesPerColumn)));
+
+        const auto range = end > begin ? juce::FloatVectorOperations::findMinAndMax(
+                                             samples.data() + begin, end - begin)
+                                       : juce::Range<float>();
+        columnMins[(size_t)column] = range.getStart();
+        columnMaxs[(size_t)column] = range.getEnd();
+    }
+}
+
+void WaveformRenderer::fillColumns(juce::Graphics &g, juce::Rectangle<int> bounds,
+                                   int numColumns) {
+    const auto area = bounds.toFloat();
+    const float centreY = area.getCentreY();
+    const float halfHeight = area.getHeight() * 0.5f;
+
+    bars.clear();
+    for (int column = 0; column < numColumns; ++column) {
+        const float top =
+            juce::jlimit(area.getY(), area.getBottom(),
+                         centreY - columnMaxs[(size_t)column] * halfHeight);
+        const float bottom =
+            juce::jlimit(top, area.getBottom(), centreY - columnMins[(size_t)column] * halfHeight);
+        // Flat stretches still get a one-pixel line, as silence does in a thumbnail.
+        bars.addWithoutMerging({area.getX() + (float)column, top, 1.0f,
+                                juce::jmax(1.0f, bottom - top)});
+    }
+
+    g.fillRectList(bars);
+}
+
+void WaveformRenderer::strokeSamples(juce::Graphics &g, juce::Rectangle<int> bounds,
+                                     double offset, double samplesPerColumn, int numSamples) {
+    const auto area = bounds.toFloat();
+    const float centreY = area.getCentreY();
+    const float halfHeight = area.getHeight() * 0.5f;
+
+    trace.clear();
+    for (int index = 0; index < numSamples; ++index) {
+        const float x = area.getX() + (float)(((double)index - offset) / samplesPerColumn);
+        const float y = centreY - samples[(size_t)index] * halfHeight;
+        if (index == 0)
+            trace.startNewSubPath(x, y);
+        else
+            trace.lineTo(x, y);
+    }
+
+    g.saveState();
+    g.reduceClipRegion(bounds);
+    g.strokePath(trace, juce::PathStrokeType(Config::Layout::Waveform::traceThickness));
+    g.restoreState();
+}
@@ -0,0 +1,60 @@
+#ifndef AUDIOFILER_WAVEFORMRENDERER_H
+#define AUDIOFILER_WAVEFORMRENDERER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_graphics/juce_graphics.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/WaveformManager.h"
+#include <vector>
+
+/**
+ * @file WaveformRenderer.h
+ * @ingroup UI
+ * @brief Draws the loaded waveform for any time range at any zoom.
+ * @details Each pixel column is reduced to one min/max bar, taken from the WaveformLod level
+ *          that best fits the column's width, and all bars of a channel go out in a single
+ *          `fillRectList` call. Zoomed in past the pyramid's base block, the bars come from the
+ *          file's own samples instead, and past one sample per pixel the samples are joined as
+ *          a line, so the view stays sharp all the way down. Those samples are read in the
+ *          background by the WaveformManager; a paint never touches the file.
+ *
+ *          Scratch buffers are kept between paints, so steady repaints do not allocate. A full
+ *          amplitude of ±1 spans the whole height of the bounds. Message thread only.
+ *
+ * @see WaveformLod
+ * @see WaveformManager
+ */
+class WaveformRenderer {
+  public:
+    WaveformRenderer() = default;
+
+    /** @brief Draws one channel of `[startTime, endTime)` into `bounds` in the current colour. */
+    void drawChannel(juce::Graphics &g, const WaveformManager &waveformManager,
+                     juce::Rectangle<int> bounds, double startTime, double endTime, int channel);
+
+    /** @brief Draws every channel, each in an equal horizontal strip of `bounds`. */
+    void drawChannels(juce::Graphics &g, const WaveformManager &waveformManager,
+                      juce::Rectangle<int> bounds, double startTime, double endTime);
+
+  private:
+    bool copySamples(const WaveformManager::DetailBlock &detail, int channel,
+                     juce::int64 firstSample, int numSamples);
+    void columnsFromSamples(double offset, double samplesPerColumn, int numColumns);
+    void fillColumns(juce::Graphics &g, juce::Rectangle<int> bounds, int numColumns);
+    void strokeSamples(juce::Graphics &g, juce::Rectangle<int> bounds, double offset,
+                       double samplesPerColumn, int numSamples);
+
+    std::vector<float> columnMins;
+    std::vector<float> columnMaxs;
+    std::vector<float> samples;
+    juce::RectangleList<float> bars;
+    juce::Path trace;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformRenderer)
+};
+
+#endif
@@ -20,7 +20,7 @@ WaveformView::~WaveformView() {
 }
 
 void WaveformView::changeListenerCallback(juce::ChangeBroadcaster *source) {
-    if (source == &waveformManager.getThumbnail())
+    if (source == &waveformManager)
 
         repaint();
 }
@@ -36,16 +36,16 @@ void WaveformView::setChannelMode(AppEnums::ChannelViewMode channelMode) {
 void WaveformView::paint(juce::Graphics &g) {
     g.fillAll(juce::Colours::black);
 
-    auto &thumbnail = waveformManager.getThumbnail();
-    const auto audioLength = thumbnail.getTotalLength();
-    if (audioLength <= 0.0)
+    const auto audioLength = waveformManager.getThumbnail().getTotalLength();
+    const auto lod = waveformManager.getLod();
+    if (audioLength <= 0.0 || lod == nullptr)
         return;
 
     g.setColour(Config::Colors::waveform);
-    const int numChannels = thumbnail.getNumChannels();
+    const int numChannels = lod->getNumChannels();
 
     if (currentChannelMode == AppEnums::ChannelViewMode::Mono || numChannels == 1)
-        thumbnail.drawChannel(g, getLocalBounds(), 0.0, audioLength, 0, 1.0f);
+        renderer.drawChannel(g, waveformManager, getLocalBounds(), 0.0, audioLength, 0);
     else
-        thumbnail.drawChannels(g, getLocalBounds(), 0.0, audioLength, 1.0f);
+        renderer.drawChannels(g, waveformManager, getLocalBounds(), 0.0, audioLength);
 }
@@ -10,6 +10,7 @@
 #endif
 
 #include "Core/AppEnums.h"
+#include "UI/Views/WaveformRenderer.h"
 #include "Utils/Config.h"
 
 class WaveformManager;
@@ -30,6 +31,7 @@ class WaveformView : public juce::Component, public juce::ChangeListener {
     void drawWaveform(juce::Graphics &g, const juce::Rectangle<int> &bounds) const;
 
     WaveformManager &waveformManager;
+    WaveformRenderer renderer;
     AppEnums::ChannelViewMode currentChannelMode = AppEnums::ChannelViewMode::Mono;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformView)
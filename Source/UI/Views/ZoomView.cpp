@@ -19,29 +19,52 @@ ZoomView::~ZoomView() {
     owner.getPlaybackTimerManager().removeListener(this);
 }
 
+juce::RectangleList<int> ZoomView::cursorArea(int mouseX, int mouseY) const {
+    // Covers the cursor lines with their glows, the amplitude markers and both readouts.
+    const int x = mouseX - getX();
+    const int y = mouseY - getY();
+    const int reach =
+        juce::roundToInt(juce::jmax(Config::Layout::Glow::thickness,
+                                    Config::Layout::Glow::placementModeGlowThickness,
+                                    Config::Animation::mouseAmplitudeLineLength *
+                                        Config::Layout::Glow::offsetFactor)) +
+        Config::Layout::Glow::mouseHighlightSize;
+    const int readoutReach =
+        Config::Layout::Glow::mouseTextOffset + Config::Layout::Text::mouseReadoutWidth;
+
+    juce::RectangleList<int> area;
+    area.add({x - reach, 0, reach + juce::jmax(reach, readoutReach), getHeight()});
+    area.add({0, y - reach, getWidth(),
+              reach + juce::jmax(reach, Config::Layout::Glow::mouseTextOffset +
+                                            Config::Layout::Text::mouseCursorSize)});
+    return area;
+}
+
 void ZoomView::playbackTimerTick() {
+    auto &scheduler = owner.getPlaybackTimerManager().getRepaintScheduler();
     const auto &mouse = owner.getMouseHandler();
     const int currentMouseX = mouse.getMouseCursorX();
     const int currentMouseY = mouse.getMouseCursorY();
 
     const auto &timerManager = owner.getPlaybackTimerManager();
     const bool zDown = timerManager.isZKeyDown();
+    const auto placementMode = owner.getPlacementMode();
     const auto activePoint = owner.getInteractionCoordinator().getActiveZoomPoint();
     const bool isZooming = zDown || activePoint != AppEnums::ActiveZoomPoint::None;
 
-    if (currentMouseX != lastMouseX || currentMouseY != lastMouseY) {
-        if (lastMouseX != -1) {
-            repaint(lastMouseX - 1, 0, 3, getHeight());
-            repaint(0, lastMouseY - 1, getWidth(), 3);
-        }
+    // The cursor's colour follows the Z key and the placement mode.
+    if (currentMouseX != lastMouseX || currentMouseY != lastMouseY || zDown != lastZDown ||
+        placementMode != lastPlacementMode) {
+        if (lastMouseX != -1)
+            scheduler.invalidate(*this, cursorArea(lastMouseX, lastMouseY));
 
-        if (currentMouseX != -1) {
-            repaint(currentMouseX - 1, 0, 3, getHeight());
-            repaint(0, currentMouseY - 1, getWidth(), 3);
-        }
+        if (currentMouseX != -1)
+            scheduler.invalidate(*this, cursorArea(currentMouseX, currentMouseY));
 
         lastMouseX = currentMouseX;
         lastMouseY = currentMouseY;
+        lastZDown = zDown;
+        lastPlacementMode = placementMode;
     }
 
     if (isZooming) {
@@ -54,33 +77,36 @@ void ZoomView::playbackTimerTick() {
                                                       waveformBounds.getCentreY() - popupHeight / 2,
                                                       popupWidth, popupHeight);
 
+        // The popup tracks playback and pulses, so it is redrawn every frame while open.
         if (currentPopupBounds != lastPopupBounds) {
-            repaint(lastPopupBounds.expanded(5));
-            repaint(currentPopupBounds.expanded(5));
+            scheduler.invalidate(*this, lastPopupBounds.expanded(5));
             lastPopupBounds = currentPopupBounds;
-        } else {
-            repaint(currentPopupBounds.expanded(5));
         }
+        scheduler.invalidate(*this, currentPopupBounds.expanded(5));
     } else if (!lastPopupBounds.isEmpty()) {
-        repaint(lastPopupBounds.expanded(5));
+        scheduler.invalidate(*this, lastPopupBounds.expanded(5));
         lastPopupBounds = juce::Rectangle<int>();
     }
 }
 
 void ZoomView::animationUpdate(float breathingPulse) {
+    // The pulse is only drawn inside the popup, which playbackTimerTick() already invalidates.
     juce::ignoreUnused(breathingPulse);
-    repaint();
 }
 
 void ZoomView::activeZoomPointChanged(AppEnums::ActiveZoomPoint newPoint) {
     juce::ignoreUnused(newPoint);
-    repaint();
+    owner.getPlaybackTimerManager().getRepaintScheduler().invalidateAll(*this);
 }
 
 void ZoomView::paint(juce::Graphics &g) {
+    const RepaintScheduler::ScopedPaintTimer paintTimer(
+        owner.getPlaybackTimerManager().getRepaintScheduler());
     auto &audioPlayer = owner.getAudioPlayer();
-    const double audioLength = audioPlayer.getWaveformManager().getThumbnail().getTotalLength();
-    if (audioLength <= 0.0)
+    const auto &waveformManager = audioPlayer.getWaveformManager();
+    const double audioLength = waveformManager.getThumbnail().getTotalLength();
+    const auto lod = waveformManager.getLod();
+    if (audioLength <= 0.0 || lod == nullptr)
         return;
 
     const auto waveformBounds = getLocalBounds();
@@ -126,16 +152,10 @@ void ZoomView::paint(juce::Graphics &g) {
                    waveformBounds.getWidth(), Config::Layout::Glow::mouseHighlightSize);
 
         float amplitude = 0.0f;
-        if (audioPlayer.getWaveformManager().getThumbnail().getNumChannels() > 0) {
-            double sampleRate = 0.0;
-            juce::int64 length = 0;
-            if (audioPlayer.getReaderInfo(sampleRate, length) && sampleRate > 0.0) {
-                float minVal = 0.0f, maxVal = 0.0f;
-                audioPlayer.getWaveformManager().getThumbnail().getApproximateMinMax(
-                    mouse.getMouseCursorTime(), mouse.getMouseCursorTime() + (1.0 / sampleRate), 0,
-                    minVal, maxVal);
-                amplitude = juce::jmax(std::abs(minVal), std::abs(maxVal));
-            }
+        if (lod->getNumChannels() > 0 && lod->getSampleRate() > 0.0) {
+            const auto range = lod->getMinMax(
+                0, (juce::int64)(mouse.getMouseCursorTime() * lod->getSampleRate()), 1);
+            amplitude = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
         }
 
         const float centerY = (float)waveformBounds.getCentreY();
@@ -171,16 +191,18 @@ void ZoomView::paint(juce::Graphics &g) {
         g.setColour(Config::Colors::playbackText);
         g.setFont(Config::Layout::Text::mouseCursorSize);
         g.drawText(juce::String(amplitude, 2), localMouseX + Config::Layout::Glow::mouseTextOffset,
-                   (int)amplitudeY - Config::Layout::Text::mouseCursorSize, 100,
-                   Config::Layout::Text::mouseCursorSize, juce::Justification::left, true);
-        g.drawText(juce::String(-amplitude, 2), localMouseX + Config::Layout::Glow::mouseTextOffset,
-                   (int)bottomAmplitudeY, 100, Config::Layout::Text::mouseCursorSize,
+                   (int)amplitudeY - Config::Layout::Text::mouseCursorSize,
+                   Config::Layout::Text::mouseReadoutWidth, Config::Layout::Text::mouseCursorSize,
                    juce::Justification::left, true);
+        g.drawText(juce::String(-amplitude, 2), localMouseX + Config::Layout::Glow::mouseTextOffset,
+                   (int)bottomAmplitudeY, Config::Layout::Text::mouseReadoutWidth,
+                   Config::Layout::Text::mouseCursorSize, juce::Justification::left, true);
 
         const juce::String timeText = owner.formatTime(mouse.getMouseCursorTime());
         g.drawText(timeText, localMouseX + Config::Layout::Glow::mouseTextOffset,
-                   localMouseY + Config::Layout::Glow::mouseTextOffset, 100,
-                   Config::Layout::Text::mouseCursorSize, juce::Justification::left, true);
+                   localMouseY + Config::Layout::Glow::mouseTextOffset,
+                   Config::Layout::Text::mouseReadoutWidth, Config::Layout::Text::mouseCursorSize,
+                   juce::Justification::left, true);
 
         const juce::Colour glowColor = owner.getInteractionCoordinator().shouldShowEyeCandy()
                                            ? currentLineColor
@@ -220,11 +242,10 @@ void ZoomView::paint(juce::Graphics &g) {
 
         g.setColour(Config::Colors::waveform);
         const auto channelMode = owner.getChannelViewMode();
-        const int numChannels = audioPlayer.getWaveformManager().getThumbnail().getNumChannels();
+        const int numChannels = lod->getNumChannels();
 
         if (channelMode == AppEnums::ChannelViewMode::Mono || numChannels == 1) {
-            audioPlayer.getWaveformManager().getThumbnail().drawChannel(g, popupBounds, startTime,
-                                                                        endTime, 0, 1.0f);
+            renderer.drawChannel(g, waveformManager, popupBounds, startTime, endTime, 0);
             g.setColour(Config::Colors::zoomPopupZeroLine);
             g.drawHorizontalLine(popupBounds.getCentreY(), (float)popupBounds.getX(),
                                  (float)popupBounds.getRight());
@@ -233,10 +254,8 @@ void ZoomView::paint(juce::Graphics &g) {
             auto bottomBounds =
                 popupBounds.withTop(topBounds.getBottom()).withHeight(popupBounds.getHeight() / 2);
 
-            audioPlayer.getWaveformManager().getThumbnail().drawChannel(g, topBounds, startTime,
-                                                                        endTime, 0, 1.0f);
-            audioPlayer.getWaveformManager().getThumbnail().drawChannel(g, bottomBounds, startTime,
-                                                                        endTime, 1, 1.0f);
+            renderer.drawChannel(g, waveformManager, topBounds, startTime, endTime, 0);
+            renderer.drawChannel(g, waveformManager, bottomBounds, startTime, endTime, 1);
 
             g.setColour(Config::Colors::zoomPopupZeroLine);
             g.drawHorizontalLine(topBounds.getCentreY(), (float)topBounds.getX(),
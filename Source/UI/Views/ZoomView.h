@@ -12,6 +12,7 @@
 #include "Core/AppEnums.h"
 
 #include "Presenters/PlaybackTimerManager.h"
+#include "UI/Views/WaveformRenderer.h"
 
 class ControlPanel;
 
@@ -27,11 +28,17 @@ class ZoomView : public juce::Component, public PlaybackTimerManager::Listener {
     void activeZoomPointChanged(AppEnums::ActiveZoomPoint newPoint) override;
 
   private:
+    /** Area drawn for a mouse cursor at a position in the owner's coordinates. */
+    juce::RectangleList<int> cursorArea(int mouseX, int mouseY) const;
+
     ControlPanel &owner;
+    WaveformRenderer renderer;
 
     juce::Rectangle<int> lastPopupBounds;
     int lastMouseX{-1};
     int lastMouseY{-1};
+    bool lastZDown{false};
+    AppEnums::PlacementMode lastPlacementMode{AppEnums::PlacementMode::None};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ZoomView)
 };
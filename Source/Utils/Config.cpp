@@ -69,6 +69,8 @@ const juce::String autoCutOutButton = "[AC Out]";
 const juce::String cutButton = "[Cut]";
 const juce::String silenceThresholdInTooltip = "Silence Threshold In";
 const juce::String silenceThresholdOutTooltip = "Silence Threshold Out";
+const juce::String exportChooserTitle = "Export Cut Region...";
+const juce::String exportFileSuffix = "_cut";
 } // namespace Labels
 
 } // namespace Config
@@ -109,6 +109,8 @@ struct Layout {
         static constexpr int playbackOffsetY = 25;
         static constexpr int playbackSize = 30;
         static constexpr int mouseCursorSize = 20;
+        /** Width of the amplitude and time readouts next to the mouse cursor. */
+        static constexpr int mouseReadoutWidth = 100;
         static constexpr float buttonHeightScale = 0.45f;
         static constexpr float buttonPlayPauseHeightScale = 0.7f;
         static constexpr float backgroundAlpha = 0.7f;
@@ -134,6 +136,8 @@ struct Layout {
         static constexpr float heightScale = 0.5f;
         static constexpr int pixelsPerSampleLow = 4;
         static constexpr int pixelsPerSampleMedium = 2;
+        /** Stroke width of the sample-to-sample trace drawn when zoomed past one sample. */
+        static constexpr float traceThickness = 1.0f;
     };
 
     struct Glow {
@@ -162,6 +166,13 @@ struct Layout {
         static constexpr float popupScale = 0.8f;
         static constexpr float borderThickness = 3.0f;
     };
+
+    struct Repaint {
+        /** Dirty rectangles per view and frame before they are merged into their bounds. */
+        static constexpr int maxRectsPerView = 8;
+        /** Weight of the newest frame in the smoothed paint cost. */
+        static constexpr double paintCostSmoothing = 0.1;
+    };
 };
 
 namespace Animation {
@@ -170,6 +181,14 @@ constexpr float buttonPressedDarkness = 0.1f;
 constexpr float mouseAmplitudeLineLength = 50.0f;
 constexpr float thresholdLineWidth = 100.0f;
 constexpr float masterPhaseDurationSeconds = 4.0f;
+/** UI frame rate while playing, dragging or zooming, when no display vblank is available. */
+constexpr int activeFrameRateHz = 60;
+/** UI frame rate while idle but something on screen still pulses. */
+constexpr int animatingFrameRateHz = 30;
+/** UI frame rate while idle with nothing moving; input wakes it back to the active rate. */
+constexpr int idleFrameRateHz = 4;
+/** How long the UI stays at the active rate after the last mouse, key or state event. */
+constexpr double activityHoldSeconds = 1.0;
 } // namespace Animation
 
 namespace Audio {
@@ -182,11 +201,81 @@ constexpr double cutStepSeconds = 1.0;
 constexpr double cutStepMilliseconds = 0.01;
 constexpr double cutStepMillisecondsFine = 0.001;
 constexpr int readAheadBufferSize = 32768;
+/** Samples the read-ahead thread reads from the file per time slice. */
+constexpr int readAheadChunkSize = 4096;
+/** How long the read-ahead thread rests once its ring is full or the file is exhausted. */
+constexpr int readAheadIdleMs = 20;
+/** How often the end of playback, found on the audio thread, is checked for and reported. */
+constexpr int playbackEndPollMs = 10;
+/** @brief Shapes of the gain ramps at cut boundaries and repeat seams. */
+enum class FadeCurve { Linear, EqualPower, RaisedCosine };
+/** @brief Length of the fade at cut-in, cut-out and of the crossfade at every repeat. */
+constexpr double boundaryFadeSeconds = 0.005;
+constexpr FadeCurve boundaryFadeCurve = FadeCurve::EqualPower;
+constexpr bool useMemoryMappedReaders = true;
+constexpr int mappedPrefaultSamples = 262144;
+/**
+ * @brief Smoothing of the audio callback times the UI playhead is interpolated from.
+ * @details Weight of each callback's measured time against the time predicted from the
+ *          previous one; lower values reject more scheduling jitter.
+ */
+constexpr double playheadClockSmoothing = 0.05;
+/** @brief Audio blocks the interpolated playhead may run past the last callback. */
+constexpr double playheadMaxLeadBlocks = 2.0;
 constexpr float silenceThresholdIn = 0.01f;
 constexpr float silenceThresholdOut = 0.01f;
+constexpr double silenceOutTailSeconds = 0.05;
 constexpr bool lockHandlesWhenAutoCutActive = false;
+constexpr double scanTimeBudgetMs = 8.0;
+constexpr int envelopeBaseBlockSize = 1024;
+constexpr int envelopeLevelRatio = 8;
+constexpr int envelopeNumLevels = 3;
+constexpr int envelopeReadChunkSize = 65536;
+/** @brief Finest block of the waveform pyramid; below this the waveform is drawn from samples. */
+constexpr int waveformLodBaseBlockSize = 64;
+constexpr int waveformLodLevelRatio = 8;
+constexpr int waveformLodNumLevels = 3;
+/**
+ * @brief Strided preview read before the full decode, so a file's whole shape shows at once.
+ * @details The first pass probes this many points spread over the file; each further pass
+ *          probes halfway between the previous ones, doubling the detail.
+ */
+constexpr int waveformPreviewFirstPassProbes = 512;
+constexpr int waveformPreviewNumPasses = 4;
+constexpr int waveformPreviewProbeSamples = 256;
+/**
+ * @brief Extra samples read on each side of a sample-level zoom, as a fraction of the view.
+ * @details Small scrolls and zooms then repaint from the samples already read.
+ */
+constexpr double waveformDetailMargin = 0.5;
+constexpr juce::int64 parallelScanMinSegmentSamples = 1 << 20;
+constexpr int parallelScanSegmentsPerThread = 4;
+/** @brief Threads opening files for AudioPlayer::loadFileAsync; a stalled open holds one. */
+constexpr int fileLoadThreads = 2;
+/** @brief Samples decoded per chunk when rendering a region to a file. */
+constexpr int renderChunkSamples = 32768;
+/** @brief Samples queued between a render's decoding thread and its writer thread. */
+constexpr int renderWriterFifoSamples = 1 << 17;
+/** @brief Bytes moved per read when a render copies PCM data without decoding. */
+constexpr int renderCopyChunkBytes = 1 << 20;
+/** @brief Fades applied to exported regions; 0 keeps WAV exports a lossless byte copy. */
+constexpr double exportFadeSeconds = 0.0;
 } // namespace Audio
 
+namespace Cache {
+constexpr int fingerprintHeaderBytes = 65536;
+constexpr int fingerprintNumBlocks = 32;
+constexpr int fingerprintBlockBytes = 16384;
+constexpr int fingerprintReadChunkBytes = 1 << 20;
+constexpr bool verifyFullContent = false;
+/** @brief How often changed metadata is appended to the journal; bounds what a crash loses. */
+constexpr int metadataFlushIntervalMs = 1000;
+/** @brief Journal records that trigger folding the journal into a new metadata table. */
+constexpr int metadataCompactAfterRecords = 4096;
+/** @brief Playlist files after the current one that are prepared in the background. */
+constexpr int prefetchAheadFiles = 3;
+} // namespace Cache
+
 namespace Labels {
 extern const juce::String openButton;
 extern const juce::String playButton;
@@ -207,6 +296,9 @@ extern const juce::String autoCutOutButton;
 extern const juce::String cutButton;
 extern const juce::String silenceThresholdInTooltip;
 extern const juce::String silenceThresholdOutTooltip;
+extern const juce::String exportChooserTitle;
+/** @brief Appended to the source name to suggest an export file name. */
+extern const juce::String exportFileSuffix;
 } // namespace Labels
 
 } // namespace Config
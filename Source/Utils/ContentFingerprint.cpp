@@ -0,0 +1,192 @@
+#include "Utils/ContentFingerprint.h"
+#include "Utils/Config.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr juce::uint64 kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr juce::uint64 kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr juce::uint64 kPrime3 = 0x165667B19E3779F9ULL;
+constexpr juce::uint64 kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr juce::uint64 kPrime5 = 0x27D4EB2F165667C5ULL;
+
+/** Distinct seeds keep sampled and full keys of the same file apart. */
+constexpr juce::uint64 kSampledSeed = 0x5341'4D50ULL;
+constexpr juce::uint64 kFullSeed = 0x4655'4C4CULL;
+
+inline juce::uint64 rotateLeft(juce::uint64 value, int bits) noexcept {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline juce::uint64 mixRound(juce::uint64 accumulator, juce::uint64 input) noexcept {
+    accumulator += input * kPrime2;
+    return rotateLeft(accumulator, 31) * kPrime1;
+}
+
+inline juce::uint64 mergeRound(juce::uint64 hash, juce::uint64 accumulator) noexcept {
+    hash ^= mixRound(0, accumulator);
+    return hash * kPrime1 + kPrime4;
+}
+
+/** Folds the tail (< 32 bytes) and applies the final avalanche. */
+juce::uint64 finalise(juce::uint64 hash, const juce::uint8 *tail, size_t length) noexcept {
+    for (; length >= 8; tail += 8, length -= 8) {
+        hash ^= mixRound(0, juce::ByteOrder::littleEndianInt64(tail));
+        hash = rotateLeft(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (length >= 4) {
+        hash ^= (juce::uint64)juce::ByteOrder::littleEndianInt(tail) * kPrime1;
+        hash = rotateLeft(hash, 23) * kPrime2 + kPrime3;
+        tail += 4;
+        length -= 4;
+    }
+    for (; length > 0; ++tail, --length) {
+        hash ^= (juce::uint64)(*tail) * kPrime5;
+        hash = rotateLeft(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/** Hashes `numBytes` starting at `start`; false on a short read or cancellation. */
+bool hashRange(juce::InputStream &stream, juce::int64 start, juce::int64 numBytes,
+               ContentFingerprint::Hasher &hasher, std::vector<char> &scratch,
+               const std::function<bool()> &shouldAbort) {
+    if (!stream.setPosition(start))
+        return false;
+
+    while (numBytes > 0) {
+        if (shouldAbort != nullptr && shouldAbort())
+            return false;
+
+        const int numThisTime = (int)juce::jmin(numBytes, (juce::int64)scratch.size());
+        if (stream.read(scratch.data(), numThisTime) != numThisTime)
+            return false;
+
+        hasher.update(scratch.data(), (size_t)numThisTime);
+        numBytes -= numThisTime;
+    }
+    return true;
+}
+} // namespace
+
+ContentFingerprint::Hasher::Hasher(juce::uint64 seedIn) noexcept : seed(seedIn) {
+    accumulators[0] = seed + kPrime1 + kPrime2;
+    accumulators[1] = seed + kPrime2;
+    accumulators[2] = seed;
+    accumulators[3] = seed - kPrime1;
+}
+
+void ContentFingerprint::Hasher::update(const void *data, size_t numBytes) noexcept {
+    auto *input = static_cast<const juce::uint8 *>(data);
+    totalLength += numBytes;
+
+    if (numPending + numBytes < sizeof(pending)) {
+        std::memcpy(pending + numPending, input, numBytes);
+        numPending += numBytes;
+        return;
+    }
+
+    if (numPending > 0) {
+        const size_t fill = sizeof(pending) - numPending;
+        std::memcpy(pending + numPending, input, fill);
+        for (int lane = 0; lane < 4; ++lane) {
+            const juce::uint64 word = juce::ByteOrder::littleEndianInt64(pending + lane * 8);
+            accumulators[lane] = mixRound(accumulators[lane], word);
+        }
+        input += fill;
+        numBytes -= fill;
+        numPending = 0;
+    }
+
+    // Four independent lanes per 32-byte stripe keep the multiplier pipelines busy.
+    for (; numBytes >= 32; input += 32, numBytes -= 32) {
+        accumulators[0] = mixRound(accumulators[0], juce::ByteOrder::littleEndianInt64(input));
+        accumulators[1] = mixRound(accumulators[1], juce::ByteOrder::littleEndianInt64(input + 8));
+        accumulators[2] = mixRound(accumulators[2], juce::ByteOrder::littleEndianInt64(input + 16));
+        accumulators[3] = mixRound(accumulators[3], juce::ByteOrder::littleEndianInt64(input + 24));
+    }
+
+    std::memcpy(pending, input, numBytes);
+    numPending = numBytes;
+}
+
+juce::uint64 ContentFingerprint::Hasher::digest() const noexcept {
+    juce::uint64 hash;
+    if (totalLength >= 32) {
+        hash = rotateLeft(accumulators[0], 1) + rotateLeft(accumulators[1], 7) +
+               rotateLeft(accumulators[2], 12) + rotateLeft(accumulators[3], 18);
+        for (const juce::uint64 accumulator : accumulators)
+            hash = mergeRound(hash, accumulator);
+    } else {
+        hash = seed + kPrime5;
+    }
+
+    hash += totalLength;
+    return finalise(hash, pending, numPending);
+}
+
+juce::uint64 ContentFingerprint::hash64(const void *data, size_t numBytes,
+                                        juce::uint64 seed) noexcept {
+    Hasher hasher(seed);
+    hasher.update(data, numBytes);
+    return hasher.digest();
+}
+
+juce::String ContentFingerprint::compute(const juce::File &file, Mode mode,
+                                         const std::function<bool()> &shouldAbort) {
+    juce::FileInputStream stream(file);
+    if (!stream.openedOk())
+        return {};
+    return compute(stream, mode, shouldAbort);
+}
+
+juce::String ContentFingerprint::compute(juce::InputStream &stream, Mode mode,
+                                         const std::function<bool()> &shouldAbort) {
+    const juce::int64 size = stream.getTotalLength();
+    if (size < 0)
+        return {};
+
+    Hasher hasher(mode == Mode::Sampled ? kSampledSeed : kFullSeed);
+
+    juce::uint8 sizeBytes[8];
+    for (int i = 0; i < 8; ++i)
+        sizeBytes[i] = (juce::uint8)((juce::uint64)size >> (8 * i));
+    hasher.update(sizeBytes, sizeof(sizeBytes));
+
+    const juce::int64 headerBytes = Config::Cache::fingerprintHeaderBytes;
+    const juce::int64 blockBytes = Config::Cache::fingerprintBlockBytes;
+    const int numBlocks = Config::Cache::fingerprintNumBlocks;
+    static_assert(Config::Cache::fingerprintNumBlocks > 1, "Strides need at least two blocks");
+
+    // Sampled reads never exceed the header size, so only the full mode needs large reads.
+    const int scratchBytes = mode == Mode::Full ? Config::Cache::fingerprintReadChunkBytes
+                                                : Config::Cache::fingerprintHeaderBytes;
+    std::vector<char> scratch((size_t)scratchBytes);
+    bool ok = true;
+
+    if (mode == Mode::Full || size <= headerBytes + blockBytes * numBlocks) {
+        ok = hashRange(stream, 0, size, hasher, scratch, shouldAbort);
+    } else {
+        ok = hashRange(stream, 0, headerBytes, hasher, scratch, shouldAbort);
+
+        // Spread the blocks over the rest of the file; the last one ends at end-of-file.
+        const juce::int64 span = size - headerBytes - blockBytes;
+        for (int block = 0; ok && block < numBlocks; ++block) {
+            const juce::int64 offset = headerBytes + span * block / (numBlocks - 1);
+            ok = hashRange(stream, offset, blockBytes, hasher, scratch, shouldAbort);
+        }
+    }
+
+    if (!ok)
+        return {};
+
+    const juce::String prefix = mode == Mode::Sampled ? "s" : "f";
+    return prefix + juce::String::toHexString((juce::int64)hasher.digest()).paddedLeft('0', 16);
+}
@@ -0,0 +1,59 @@
+#ifndef AUDIOFILER_CONTENTFINGERPRINT_H
+#define AUDIOFILER_CONTENTFINGERPRINT_H
+
+#include <juce_core/juce_core.h>
+
+#include <functional>
+
+/**
+ * @ingroup Helpers
+ * @class ContentFingerprint
+ * @brief Fast, non-cryptographic identity of a file's content, used as `FileMetadata::hash`.
+ * @details The sampled mode hashes the file size, the first
+ *          `Config::Cache::fingerprintHeaderBytes` and `Config::Cache::fingerprintNumBlocks`
+ *          evenly strided blocks (the last one ending at end-of-file), so its cost does not
+ *          grow with the file. The full mode hashes every byte and is meant for verification.
+ *          Both use XXH64; the mode is part of the key, so keys of different modes never match.
+ *
+ *          The key survives renames and moves, unlike a path-based key. Reads go through a
+ *          private stream and may take a while on slow disks, so call it off the message thread.
+ */
+class ContentFingerprint {
+  public:
+    enum class Mode { Sampled, Full };
+
+    /** @brief Incremental XXH64; digest() equals hash64() over everything passed to update(). */
+    class Hasher {
+      public:
+        explicit Hasher(juce::uint64 seed = 0) noexcept;
+
+        void update(const void *data, size_t numBytes) noexcept;
+
+        juce::uint64 digest() const noexcept;
+
+      private:
+        juce::uint64 accumulators[4];
+        juce::uint8 pending[32];
+        size_t numPending{0};
+        juce::uint64 totalLength{0};
+        juce::uint64 seed;
+    };
+
+    /** @brief One-shot XXH64 of a memory range. */
+    static juce::uint64 hash64(const void *data, size_t numBytes, juce::uint64 seed = 0) noexcept;
+
+    /**
+     * @brief Computes the key of a file.
+     * @param shouldAbort Polled between reads; returning true cancels the computation.
+     * @return The key (mode prefix plus 16 hex digits), or an empty string if the file could
+     *         not be read or the computation was cancelled.
+     */
+    static juce::String compute(const juce::File &file, Mode mode = Mode::Sampled,
+                                const std::function<bool()> &shouldAbort = {});
+
+    /** @brief As compute(const juce::File&), over any seekable stream. */
+    static juce::String compute(juce::InputStream &stream, Mode mode,
+                                const std::function<bool()> &shouldAbort = {});
+};
+
+#endif
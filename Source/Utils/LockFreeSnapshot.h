@@ -0,0 +1,102 @@
+#ifndef AUDIOFILER_LOCKFREESNAPSHOT_H
+#define AUDIOFILER_LOCKFREESNAPSHOT_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @file LockFreeSnapshot.h
+ * @ingroup Helpers
+ * @brief Publishes a small trivially copyable value to a real-time reader without locks.
+ * @details A sequence lock: the writer makes the sequence odd, stores the value as relaxed
+ *          atomic words and makes the sequence even again. A reader copies the words and keeps
+ *          the copy only if the sequence was even and unchanged around it, so it never sees a
+ *          torn value and never blocks.
+ *
+ *          Writers are serialised by a mutex that readers never touch. A value with exactly
+ *          one writer can skip it with publishFromSingleWriter(), which lets the real-time
+ *          thread be that writer. A reader that keeps racing a write gives up after a few
+ *          attempts instead of spinning, and the caller carries on with the value it read last.
+ */
+template <typename T> class LockFreeSnapshot {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "LockFreeSnapshot copies its value word by word");
+
+  public:
+    explicit LockFreeSnapshot(const T &initial = T{}) {
+        store(initial);
+    }
+
+    /** @brief Replaces the published value. Never call this from the real-time thread. */
+    void publish(const T &value) {
+        const std::lock_guard<std::mutex> lock(writeMutex);
+        publishFromSingleWriter(value);
+    }
+
+    /**
+     * @brief Replaces the published value without locking; safe on the real-time thread.
+     * @details Only when one thread ever writes this snapshot; never mix it with publish().
+     */
+    void publishFromSingleWriter(const T &value) noexcept {
+        const std::uint32_t sequenceBefore = sequence.load(std::memory_order_relaxed);
+        sequence.store(sequenceBefore + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        store(value);
+        sequence.store(sequenceBefore + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the published value into `out` without blocking.
+     * @return False, leaving `out` untouched, if every attempt overlapped a write.
+     */
+    bool tryRead(T &out) const {
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            const std::uint32_t before = sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0)
+                continue;
+
+            Words copy;
+            for (size_t i = 0; i < kNumWords; ++i)
+                copy[i] = words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&out, copy.data(), sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief Reads the value, waiting out concurrent writes. For non-real-time callers. */
+    T read() const {
+        T value{};
+        while (!tryRead(value))
+            std::this_thread::yield();
+        return value;
+    }
+
+  private:
+    static constexpr size_t kNumWords = (sizeof(T) + sizeof(std::uint64_t) - 1) /
+                                        sizeof(std::uint64_t);
+    static constexpr int kMaxReadAttempts = 8;
+    using Words = std::array<std::uint64_t, kNumWords>;
+
+    void store(const T &value) {
+        Words copy{};
+        std::memcpy(copy.data(), &value, sizeof(T));
+        for (size_t i = 0; i < kNumWords; ++i)
+            words[i].store(copy[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint32_t> sequence{0};
+    std::array<std::atomic<std::uint64_t>, kNumWords> words{};
+    std::mutex writeMutex;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "Workers/FilePrefetcher.h"
+#include "Core/AnalysisCache.h"
+#include "Core/AudioReaderFactory.h"
+#include "Core/EnvelopeBuilder.h"
+#include "Core/WaveformLod.h"
+#include "Utils/Config.h"
+#include "Utils/ContentFingerprint.h"
+#include "Workers/ScanScheduler.h"
+
+FilePrefetcher::FilePrefetcher(juce::AudioFormatManager &formatManagerIn,
+                               const AnalysisCache &analysisCacheIn)
+    : juce::Thread("FilePrefetcher"), formatManager(formatManagerIn),
+      analysisCache(analysisCacheIn) {
+    startThread(ScanScheduler::priorityFor(AppEnums::ScanPolicy::TimeBudgeted));
+}
+
+FilePrefetcher::~FilePrefetcher() {
+    cancel();
+    stopThread(4000);
+}
+
+void FilePrefetcher::prefetch(const juce::Array<juce::File> &files) {
+    {
+        const std::lock_guard<std::mutex> lock(queueMutex);
+        queue.clear();
+        for (const auto &file : files)
+            if (file != running && !prefetched.contains(file))
+                queue.addIfNotAlreadyThere(file);
+
+        if (running != juce::File() && !files.contains(running))
+            ++generation;
+    }
+    notify();
+}
+
+void FilePrefetcher::cancel() {
+    const std::lock_guard<std::mutex> lock(queueMutex);
+    queue.clear();
+    if (running != juce::File())
+        ++generation;
+}
+
+bool FilePrefetcher::isPrefetched(const juce::File &file) const {
+    const std::lock_guard<std::mutex> lock(queueMutex);
+    return prefetched.contains(file);
+}
+
+bool FilePrefetcher::isBusy() const {
+    const std::lock_guard<std::mutex> lock(queueMutex);
+    return !queue.isEmpty() || running != juce::File();
+}
+
+void FilePrefetcher::run() {
+    while (!threadShouldExit()) {
+        juce::File file;
+        juce::uint32 startGeneration = 0;
+        {
+            const std::lock_guard<std::mutex> lock(queueMutex);
+            running = queue.isEmpty() ? juce::File() : queue.removeAndReturn(0);
+            file = running;
+            startGeneration = generation.load();
+        }
+
+        if (file == juce::File()) {
+            wait(-1);
+            continue;
+        }
+
+        const auto shouldStop = [this, startGeneration] {
+            return threadShouldExit() || generation.load() != startGeneration;
+        };
+        const bool prepared = prefetchFile(file, shouldStop);
+        const std::lock_guard<std::mutex> lock(queueMutex);
+        if (prepared)
+            prefetched.addIfNotAlreadyThere(file);
+        running = juce::File();
+    }
+}
+
+bool FilePrefetcher::prefetchFile(const juce::File &file,
+                                  const std::function<bool()> &shouldStop) const {
+    auto reader = AudioReaderFactory::createReader(formatManager, file);
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+        return false;
+
+    const auto mode = Config::Cache::verifyFullContent ? ContentFingerprint::Mode::Full
+                                                       : ContentFingerprint::Mode::Sampled;
+    const juce::String contentKey = ContentFingerprint::compute(file, mode, shouldStop);
+    if (contentKey.isEmpty() || shouldStop())
+        return false;
+
+    const int numChannels = (int)reader->numChannels;
+    const juce::int64 lengthInSamples = reader->lengthInSamples;
+
+    // Prepared before, in this session or an earlier one: nothing to decode.
+    AnalysisCache::Entry entry;
+    const bool cached = analysisCache.load(contentKey, entry);
+    juce::MemoryBlock thumbnailData;
+    if (cached && entry.envelope != nullptr &&
+        entry.envelope->getLengthInSamples() == lengthInSamples &&
+        entry.envelope->getNumChannels() == numChannels &&
+        analysisCache.loadThumbnailData(contentKey, thumbnailData))
+        return true;
+
+    WaveformLod lod(numChannels, lengthInSamples, reader->sampleRate);
+    ScanScheduler scheduler(AppEnums::ScanPolicy::TimeBudgeted, shouldStop);
+    const auto index = EnvelopeBuilder::buildFromReader(
+        *reader, &scheduler,
+        [&lod](juce::int64 startSample, const juce::AudioBuffer<float> &buffer, int numSamples) {
+            lod.addBlock(startSample, buffer, numSamples);
+        });
+    if (index == nullptr)
+        return false;
+
+    // Keep cut points stored under this content; a new file starts out whole.
+    FileMetadata metadata = entry.metadata;
+    if (!cached)
+        metadata.cutOut = (double)lengthInSamples / reader->sampleRate;
+    metadata.hash = contentKey;
+
+    juce::MemoryBlock builtThumbnailData;
+    lod.saveTo(builtThumbnailData);
+    return analysisCache.store(contentKey, metadata, index.get()) &&
+           analysisCache.storeThumbnailData(contentKey, builtThumbnailData);
+}
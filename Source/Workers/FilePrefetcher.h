@@ -0,0 +1,81 @@
+#ifndef AUDIOFILER_FILEPREFETCHER_H
+#define AUDIOFILER_FILEPREFETCHER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+class AnalysisCache;
+
+/**
+ * @file FilePrefetcher.h
+ * @ingroup Threading
+ * @brief Background thread that prepares the next files of the playlist before they are opened.
+ * @details For every queued file, in order, it does the work a load would otherwise start
+ *          from zero:
+ *
+ *          - opens a private reader through `AudioReaderFactory`, which parses the header;
+ *          - computes the file's `ContentFingerprint`;
+ *          - on an AnalysisCache miss, decodes the file once into an EnvelopeIndex and a
+ *            WaveformLod and stores both. The decode also leaves the file in the page cache.
+ *
+ *          Loading a prefetched file then finds its envelope and waveform in the cache, and
+ *          its In/Out analysis reads a single envelope block instead of the audio.
+ *
+ *          Decodes run at background priority under `ScanPolicy::TimeBudgeted`, so the current
+ *          file's playback and analysis keep the CPU. A new queue replaces the old one; the
+ *          file being prepared is abandoned at its next chunk unless it is still queued.
+ *
+ * @see Playlist
+ * @see AnalysisCache
+ * @see EnvelopeBuilder
+ */
+class FilePrefetcher : private juce::Thread {
+  public:
+    FilePrefetcher(juce::AudioFormatManager &formatManager, const AnalysisCache &analysisCache);
+
+    ~FilePrefetcher() override;
+
+    /** @brief Replaces the queue with `files`, nearest first. Message thread. */
+    void prefetch(const juce::Array<juce::File> &files);
+
+    /** @brief Empties the queue and abandons the file being prepared. */
+    void cancel();
+
+    /** @brief True once `file` is in the cache, prepared by this prefetcher. Any thread. */
+    bool isPrefetched(const juce::File &file) const;
+
+    /** @brief True while files are queued or being prepared. Any thread. */
+    bool isBusy() const;
+
+    /**
+     * @brief Prepares one file on the calling thread.
+     * @return False if the file cannot be read or `shouldStop` returned true.
+     */
+    bool prefetchFile(const juce::File &file, const std::function<bool()> &shouldStop) const;
+
+  private:
+    void run() override;
+
+    juce::AudioFormatManager &formatManager;
+    const AnalysisCache &analysisCache;
+
+    mutable std::mutex queueMutex;
+    juce::Array<juce::File> queue;
+    juce::File running;
+    juce::Array<juce::File> prefetched;
+    /** Bumped when the running file drops out of the queue; checked between chunks. */
+    std::atomic<juce::uint32> generation{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FilePrefetcher)
+};
+
+#endif
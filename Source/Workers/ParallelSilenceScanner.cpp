@@ -0,0 +1,134 @@
+#include "Workers/ParallelSilenceScanner.h"
+#include "Utils/Config.h"
+#include "Workers/ScanScheduler.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+#include <atomic>
+#include <limits>
+
+namespace {
+constexpr int kWaitSliceMs = 20;
+
+/** Shared by the caller and every job; outlives whichever finishes last. */
+struct ScanState {
+    std::atomic<juce::int64> best{-1};
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> remaining{0};
+    juce::WaitableEvent finished{true};
+};
+
+/** Lowers (In) or raises (Out) the shared best hit. */
+void publishHit(ScanState &state, juce::int64 hit, bool forward) {
+    juce::int64 current = state.best.load();
+    while (forward ? hit < current : hit > current) {
+        if (state.best.compare_exchange_weak(current, hit))
+            break;
+    }
+}
+
+/** True once another segment's hit makes this one irrelevant. */
+bool isSuperseded(const ScanState &state, juce::Range<juce::int64> segment, bool forward) {
+    const juce::int64 best = state.best.load();
+    return forward ? best < segment.getStart() : best >= segment.getEnd();
+}
+} // namespace
+
+ParallelSilenceScanner::ParallelSilenceScanner(juce::ThreadPool &poolIn,
+                                               ReaderFactory createReaderIn,
+                                               AppEnums::ScanPolicy policyIn)
+    : pool(poolIn), createReader(std::move(createReaderIn)), policy(policyIn) {
+}
+
+juce::int64 ParallelSilenceScanner::findSilenceIn(float threshold,
+                                                  const std::function<bool()> &shouldExit) {
+    return scan(threshold, true, shouldExit);
+}
+
+juce::int64 ParallelSilenceScanner::findSilenceOut(float threshold,
+                                                   const std::function<bool()> &shouldExit) {
+    return scan(threshold, false, shouldExit);
+}
+
+std::vector<juce::Range<juce::int64>>
+ParallelSilenceScanner::makeSegments(juce::int64 lengthInSamples, int numThreads) {
+    std::vector<juce::Range<juce::int64>> segments;
+    if (lengthInSamples <= 0)
+        return segments;
+
+    // Several segments per thread, so a hit cancels most of the remaining work.
+    const juce::int64 maxSegments =
+        (juce::int64)juce::jmax(1, numThreads) * Config::Audio::parallelScanSegmentsPerThread;
+    const juce::int64 numSegments =
+        juce::jlimit((juce::int64)1, maxSegments,
+                     lengthInSamples / Config::Audio::parallelScanMinSegmentSamples);
+
+    for (juce::int64 i = 0; i < numSegments; ++i)
+        segments.push_back({lengthInSamples * i / numSegments,
+                            lengthInSamples * (i + 1) / numSegments});
+    return segments;
+}
+
+juce::int64 ParallelSilenceScanner::scan(float threshold, bool forward,
+                                         const std::function<bool()> &shouldExit) {
+    auto probe = createReader();
+    if (probe == nullptr)
+        return -1;
+
+    const auto segments = makeSegments(probe->lengthInSamples, pool.getNumThreads());
+    if (segments.size() <= 1) {
+        ScanScheduler scheduler(policy, shouldExit);
+        return forward ? SilenceAnalysisAlgorithms::findSilenceIn(*probe, threshold, &scheduler)
+                       : SilenceAnalysisAlgorithms::findSilenceOut(*probe, threshold, &scheduler);
+    }
+    probe.reset();
+
+    auto state = std::make_shared<ScanState>();
+    state->best = forward ? std::numeric_limits<juce::int64>::max() : (juce::int64)-1;
+    state->remaining = (int)segments.size();
+
+    for (size_t n = 0; n < segments.size(); ++n) {
+        const auto segment = forward ? segments[n] : segments[segments.size() - 1 - n];
+
+        // The caller waits for every job, so segments may consult its predicate directly and
+        // stop at their next chunk instead of at the caller's next wait slice.
+        pool.addJob([state, segment, forward, threshold, factory = createReader,
+                     scanPolicy = policy, &shouldExit] {
+            const auto stop = [&state, &shouldExit, segment, forward] {
+                if (state->cancelled.load() || isSuperseded(*state, segment, forward))
+                    return true;
+                if (shouldExit != nullptr && shouldExit()) {
+                    state->cancelled = true;
+                    return true;
+                }
+                return false;
+            };
+
+            if (!stop()) {
+                if (auto reader = factory()) {
+                    ScanScheduler scheduler(scanPolicy, stop);
+                    const juce::int64 hit =
+                        forward ? SilenceAnalysisAlgorithms::findFirstAboveInRange(
+                                      *reader, threshold, segment, &scheduler)
+                                : SilenceAnalysisAlgorithms::findLastAboveInRange(
+                                      *reader, threshold, segment, &scheduler);
+                    if (hit >= 0)
+                        publishHit(*state, hit, forward);
+                }
+            }
+
+            if (--state->remaining == 0)
+                state->finished.signal();
+        });
+    }
+
+    while (!state->finished.wait(kWaitSliceMs)) {
+        if (shouldExit != nullptr && shouldExit())
+            state->cancelled = true;
+    }
+
+    if (state->cancelled.load())
+        return -1;
+
+    const juce::int64 best = state->best.load();
+    return forward && best == std::numeric_limits<juce::int64>::max() ? -1 : best;
+}
@@ -0,0 +1,67 @@
+#ifndef AUDIOFILER_PARALLELSILENCESCANNER_H
+#define AUDIOFILER_PARALLELSILENCESCANNER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/AppEnums.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @ingroup Threading
+ * @class ParallelSilenceScanner
+ * @brief Runs the silence In/Out scans over file segments on a thread pool.
+ * @details The file is cut into segments of at least
+ *          `Config::Audio::parallelScanMinSegmentSamples`, a few per pool thread, and queued
+ *          in scan order (front-to-back for In, back-to-front for Out). Every job opens its own
+ *          reader through the factory, so the Threading Law holds; with mapped readers all
+ *          jobs share the page cache.
+ *
+ *          The best hit so far is kept in an atomic. A segment that can no longer beat it
+ *          (for In, one starting after the hit; for Out, one ending before it) stops at its
+ *          next checkpoint, or is skipped if it has not started yet. Earlier segments keep
+ *          going, so the result is exactly the serial one.
+ *
+ * @see SilenceAnalysisAlgorithms
+ * @see ScanScheduler
+ */
+class ParallelSilenceScanner {
+  public:
+    /** @brief Opens a fresh, private reader of the file being scanned. */
+    using ReaderFactory = std::function<std::unique_ptr<juce::AudioFormatReader>()>;
+
+    ParallelSilenceScanner(juce::ThreadPool &pool, ReaderFactory createReader,
+                           AppEnums::ScanPolicy policy = AppEnums::ScanPolicy::FullSpeed);
+
+    /**
+     * @brief Parallel equivalent of SilenceAnalysisAlgorithms::findSilenceIn().
+     * @param shouldExit Checked by every segment once per chunk, so it must be thread-safe;
+     *                   returning true cancels all segments.
+     * @return The first sample above the threshold, or -1 if none or cancelled.
+     */
+    juce::int64 findSilenceIn(float threshold, const std::function<bool()> &shouldExit = {});
+
+    /** @brief Parallel equivalent of SilenceAnalysisAlgorithms::findSilenceOut(). */
+    juce::int64 findSilenceOut(float threshold, const std::function<bool()> &shouldExit = {});
+
+    /** @brief The segments a file of `lengthInSamples` is cut into for `numThreads` workers. */
+    static std::vector<juce::Range<juce::int64>> makeSegments(juce::int64 lengthInSamples,
+                                                              int numThreads);
+
+  private:
+    juce::int64 scan(float threshold, bool forward, const std::function<bool()> &shouldExit);
+
+    juce::ThreadPool &pool;
+    ReaderFactory createReader;
+    AppEnums::ScanPolicy policy;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelSilenceScanner)
+};
+
+#endif
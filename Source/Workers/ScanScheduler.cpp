@@ -0,0 +1,39 @@
+#include "Workers/ScanScheduler.h"
+#include "Utils/Config.h"
+
+#include <utility>
+
+ScanScheduler::ScanScheduler(AppEnums::ScanPolicy policyIn, std::function<bool()> exitCheck)
+    : policy(policyIn), shouldExit(std::move(exitCheck)) {
+    budgetTicks =
+        juce::Time::secondsToHighResolutionTicks(Config::Audio::scanTimeBudgetMs / 1000.0);
+    sliceStartTicks = juce::Time::getHighResolutionTicks();
+}
+
+bool ScanScheduler::checkpoint() {
+    if (shouldExit != nullptr && shouldExit())
+        return true;
+
+    if (policy == AppEnums::ScanPolicy::TimeBudgeted) {
+        const juce::int64 now = juce::Time::getHighResolutionTicks();
+        if (now - sliceStartTicks >= budgetTicks) {
+            juce::Thread::yield();
+            ++numYields;
+            sliceStartTicks = juce::Time::getHighResolutionTicks();
+        }
+    }
+
+    return false;
+}
+
+juce::Thread::Priority ScanScheduler::priorityFor(AppEnums::ScanPolicy policy) {
+    switch (policy) {
+    case AppEnums::ScanPolicy::FullSpeed:
+        return juce::Thread::Priority::normal;
+    case AppEnums::ScanPolicy::Background:
+        return juce::Thread::Priority::background;
+    case AppEnums::ScanPolicy::TimeBudgeted:
+        return juce::Thread::Priority::low;
+    }
+    return juce::Thread::Priority::normal;
+}
@@ -0,0 +1,56 @@
+#ifndef AUDIOFILER_SCANSCHEDULER_H
+#define AUDIOFILER_SCANSCHEDULER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Core/AppEnums.h"
+#include <functional>
+
+/**
+ * @ingroup Threading
+ * @class ScanScheduler
+ * @brief Cooperative scheduling policy for long-running sample scans.
+ * @details Scanners call checkpoint() once per chunk. The scheduler never sleeps: it checks
+ *          the cancellation predicate and, under `ScanPolicy::TimeBudgeted`, yields the
+ *          remainder of the time slice once the configured budget has been used. Staying out
+ *          of the audio thread's way is otherwise left to the OS via priorityFor().
+ *
+ * @see SilenceAnalysisAlgorithms
+ */
+class ScanScheduler {
+  public:
+    /**
+     * @param policy The scheduling policy to apply at each checkpoint.
+     * @param shouldExit Cancellation predicate, typically `threadShouldExit()` of the caller.
+     */
+    ScanScheduler(AppEnums::ScanPolicy policy, std::function<bool()> shouldExit);
+
+    /**
+     * @brief Called by scanners between chunks.
+     * @return True if the scan should be abandoned.
+     */
+    bool checkpoint();
+
+    /** @brief Returns the OS thread priority a worker running this policy should use. */
+    static juce::Thread::Priority priorityFor(AppEnums::ScanPolicy policy);
+
+    /** @brief Number of times the time budget forced a yield (for diagnostics). */
+    int getNumYields() const {
+        return numYields;
+    }
+
+  private:
+    AppEnums::ScanPolicy policy;
+    std::function<bool()> shouldExit;
+    juce::int64 budgetTicks{0};
+    juce::int64 sliceStartTicks{0};
+    int numYields{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScanScheduler)
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include "Workers/SilenceAnalysisAlgorithms.h"
+#include "Core/EnvelopeIndex.h"
+#include "Utils/Config.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -7,75 +9,218 @@ namespace {
 constexpr int kChunkSize = 65536;
 
 constexpr int kMaxChannels = 128;
+
+/** Samples per min/max rejection block; small enough to stay in L1, large enough to amortise. */
+constexpr int kScanBlockSize = 1024;
+
+bool blockExceeds(const float *samples, int numSamples, float threshold) {
+    const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+    return range.getEnd() > threshold || range.getStart() < -threshold;
+}
 } // namespace
 
+int SilenceAnalysisAlgorithms::findFirstAboveThreshold(const float *samples, int numSamples,
+                                                       float threshold) {
+    for (int blockStart = 0; blockStart < numSamples; blockStart += kScanBlockSize) {
+        const int blockLength = std::min(kScanBlockSize, numSamples - blockStart);
+        if (!blockExceeds(samples + blockStart, blockLength, threshold))
+            continue;
+
+        for (int i = blockStart; i < blockStart + blockLength; ++i) {
+            if (std::abs(samples[i]) > threshold)
+                return i;
+        }
+    }
+    return -1;
+}
+
+int SilenceAnalysisAlgorithms::findLastAboveThreshold(const float *samples, int numSamples,
+                                                      float threshold) {
+    for (int blockEnd = numSamples; blockEnd > 0; blockEnd -= kScanBlockSize) {
+        const int blockStart = std::max(0, blockEnd - kScanBlockSize);
+        if (!blockExceeds(samples + blockStart, blockEnd - blockStart, threshold))
+            continue;
+
+        for (int i = blockEnd - 1; i >= blockStart; --i) {
+            if (std::abs(samples[i]) > threshold)
+                return i;
+        }
+    }
+    return -1;
+}
+
 juce::int64 SilenceAnalysisAlgorithms::findSilenceIn(juce::AudioFormatReader &reader,
-                                                     float threshold, juce::Thread *thread) {
-    const juce::int64 lengthInSamples = reader.lengthInSamples;
+                                                     float threshold,
+                                                     ScanScheduler *scheduler) {
+    return findFirstAboveInRange(reader, threshold, {0, reader.lengthInSamples}, scheduler);
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceOut(juce::AudioFormatReader &reader,
+                                                      float threshold,
+                                                      ScanScheduler *scheduler) {
+    return findLastAboveInRange(reader, threshold, {0, reader.lengthInSamples}, scheduler);
+}
+
+juce::int64 SilenceAnalysisAlgorithms::cutOutWithTail(juce::int64 lastAudibleSample,
+                                                      double sampleRate,
+                                                      juce::int64 lengthInSamples) {
+    const auto tailSamples = (juce::int64)(sampleRate * Config::Audio::silenceOutTailSeconds);
+    return std::min(lastAudibleSample + tailSamples, lengthInSamples);
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findFirstAboveInRange(juce::AudioFormatReader &reader,
+                                                             float threshold,
+                                                             juce::Range<juce::int64> range,
+                                                             ScanScheduler *scheduler) {
+    range = range.getIntersectionWith({0, reader.lengthInSamples});
 
     if (reader.numChannels <= 0 || reader.numChannels > kMaxChannels)
         return -1;
 
     juce::AudioBuffer<float> buffer(reader.numChannels, kChunkSize);
 
-    juce::int64 currentPos = 0;
-    while (currentPos < lengthInSamples) {
+    juce::int64 currentPos = range.getStart();
+    while (currentPos < range.getEnd()) {
         const int numThisTime =
-            (int)std::min((juce::int64)kChunkSize, lengthInSamples - currentPos);
-        buffer.clear();
+            (int)std::min((juce::int64)kChunkSize, range.getEnd() - currentPos);
         if (!reader.read(&buffer, 0, numThisTime, currentPos, true, true))
             return -1;
 
-        if (thread != nullptr) {
-            if (thread->threadShouldExit())
-                return -1;
-            thread->wait(1);
-        }
+        if (scheduler != nullptr && scheduler->checkpoint())
+            return -1;
 
-        for (int sample = 0; sample < numThisTime; ++sample) {
-            for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-                if (std::abs(buffer.getSample(channel, sample)) > threshold) {
-                    return currentPos + sample;
-                }
-            }
+        // Each channel only needs to beat the earliest hit found on the previous ones.
+        int earliest = -1;
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+            const int scanLength = earliest < 0 ? numThisTime : earliest;
+            const int hit = findFirstAboveThreshold(buffer.getReadPointer(channel), scanLength,
+                                                    threshold);
+            if (hit >= 0)
+                earliest = hit;
         }
+
+        if (earliest >= 0)
+            return currentPos + earliest;
+
         currentPos += numThisTime;
     }
     return -1;
 }
 
-juce::int64 SilenceAnalysisAlgorithms::findSilenceOut(juce::AudioFormatReader &reader,
-                                                      float threshold, juce::Thread *thread) {
-    const juce::int64 lengthInSamples = reader.lengthInSamples;
+juce::int64 SilenceAnalysisAlgorithms::findLastAboveInRange(juce::AudioFormatReader &reader,
+                                                            float threshold,
+                                                            juce::Range<juce::int64> range,
+                                                            ScanScheduler *scheduler) {
+    range = range.getIntersectionWith({0, reader.lengthInSamples});
 
     if (reader.numChannels <= 0 || reader.numChannels > kMaxChannels)
         return -1;
 
     juce::AudioBuffer<float> buffer(reader.numChannels, kChunkSize);
 
-    juce::int64 currentPos = lengthInSamples;
-    while (currentPos > 0) {
-        const int numThisTime = (int)std::min((juce::int64)kChunkSize, currentPos);
+    juce::int64 currentPos = range.getEnd();
+    while (currentPos > range.getStart()) {
+        const int numThisTime =
+            (int)std::min((juce::int64)kChunkSize, currentPos - range.getStart());
         const juce::int64 startSample = currentPos - numThisTime;
 
-        buffer.clear();
         if (!reader.read(&buffer, 0, numThisTime, startSample, true, true))
             return -1;
 
-        if (thread != nullptr) {
-            if (thread->threadShouldExit())
-                return -1;
-            thread->wait(1);
-        }
+        if (scheduler != nullptr && scheduler->checkpoint())
+            return -1;
+
+        // Each channel only needs to scan the tail beyond the latest hit found so far.
+        int latest = -1;
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+            const int scanStart = latest + 1;
+            if (scanStart >= numThisTime)
+                break;
 
-        for (int sample = numThisTime - 1; sample >= 0; --sample) {
-            for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-                if (std::abs(buffer.getSample(channel, sample)) > threshold) {
-                    return startSample + sample;
-                }
-            }
+            const int hit = findLastAboveThreshold(buffer.getReadPointer(channel, scanStart),
+                                                   numThisTime - scanStart, threshold);
+            if (hit >= 0)
+                latest = scanStart + hit;
         }
+
+        if (latest >= 0)
+            return startSample + latest;
+
         currentPos -= numThisTime;
     }
     return -1;
 }
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceIn(const EnvelopeIndex &envelope,
+                                                     juce::AudioFormatReader &reader,
+                                                     float threshold) {
+    const juce::int64 block = envelope.findFirstBlockAbove(threshold);
+    if (block < 0)
+        return -1;
+
+    const int blockSize = envelope.getBlockSize(0);
+    const juce::int64 startSample = block * blockSize;
+    const int numSamples = (int)juce::jmin((juce::int64)blockSize,
+                                           reader.lengthInSamples - startSample);
+    if (reader.numChannels <= 0 || reader.numChannels > kMaxChannels)
+        return -1;
+    if (numSamples <= 0)
+        return envelopeMismatch;
+
+    juce::AudioBuffer<float> buffer(reader.numChannels, blockSize);
+    if (!reader.read(&buffer, 0, numSamples, startSample, true, true))
+        return -1;
+
+    int earliest = -1;
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+        const int scanLength = earliest < 0 ? numSamples : earliest;
+        const int hit =
+            findFirstAboveThreshold(buffer.getReadPointer(channel), scanLength, threshold);
+        if (hit >= 0)
+            earliest = hit;
+    }
+
+    // The envelope and the reader disagree (e.g. a stale cache entry for a changed file).
+    if (earliest < 0)
+        return envelopeMismatch;
+
+    return startSample + earliest;
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceOut(const EnvelopeIndex &envelope,
+                                                      juce::AudioFormatReader &reader,
+                                                      float threshold) {
+    const juce::int64 block = envelope.findLastBlockAbove(threshold);
+    if (block < 0)
+        return -1;
+
+    const int blockSize = envelope.getBlockSize(0);
+    const juce::int64 startSample = block * blockSize;
+    const int numSamples = (int)juce::jmin((juce::int64)blockSize,
+                                           reader.lengthInSamples - startSample);
+    if (reader.numChannels <= 0 || reader.numChannels > kMaxChannels)
+        return -1;
+    if (numSamples <= 0)
+        return envelopeMismatch;
+
+    juce::AudioBuffer<float> buffer(reader.numChannels, blockSize);
+    if (!reader.read(&buffer, 0, numSamples, startSample, true, true))
+        return -1;
+
+    int latest = -1;
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+        const int scanStart = latest + 1;
+        if (scanStart >= numSamples)
+            break;
+
+        const int hit = findLastAboveThreshold(buffer.getReadPointer(channel, scanStart),
+                                               numSamples - scanStart, threshold);
+        if (hit >= 0)
+            latest = scanStart + hit;
+    }
+
+    if (latest < 0)
+        return envelopeMismatch;
+
+    return startSample + latest;
+}
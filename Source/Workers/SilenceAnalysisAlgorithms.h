@@ -9,6 +9,10 @@
 #include <JuceHeader.h>
 #endif
 
+#include "Workers/ScanScheduler.h"
+
+class EnvelopeIndex;
+
 /**
  * @ingroup AudioEngine
  * @class SilenceAnalysisAlgorithms
@@ -19,34 +23,113 @@
  */
 class SilenceAnalysisAlgorithms {
   public:
+    /** @brief Returned by the envelope variants when the envelope does not describe `reader`. */
+    static constexpr juce::int64 envelopeMismatch = -2;
+
     /**
      * @brief Finds the first non-silent sample from the start of the file.
      * @details This function scans the audio file in chunks (typically 65536 samples)
      *          to find the point where the amplitude exceeds the given threshold.
-     *          It processes channels independently and takes the earliest occurrence.
+     *          Each channel is scanned contiguously with the vectorised kernel and the
+     *          earliest occurrence across channels wins; later channels only scan up to
+     *          the best hit found so far.
      *
      * @param reader The audio reader for the file.
      * @param threshold The amplitude threshold (0.0 to 1.0).
-     * @param thread Optional pointer to the calling thread to check for cancellation
-     * (`thread->threadShouldExit()`).
+     * @param scheduler Optional scheduler consulted once per chunk for cancellation and
+     * yielding.
      * @return The sample index of the start of the audio, or 0 if not found.
      */
     static juce::int64 findSilenceIn(juce::AudioFormatReader &reader, float threshold,
-                                     juce::Thread *thread = nullptr);
+                                     ScanScheduler *scheduler = nullptr);
 
     /**
      * @brief Finds the last non-silent sample from the end of the file.
      * @details This function scans the audio file backwards in chunks. This approach is
      *          critical for memory safety when handling very large files, as it avoids
-     *          allocating a buffer for the entire file.
+     *          allocating a buffer for the entire file. Channels are merged by taking the
+     *          latest occurrence, mirroring findSilenceIn().
      *
      * @param reader The audio reader for the file.
      * @param threshold The amplitude threshold (0.0 to 1.0).
-     * @param thread Optional pointer to the calling thread to check for cancellation.
+     * @param scheduler Optional scheduler consulted once per chunk.
      * @return The sample index of the end of the audio, or the file length if not found.
      */
     static juce::int64 findSilenceOut(juce::AudioFormatReader &reader, float threshold,
-                                      juce::Thread *thread = nullptr);
+                                      ScanScheduler *scheduler = nullptr);
+
+    /**
+     * @brief Returns the first sample inside `range` whose magnitude exceeds the threshold.
+     * @details The building block of findSilenceIn(); `ParallelSilenceScanner` runs it on
+     *          independent segments of the file.
+     * @return The absolute sample index, or -1 if none (or the scan was cancelled).
+     */
+    static juce::int64 findFirstAboveInRange(juce::AudioFormatReader &reader, float threshold,
+                                             juce::Range<juce::int64> range,
+                                             ScanScheduler *scheduler = nullptr);
+
+    /**
+     * @brief Returns the last sample inside `range` whose magnitude exceeds the threshold.
+     * @details Mirror of findFirstAboveInRange(), scanning backwards from the end of `range`.
+     */
+    static juce::int64 findLastAboveInRange(juce::AudioFormatReader &reader, float threshold,
+                                            juce::Range<juce::int64> range,
+                                            ScanScheduler *scheduler = nullptr);
+
+    /**
+     * @brief Envelope-accelerated variant of findSilenceIn().
+     * @details Walks the coarse envelope to the single base block that contains the first
+     *          crossing and decodes only that block, so re-running at a new threshold costs
+     *          one small read instead of a full decode.
+     *
+     * @param envelope A finished envelope built from the same file as `reader`.
+     * @param reader The audio reader for the file.
+     * @param threshold The amplitude threshold (0.0 to 1.0).
+     * @return The sample index of the start of the audio, -1 if not found, or
+     *         envelopeMismatch if the block the envelope points at holds no such sample. The
+     *         caller then rescans the file itself, so that scan stays cancellable.
+     */
+    static juce::int64 findSilenceIn(const EnvelopeIndex &envelope,
+                                     juce::AudioFormatReader &reader, float threshold);
+
+    /**
+     * @brief Envelope-accelerated variant of findSilenceOut().
+     * @see findSilenceIn(const EnvelopeIndex &, juce::AudioFormatReader &, float)
+     */
+    static juce::int64 findSilenceOut(const EnvelopeIndex &envelope,
+                                      juce::AudioFormatReader &reader, float threshold);
+
+    /**
+     * @brief Turns the last audible sample into a cut-out position.
+     * @details Keeps `Config::Audio::silenceOutTailSeconds` of decay after the last audible
+     *          sample so the cut does not clip a fading tail, clamped to the file length.
+     */
+    static juce::int64 cutOutWithTail(juce::int64 lastAudibleSample, double sampleRate,
+                                      juce::int64 lengthInSamples);
+
+    /**
+     * @brief Returns the index of the first sample whose magnitude exceeds the threshold.
+     * @details Rejects whole sub-blocks with `juce::FloatVectorOperations::findMinAndMax`
+     *          (SIMD on every platform JUCE supports) and only falls back to a scalar scan
+     *          inside the sub-block that actually contains the crossing.
+     *
+     * @param samples Contiguous samples of a single channel.
+     * @param numSamples Number of samples to scan.
+     * @param threshold The amplitude threshold (0.0 to 1.0).
+     * @return The index of the first sample with |x| > threshold, or -1 if none.
+     */
+    static int findFirstAboveThreshold(const float *samples, int numSamples, float threshold);
+
+    /**
+     * @brief Returns the index of the last sample whose magnitude exceeds the threshold.
+     * @details Mirror of findFirstAboveThreshold(), walking sub-blocks from the end.
+     *
+     * @param samples Contiguous samples of a single channel.
+     * @param numSamples Number of samples to scan.
+     * @param threshold The amplitude threshold (0.0 to 1.0).
+     * @return The index of the last sample with |x| > threshold, or -1 if none.
+     */
+    static int findLastAboveThreshold(const float *samples, int numSamples, float threshold);
 };
 
 #endif
@@ -0,0 +1,116 @@
+#include "Core/AnalysisCache.h"
+#include "Core/EnvelopeIndex.h"
+#include "Utils/Config.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+class AnalysisCacheTest : public juce::UnitTest {
+  public:
+    AnalysisCacheTest() : juce::UnitTest("Analysis Cache Testing") {
+    }
+
+    void runTest() override {
+        const juce::File directory =
+            juce::File::getSpecialLocation(juce::File::tempDirectory)
+                .getChildFile("audiofiler_analysis_cache_test");
+        directory.deleteRecursively();
+
+        const int length = Config::Audio::envelopeBaseBlockSize * 40 + 11;
+        juce::AudioBuffer<float> buffer(2, length);
+        buffer.clear();
+        buffer.setSample(0, Config::Audio::envelopeBaseBlockSize * 7 + 5, 0.6f);
+        buffer.setSample(1, length - 1, -0.3f);
+
+        EnvelopeIndex envelope(2, length, 44100.0);
+        envelope.addBlock(0, buffer, length);
+        envelope.finalise();
+
+        FileMetadata metadata;
+        metadata.cutIn = 1.25;
+        metadata.cutOut = 3.5;
+        metadata.isAnalyzed = true;
+
+        AnalysisCache cache(directory);
+        const juce::String key = "00112233aabbccdd";
+
+        beginTest("Round trip of metadata and envelope");
+        {
+            metadata.hash = key;
+            expect(cache.store(key, metadata, &envelope));
+
+            AnalysisCache::Entry entry;
+            expect(cache.load(key, entry));
+            expectEquals(entry.metadata.cutIn, 1.25);
+            expectEquals(entry.metadata.cutOut, 3.5);
+            expect(entry.metadata.isAnalyzed);
+            expect(entry.metadata.hash == key);
+
+            expect(entry.envelope != nullptr);
+            if (entry.envelope != nullptr) {
+                expect(entry.envelope->isComplete());
+                expectEquals(entry.envelope->getNumChannels(), 2);
+                expectEquals(entry.envelope->getLengthInSamples(), (juce::int64)length);
+                expectEquals(entry.envelope->findFirstBlockAbove(0.5f), (juce::int64)7);
+                expectEquals(entry.envelope->findLastBlockAbove(0.2f),
+                             envelope.getNumBlocks(0) - 1);
+                expectEquals((int)entry.envelope->getRawDataSize(),
+                             (int)envelope.getRawDataSize());
+            }
+        }
+
+        beginTest("Metadata update keeps the envelope");
+        {
+            FileMetadata edited = metadata;
+            edited.cutIn = 2.0;
+            edited.isAnalyzed = false;
+            expect(cache.storeMetadata(key, edited));
+
+            AnalysisCache::Entry entry;
+            expect(cache.load(key, entry));
+            expectEquals(entry.metadata.cutIn, 2.0);
+            expect(!entry.metadata.isAnalyzed);
+            expect(entry.envelope != nullptr);
+        }
+
+        beginTest("Metadata-only entry");
+        {
+            const juce::String otherKey = "ffeeddccbbaa9988";
+            expect(cache.storeMetadata(otherKey, metadata));
+
+            AnalysisCache::Entry entry;
+            expect(cache.load(otherKey, entry));
+            expectEquals(entry.metadata.cutOut, 3.5);
+            expect(entry.envelope == nullptr);
+        }
+
+        beginTest("Missing and corrupt entries are misses");
+        {
+            AnalysisCache::Entry entry;
+            expect(!cache.load("0000000000000000", entry));
+            expect(!cache.load({}, entry));
+
+            // An entry renamed to another key must not be served for it.
+            const juce::String strayKey = "1234567812345678";
+            expect(cache.getEntryFile(key).moveFileTo(cache.getEntryFile(strayKey)));
+            expect(!cache.load(strayKey, entry));
+
+            const char garbage[] = "not a cache file";
+            expect(cache.getEntryFile(key).replaceWithData(garbage, sizeof(garbage)));
+            expect(!cache.load(key, entry));
+        }
+
+        beginTest("Thumbnail blob round trip");
+        {
+            const char blob[] = {1, 2, 3, 4, 5};
+            expect(cache.storeThumbnailData(key, juce::MemoryBlock(blob, sizeof(blob))));
+
+            juce::MemoryBlock loaded;
+            expect(cache.loadThumbnailData(key, loaded));
+            expectEquals((int)loaded.getSize(), (int)sizeof(blob));
+        }
+
+        directory.deleteRecursively();
+    }
+};
+
+static AnalysisCacheTest analysisCacheTest;
@@ -0,0 +1,249 @@
+#include "Core/AnalysisService.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace {
+// Silent mono reader with a single spike at `spikePosition`.
+class ImpulseMockReader : public juce::AudioFormatReader {
+  public:
+    ImpulseMockReader(juce::int64 length, juce::int64 spikePositionIn)
+        : juce::AudioFormatReader(nullptr, "ImpulseMockReader"), spikePosition(spikePositionIn) {
+        lengthInSamples = length;
+        numChannels = 1;
+        sampleRate = 44100.0;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        for (int ch = 0; ch < numDestChannels; ++ch) {
+            if (destSamples[ch] == nullptr)
+                continue;
+            float *dest = (float *)destSamples[ch] + startOffsetInDestBuffer;
+            juce::FloatVectorOperations::clear(dest, numSamples);
+            if (spikePosition >= startSampleInFile &&
+                spikePosition < startSampleInFile + numSamples)
+                dest[spikePosition - startSampleInFile] = 0.5f;
+        }
+        return true;
+    }
+
+  private:
+    juce::int64 spikePosition;
+};
+
+// Silent reader that takes a millisecond per read, to make a full scan slow.
+class SlowSilentMockReader : public juce::AudioFormatReader {
+  public:
+    explicit SlowSilentMockReader(juce::int64 length)
+        : juce::AudioFormatReader(nullptr, "SlowSilentMockReader") {
+        lengthInSamples = length;
+        numChannels = 1;
+        sampleRate = 44100.0;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64, int numSamples) override {
+        juce::Thread::sleep(1);
+        for (int ch = 0; ch < numDestChannels; ++ch)
+            if (destSamples[ch] != nullptr)
+                juce::FloatVectorOperations::clear((float *)destSamples[ch] +
+                                                       startOffsetInDestBuffer,
+                                                   numSamples);
+        return true;
+    }
+};
+
+struct Collector {
+    void add(const AnalysisService::Result &result) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(result);
+        }
+        arrived.signal();
+    }
+
+    std::vector<AnalysisService::Result> snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return results;
+    }
+
+    std::mutex mutex;
+    std::vector<AnalysisService::Result> results;
+    juce::WaitableEvent arrived;
+};
+} // namespace
+
+class AnalysisServiceTest : public juce::UnitTest {
+  public:
+    AnalysisServiceTest() : juce::UnitTest("Analysis Service Testing") {
+    }
+
+    void runTest() override {
+        const juce::int64 length = 200000;
+        const juce::int64 spike = 12345;
+        const juce::File file("/virtual/analysis_service_test.wav");
+
+        beginTest("In and Out requests both complete");
+        {
+            AnalysisService service(
+                [=](const juce::File &) {
+                    return std::make_unique<ImpulseMockReader>(length, spike);
+                },
+                {}, AnalysisService::Delivery::WorkerThread);
+            Collector collector;
+
+            expect(service.submit({file, AnalysisService::Kind::SilenceIn, 0.1f},
+                                  [&](const auto &result) { collector.add(result); }));
+            expect(service.submit({file, AnalysisService::Kind::SilenceOut, 0.1f},
+                                  [&](const auto &result) { collector.add(result); }));
+
+            expect(waitForResults(collector, 2));
+            bool sawIn = false, sawOut = false;
+            for (const auto &result : collector.snapshot()) {
+                expect(result.readerOpened);
+                expectEquals(result.lengthInSamples, length);
+                expectEquals(result.sample, spike);
+                sawIn |= result.request.kind == AnalysisService::Kind::SilenceIn;
+                sawOut |= result.request.kind == AnalysisService::Kind::SilenceOut;
+            }
+            expect(sawIn && sawOut);
+            expect(!service.isBusy());
+        }
+
+        beginTest("Identical pending requests are deduplicated");
+        {
+            juce::WaitableEvent gate(true);
+            AnalysisService service(
+                [&](const juce::File &) {
+                    gate.wait(5000);
+                    return std::make_unique<ImpulseMockReader>(length, spike);
+                },
+                {}, AnalysisService::Delivery::WorkerThread);
+            Collector collector;
+            const AnalysisService::Request request{file, AnalysisService::Kind::SilenceIn, 0.2f};
+
+            expect(service.submit(request, [&](const auto &result) { collector.add(result); }));
+            expect(!service.submit(request, [&](const auto &result) { collector.add(result); }));
+            expect(service.isBusy(AnalysisService::Kind::SilenceIn));
+            expect(!service.isBusy(AnalysisService::Kind::SilenceOut));
+
+            gate.signal();
+            expect(waitForResults(collector, 1));
+            juce::Thread::sleep(50);
+            expectEquals((int)collector.snapshot().size(), 1);
+        }
+
+        beginTest("A new threshold supersedes the pending request");
+        {
+            juce::WaitableEvent gate(true);
+            AnalysisService service(
+                [&](const juce::File &) {
+                    gate.wait(5000);
+                    return std::make_unique<ImpulseMockReader>(length, spike);
+                },
+                {}, AnalysisService::Delivery::WorkerThread);
+            Collector collector;
+
+            expect(service.submit({file, AnalysisService::Kind::SilenceIn, 0.2f},
+                                  [&](const auto &result) { collector.add(result); }));
+            expect(service.submit({file, AnalysisService::Kind::SilenceIn, 0.3f},
+                                  [&](const auto &result) { collector.add(result); }));
+
+            gate.signal();
+            expect(waitForResults(collector, 1));
+            juce::Thread::sleep(50);
+
+            const auto results = collector.snapshot();
+            expectEquals((int)results.size(), 1);
+            expectEquals(results.front().request.threshold, 0.3f);
+            expectEquals(results.front().generation,
+                         service.getGeneration(AnalysisService::Kind::SilenceIn));
+        }
+
+        beginTest("A superseded scan stops at its next chunk");
+        {
+            // Thousands of slow chunks: seconds to scan, but each chunk is a checkpoint.
+            const juce::int64 slowLength = (juce::int64)65536 * 4000;
+            std::atomic<bool> slowReaders{true};
+            AnalysisService service(
+                [&](const juce::File &) -> std::unique_ptr<juce::AudioFormatReader> {
+                    if (slowReaders.load())
+                        return std::make_unique<SlowSilentMockReader>(slowLength);
+                    return std::make_unique<ImpulseMockReader>(length, spike);
+                },
+                {}, AnalysisService::Delivery::WorkerThread);
+            Collector collector;
+
+            expect(service.submit({file, AnalysisService::Kind::SilenceIn, 0.2f},
+                                  [&](const auto &result) { collector.add(result); }));
+            juce::Thread::sleep(30);
+
+            slowReaders = false;
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            expect(service.submit({file, AnalysisService::Kind::SilenceIn, 0.3f},
+                                  [&](const auto &result) { collector.add(result); }));
+            expect(waitForResults(collector, 1));
+            const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+
+            const auto results = collector.snapshot();
+            expectEquals((int)results.size(), 1);
+            expectEquals(results.front().request.threshold, 0.3f);
+            expectEquals(results.front().sample, spike);
+            expect(elapsedMs < 1000.0, "Restart took " + juce::String(elapsedMs) + " ms");
+            logMessage("Supersede to result: " + juce::String(elapsedMs, 2) + " ms");
+        }
+
+        beginTest("Cancelled requests deliver nothing");
+        {
+            juce::WaitableEvent gate(true);
+            AnalysisService service(
+                [&](const juce::File &) {
+                    gate.wait(5000);
+                    return std::make_unique<ImpulseMockReader>(length, spike);
+                },
+                {}, AnalysisService::Delivery::WorkerThread);
+            Collector collector;
+
+            expect(service.submit({file, AnalysisService::Kind::SilenceOut, 0.2f},
+                                  [&](const auto &result) { collector.add(result); }));
+            service.cancel(AnalysisService::Kind::SilenceOut);
+            expect(!service.isBusy());
+
+            gate.signal();
+            expect(!collector.arrived.wait(200));
+            expect(collector.snapshot().empty());
+        }
+
+        beginTest("Unreadable files report a failure");
+        {
+            AnalysisService service([](const juce::File &) { return nullptr; }, {},
+                                    AnalysisService::Delivery::WorkerThread);
+            Collector collector;
+
+            expect(service.submit({file, AnalysisService::Kind::SilenceIn, 0.1f},
+                                  [&](const auto &result) { collector.add(result); }));
+            expect(waitForResults(collector, 1));
+            expect(!collector.snapshot().front().readerOpened);
+        }
+    }
+
+  private:
+    static bool waitForResults(Collector &collector, int count) {
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            if ((int)collector.snapshot().size() >= count)
+                return true;
+            collector.arrived.wait(50);
+        }
+        return false;
+    }
+};
+
+static AnalysisServiceTest analysisServiceTest;
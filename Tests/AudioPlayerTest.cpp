@@ -3,6 +3,9 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_core/juce_core.h>
 
+#include <atomic>
+#include <thread>
+
 // Simple Mock Source
 class MockAudioSource : public juce::PositionableAudioSource {
   public:
@@ -90,6 +93,73 @@ class AudioPlayerTest : public juce::UnitTest {
             // Cleanup
             player.setSourceForTesting(nullptr, 0.0);
         }
+
+        beginTest("Sources are swapped under running audio callbacks");
+        {
+            SessionState sessionState;
+            AudioPlayer player(sessionState);
+            MockAudioSource first, second;
+            second.lengthInSamples = 48000 * 10;
+
+            double sampleRate = 0.0;
+            juce::int64 length = 0;
+            expect(!player.getReaderInfo(sampleRate, length));
+
+            player.setSourceForTesting(&first, 44100.0);
+            player.prepareToPlay(512, 44100.0);
+            expect(player.getReaderInfo(sampleRate, length));
+            expectEquals(sampleRate, 44100.0);
+            expectEquals(length, first.lengthInSamples);
+
+            std::atomic<bool> stop{false};
+            std::atomic<int> numBlocks{0};
+            std::thread audioThread([&player, &stop, &numBlocks] {
+                juce::AudioBuffer<float> buffer(2, 512);
+                const juce::AudioSourceChannelInfo info(&buffer, 0, 512);
+                while (!stop.load()) {
+                    player.getNextAudioBlock(info);
+                    ++numBlocks;
+                }
+            });
+            while (numBlocks.load() == 0)
+                std::this_thread::yield();
+
+            for (int i = 0; i < 200; ++i) {
+                player.setSourceForTesting(i % 3 == 0 ? nullptr : (i % 3 == 1 ? &second : &first),
+                                           i % 3 == 1 ? 48000.0 : 44100.0);
+                juce::Thread::sleep(0);
+            }
+            player.setSourceForTesting(&second, 48000.0);
+            stop = true;
+            audioThread.join();
+
+            expect(player.getReaderInfo(sampleRate, length));
+            expectEquals(sampleRate, 48000.0);
+            expectEquals(length, second.lengthInSamples);
+
+            player.setSourceForTesting(nullptr, 0.0);
+            expect(!player.getReaderInfo(sampleRate, length));
+        }
+
+        beginTest("Asynchronous loads are superseded and cancelled");
+        {
+            SessionState sessionState;
+            AudioPlayer player(sessionState);
+            const juce::File missing = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                           .getChildFile("audiofiler_missing_load.wav");
+            expect(!player.isLoading());
+
+            player.loadFileAsync(missing, nullptr);
+            expect(player.isLoading());
+            player.cancelLoad();
+            expect(!player.isLoading());
+
+            // A synchronous load supersedes a pending asynchronous one.
+            player.loadFileAsync(missing, nullptr);
+            expect(player.loadFile(missing).failed());
+            expect(!player.isLoading());
+            expect(player.getLoadedFile() == juce::File());
+        }
     }
 };
 
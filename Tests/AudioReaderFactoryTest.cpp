@@ -0,0 +1,74 @@
+#include "Core/AudioReaderFactory.h"
+#include "TestWavWriter.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+class AudioReaderFactoryTest : public juce::UnitTest {
+  public:
+    AudioReaderFactoryTest() : juce::UnitTest("Audio Reader Factory Testing") {
+    }
+
+    void runTest() override {
+        const juce::File file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                    .getChildFile("audiofiler_reader_factory_test.wav");
+        const int numFrames = 20000;
+        expect(writeRampWav(file, numFrames));
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        beginTest("PCM WAV opens as a mapped reader");
+        {
+            auto reader = AudioReaderFactory::createReader(formatManager, file);
+            expect(reader != nullptr);
+            expect(AudioReaderFactory::asMapped(reader.get()) != nullptr);
+            if (reader != nullptr)
+                expectEquals(reader->lengthInSamples, (juce::int64)numFrames);
+        }
+
+        beginTest("Mapped and streamed reads agree");
+        {
+            auto mapped = AudioReaderFactory::createReader(formatManager, file);
+            std::unique_ptr<juce::AudioFormatReader> streamed(formatManager.createReaderFor(file));
+            expect(mapped != nullptr && streamed != nullptr);
+
+            if (mapped != nullptr && streamed != nullptr) {
+                AudioReaderFactory::prefault(mapped.get(), 12000, 4000);
+
+                juce::AudioBuffer<float> fromMap(2, 1000);
+                juce::AudioBuffer<float> fromStream(2, 1000);
+                expect(mapped->read(&fromMap, 0, 1000, 12345, true, true));
+                expect(streamed->read(&fromStream, 0, 1000, 12345, true, true));
+
+                float maxDifference = 0.0f;
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < 1000; ++i)
+                        maxDifference = juce::jmax(maxDifference,
+                                                   std::abs(fromMap.getSample(ch, i) -
+                                                            fromStream.getSample(ch, i)));
+                expectEquals(maxDifference, 0.0f);
+                expect(fromMap.getMagnitude(0, 1000) > 0.0f);
+            }
+        }
+
+        beginTest("Unreadable files return nullptr");
+        {
+            const juce::File missing = file.getSiblingFile("audiofiler_missing_file.wav");
+            expect(AudioReaderFactory::createReader(formatManager, missing) == nullptr);
+            expect(AudioReaderFactory::asMapped(nullptr) == nullptr);
+            AudioReaderFactory::prefault(nullptr, 0, 1000);
+        }
+
+        file.deleteFile();
+    }
+
+  private:
+    /** Writes a 16-bit stereo PCM WAV of two ramps. */
+    static bool writeRampWav(const juce::File &file, int numFrames) {
+        return TestWavWriter::write(file, 2, 44100, numFrames, [](int frame, int channel) {
+            return (short)((frame * (channel == 0 ? 7 : 13)) % 30000 - 15000);
+        });
+    }
+};
+
+static AudioReaderFactoryTest audioReaderFactoryTest;
@@ -0,0 +1,156 @@
+#include "Cli/BatchOptions.h"
+#include "Cli/BatchProcessor.h"
+#include "Cli/BatchReport.h"
+#include "Core/SessionState.h"
+#include "TestWavWriter.h"
+#include "Utils/Config.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+class BatchCliTest : public juce::UnitTest {
+  public:
+    BatchCliTest() : juce::UnitTest("Batch CLI Testing") {
+    }
+
+    void runTest() override {
+        beginTest("Options parse with defaults");
+        {
+            BatchOptions options;
+            expect(BatchOptions::parse({"a.wav", "--threshold-out", "0.2", "--format", "csv",
+                                        "-j", "3", "--no-in"},
+                                       options)
+                       .wasOk());
+            expectEquals(options.inputs.size(), 1);
+            expectEquals(options.inputs[0].getFileName(), juce::String("a.wav"));
+            expectEquals(options.thresholdIn, Config::Audio::silenceThresholdIn);
+            expectEquals(options.thresholdOut, 0.2f);
+            expect(options.format == BatchOptions::Format::Csv);
+            expectEquals(options.numThreads, 3);
+            expect(!options.detectIn && options.detectOut);
+        }
+
+        beginTest("Invalid options are rejected");
+        {
+            BatchOptions options;
+            expect(BatchOptions::parse({}, options).failed());
+            expect(BatchOptions::parse({"a.wav", "--bogus"}, options).failed());
+            expect(BatchOptions::parse({"a.wav", "--threshold-in", "1.5"}, options).failed());
+            expect(BatchOptions::parse({"a.wav", "--threshold-in"}, options).failed());
+            expect(BatchOptions::parse({"a.wav", "--format", "xml"}, options).failed());
+            expect(BatchOptions::parse({"a.wav", "--no-in", "--no-out"}, options).failed());
+            expect(BatchOptions::parse({"-j", "0", "a.wav"}, options).failed());
+
+            BatchOptions help;
+            expect(BatchOptions::parse({"--help"}, help).wasOk());
+            expect(help.showHelp);
+        }
+
+        beginTest("Reports quote fields and carry every file");
+        {
+            BatchProcessor::FileResult good;
+            good.file = juce::File::getCurrentWorkingDirectory().getChildFile("a,b.wav");
+            good.sampleRate = 48000.0;
+            good.lengthInSamples = 96000;
+            good.cutInSample = 4800;
+            good.cutOutSample = 72000;
+            good.inFound = good.outFound = true;
+            good.latencyMs = 4.0;
+
+            BatchProcessor::FileResult bad;
+            bad.file = juce::File::getCurrentWorkingDirectory().getChildFile("missing.wav");
+            bad.error = "File not found";
+            bad.latencyMs = 1.0;
+
+            const BatchReport::Results results{good, bad};
+
+            const juce::StringArray rows =
+                juce::StringArray::fromLines(BatchReport::toCsv(results).trimEnd());
+            expectEquals(rows.size(), 3);
+            expect(rows[1].startsWith("\"" + good.file.getFullPathName() + "\",1,"));
+            expect(rows[1].contains(",4800,72000,0.100000,1.500000,1,1,"));
+            expect(rows[2].endsWith(",File not found"));
+
+            const juce::var json = juce::JSON::parse(BatchReport::toJson(results));
+            expect(json.isArray());
+            expectEquals(json.size(), 2);
+            expectEquals((int)json[0]["cutOutSample"], 72000);
+            expect(!(bool)json[1]["ok"]);
+
+            const juce::String summary = BatchReport::summarise(results, 2000.0);
+            expect(summary.contains("Files: 2 (1 failed)"));
+            expect(summary.contains("1.00 files/s"));
+            expect(summary.contains("max 4.00"));
+        }
+
+        const juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getChildFile("audiofiler_batch_cli_test");
+        tempDir.deleteRecursively();
+        tempDir.createDirectory();
+
+        // Silence, a burst from 1000 to 3000, then silence up to 10000 frames.
+        const juce::File wav = tempDir.getChildFile("burst.wav");
+        expect(writeBurstWav(wav, 10000, 1000, 3000));
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        SessionState sessionState;
+
+        beginTest("Files are analysed, recorded and trimmed");
+        {
+            BatchOptions options;
+            options.inputs.add(tempDir);
+            options.thresholdIn = options.thresholdOut = 0.1f;
+            options.trimDirectory = tempDir.getChildFile("trimmed");
+            BatchProcessor processor(formatManager, sessionState, options);
+
+            const auto files = processor.collectFiles();
+            expectEquals(files.size(), 1);
+
+            const auto results = processor.run(files);
+            expectEquals((int)results.size(), 1);
+            if (results.empty())
+                return;
+
+            const auto &result = results.front();
+            expect(result.succeeded(), result.error);
+            expectEquals(result.cutInSample, (juce::int64)1000);
+
+            const juce::int64 tail = (juce::int64)(44100 * Config::Audio::silenceOutTailSeconds);
+            expectEquals(result.cutOutSample, (juce::int64)2999 + tail);
+
+            const FileMetadata metadata = sessionState.getMetadataForFile(wav.getFullPathName());
+            expect(metadata.isAnalyzed);
+            expectWithinAbsoluteError(metadata.cutIn, 1000.0 / 44100.0, 1.0e-9);
+
+            std::unique_ptr<juce::AudioFormatReader> trimmed(
+                formatManager.createReaderFor(result.trimmedFile));
+            expect(trimmed != nullptr);
+            if (trimmed != nullptr)
+                expectEquals(trimmed->lengthInSamples, result.cutOutSample - result.cutInSample);
+        }
+
+        beginTest("Missing files are reported, not dropped");
+        {
+            BatchOptions options;
+            options.inputs.add(tempDir.getChildFile("nope.wav"));
+            BatchProcessor processor(formatManager, sessionState, options);
+
+            const auto results = processor.run(processor.collectFiles());
+            expectEquals((int)results.size(), 1);
+            expectEquals(results.front().error, juce::String("File not found"));
+        }
+
+        tempDir.deleteRecursively();
+    }
+
+  private:
+    /** Writes a 16-bit mono PCM WAV that is silent except for [burstStart, burstEnd). */
+    static bool writeBurstWav(const juce::File &file, int numFrames, int burstStart,
+                              int burstEnd) {
+        return TestWavWriter::write(file, 1, 44100, numFrames, [=](int frame, int) {
+            return (short)(frame >= burstStart && frame < burstEnd ? 16000 : 0);
+        });
+    }
+};
+
+static BatchCliTest batchCliTest;
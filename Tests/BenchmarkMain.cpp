@@ -0,0 +1,14 @@
+#include <juce_core/juce_core.h>
+
+// Benchmarks are ordinary juce::UnitTests in the "Benchmarks" category. They are linked into
+// this executable only, so the `tests` target (and CTest) never pays for them.
+int main(int argc, char *argv[]) {
+    juce::UnitTestRunner runner;
+    runner.runTestsInCategory("Benchmarks");
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        if (runner.getResult(i)->failures > 0)
+            return 1;
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "Utils/Config.h"
+#include "Utils/ContentFingerprint.h"
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+class ContentFingerprintTest : public juce::UnitTest {
+  public:
+    ContentFingerprintTest() : juce::UnitTest("Content Fingerprint Testing") {
+    }
+
+    void runTest() override {
+        beginTest("XXH64 reference values");
+        {
+            expect(ContentFingerprint::hash64("", 0) == 0xEF46DB3751D8E999ULL);
+            expect(ContentFingerprint::hash64("a", 1) == 0xD24EC4F1A98C6E5BULL);
+            expect(ContentFingerprint::hash64("abc", 3) == 0x44BC2CF5AD770999ULL);
+            expect(ContentFingerprint::hash64("abc", 3, 1) == 0xBEA9CA8199328908ULL);
+
+            const char *sentence = "The quick brown fox jumps over the lazy dog";
+            expect(ContentFingerprint::hash64(sentence, 43) == 0x0B242D361FDA71BCULL);
+        }
+
+        beginTest("Incremental hashing matches one-shot");
+        {
+            std::vector<juce::uint8> data(1000);
+            for (size_t i = 0; i < data.size(); ++i)
+                data[i] = (juce::uint8)(i * 31 + 7);
+
+            const juce::uint64 expected = ContentFingerprint::hash64(data.data(), data.size(), 9);
+            for (size_t split : {(size_t)1, (size_t)5, (size_t)31, (size_t)32, (size_t)333}) {
+                ContentFingerprint::Hasher hasher(9);
+                for (size_t pos = 0; pos < data.size(); pos += split)
+                    hasher.update(data.data() + pos, juce::jmin(split, data.size() - pos));
+                expect(hasher.digest() == expected, "split " + juce::String((int)split));
+            }
+        }
+
+        // Large enough that the sampled mode skips most of it.
+        const size_t size = (size_t)Config::Cache::fingerprintHeaderBytes +
+                            (size_t)Config::Cache::fingerprintBlockBytes *
+                                (size_t)Config::Cache::fingerprintNumBlocks * 4 +
+                            123;
+        juce::MemoryBlock content(size);
+        auto *bytes = static_cast<juce::uint8 *>(content.getData());
+        for (size_t i = 0; i < size; ++i)
+            bytes[i] = (juce::uint8)((i * 2654435761u) >> 13);
+
+        beginTest("Keys are stable and mode-specific");
+        {
+            const juce::String sampled = fingerprint(content, ContentFingerprint::Mode::Sampled);
+            const juce::String full = fingerprint(content, ContentFingerprint::Mode::Full);
+
+            expectEquals(sampled.length(), 17);
+            expect(sampled.startsWith("s"));
+            expect(full.startsWith("f"));
+            expect(sampled == fingerprint(content, ContentFingerprint::Mode::Sampled));
+            expect(sampled.substring(1) != full.substring(1));
+        }
+
+        beginTest("Sampled mode sees the header, the size and the end of the file");
+        {
+            const juce::String original = fingerprint(content, ContentFingerprint::Mode::Sampled);
+
+            juce::MemoryBlock edited(content);
+            static_cast<juce::uint8 *>(edited.getData())[10] ^= 0xFF;
+            expect(fingerprint(edited, ContentFingerprint::Mode::Sampled) != original);
+
+            juce::MemoryBlock lastByte(content);
+            static_cast<juce::uint8 *>(lastByte.getData())[size - 1] ^= 0xFF;
+            expect(fingerprint(lastByte, ContentFingerprint::Mode::Sampled) != original);
+
+            juce::MemoryBlock truncated(content.getData(), size - 1);
+            expect(fingerprint(truncated, ContentFingerprint::Mode::Sampled) != original);
+        }
+
+        beginTest("Full mode sees every byte");
+        {
+            // Between the first two strided blocks, so only the full mode can notice it.
+            const size_t unsampled = (size_t)Config::Cache::fingerprintHeaderBytes +
+                                     (size_t)Config::Cache::fingerprintBlockBytes + 1;
+
+            juce::MemoryBlock edited(content);
+            static_cast<juce::uint8 *>(edited.getData())[unsampled] ^= 0xFF;
+
+            expect(fingerprint(edited, ContentFingerprint::Mode::Sampled) ==
+                   fingerprint(content, ContentFingerprint::Mode::Sampled));
+            expect(fingerprint(edited, ContentFingerprint::Mode::Full) !=
+                   fingerprint(content, ContentFingerprint::Mode::Full));
+        }
+
+        beginTest("Cancellation returns an empty key");
+        {
+            juce::MemoryInputStream stream(content, false);
+            expect(ContentFingerprint::compute(stream, ContentFingerprint::Mode::Full, [] {
+                       return true;
+                   }).isEmpty());
+        }
+    }
+
+  private:
+    static juce::String fingerprint(const juce::MemoryBlock &data, ContentFingerprint::Mode mode) {
+        juce::MemoryInputStream stream(data, false);
+        return ContentFingerprint::compute(stream, mode);
+    }
+};
+
+static ContentFingerprintTest contentFingerprintTest;
@@ -0,0 +1,62 @@
+#include "Core/EnvelopeIndex.h"
+#include "Utils/Config.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+class EnvelopeIndexTest : public juce::UnitTest {
+  public:
+    EnvelopeIndexTest() : juce::UnitTest("Envelope Index Testing") {
+    }
+
+    void runTest() override {
+        const int baseBlock = Config::Audio::envelopeBaseBlockSize;
+        // Not a multiple of any block size, so every level ends with a partial block.
+        const int length = baseBlock * Config::Audio::envelopeLevelRatio * 5 + 77;
+
+        juce::AudioBuffer<float> buffer(2, length);
+        buffer.clear();
+        buffer.setSample(0, baseBlock * 9 + 3, 0.5f);
+        buffer.setSample(1, baseBlock * 20, -0.75f);
+        buffer.setSample(0, length - 1, 0.25f);
+        for (int i = 0; i < baseBlock; ++i)
+            buffer.setSample(1, baseBlock * 30 + i, (i % 2 == 0) ? 0.1f : -0.1f);
+
+        EnvelopeIndex index(2, length, 48000.0);
+        index.addBlock(0, buffer, length);
+        index.finalise();
+
+        beginTest("Levels and block counts");
+        expect(index.isComplete());
+        expectEquals(index.getNumLevels(), Config::Audio::envelopeNumLevels);
+        expectEquals(index.getBlockSize(0), baseBlock);
+        expectEquals(index.getNumBlocks(0), (juce::int64)((length + baseBlock - 1) / baseBlock));
+
+        beginTest("First and last block above threshold");
+        expectEquals(index.findFirstBlockAbove(0.2f), (juce::int64)9);
+        expectEquals(index.findLastBlockAbove(0.2f), index.getNumBlocks(0) - 1);
+        expectEquals(index.findFirstBlockAbove(0.6f), (juce::int64)20);
+        expectEquals(index.findLastBlockAbove(0.6f), (juce::int64)20);
+        expectEquals(index.findFirstBlockAbove(0.8f), (juce::int64)-1);
+        expectEquals(index.findLastBlockAbove(0.8f), (juce::int64)-1);
+
+        beginTest("Min/max and RMS queries");
+        auto whole = index.getMinMax(1, 0, length);
+        expectEquals(whole.getStart(), -0.75f);
+        expectEquals(whole.getEnd(), 0.1f);
+        expectEquals(index.getMinMax(0, 0, length).getEnd(), 0.5f);
+
+        // A single square-wave block of +/-0.1 has an RMS of exactly 0.1.
+        expectWithinAbsoluteError(index.getRms(1, (juce::int64)baseBlock * 30, baseBlock), 0.1f,
+                                  1.0e-6f);
+        expectEquals(index.getRms(0, (juce::int64)baseBlock * 35, baseBlock), 0.0f);
+
+        // Coarse levels must agree with the finest one.
+        const int top = index.getNumLevels() - 1;
+        float coarseMax = -1.0f;
+        for (juce::int64 block = 0; block < index.getNumBlocks(top); ++block)
+            coarseMax = juce::jmax(coarseMax, index.getMaxData(top, 0)[block]);
+        expectEquals(coarseMax, 0.5f);
+    }
+};
+
+static EnvelopeIndexTest envelopeIndexTest;
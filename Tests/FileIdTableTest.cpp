@@ -0,0 +1,45 @@
+#include "Core/FileIdTable.h"
+#include <juce_core/juce_core.h>
+
+class FileIdTableTest : public juce::UnitTest {
+  public:
+    FileIdTableTest() : juce::UnitTest("File Id Table Testing") {
+    }
+
+    void runTest() override {
+        beginTest("Ids are dense, stable and never invalid");
+        {
+            FileIdTable table;
+            expectEquals((int)table.find("a.wav"), (int)invalidFileId);
+
+            const FileId a = table.intern("a.wav");
+            const FileId b = table.intern("b.wav");
+            expectEquals((int)a, 1);
+            expectEquals((int)b, 2);
+            expectEquals((int)table.intern("a.wav"), (int)a);
+            expectEquals((int)table.find("b.wav"), (int)b);
+            expectEquals(table.getKey(b), juce::String("b.wav"));
+            expectEquals(table.size(), 2);
+        }
+
+        beginTest("Every key is still found after the table has grown many times");
+        {
+            FileIdTable table;
+            constexpr int kNumKeys = 50000;
+            for (int i = 0; i < kNumKeys; ++i)
+                table.intern("/music/track " + juce::String(i) + ".wav");
+
+            int numFound = 0;
+            for (int i = 0; i < kNumKeys; ++i) {
+                const juce::String key = "/music/track " + juce::String(i) + ".wav";
+                const FileId id = table.find(key);
+                if (id == (FileId)(i + 1) && table.getKey(id) == key)
+                    ++numFound;
+            }
+            expectEquals(numFound, kNumKeys);
+            expectEquals((int)table.find("/music/missing.wav"), (int)invalidFileId);
+        }
+    }
+};
+
+static FileIdTableTest fileIdTableTest;
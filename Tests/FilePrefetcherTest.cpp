@@ -0,0 +1,102 @@
+#include "Core/AnalysisCache.h"
+#include "TestWavWriter.h"
+#include "Utils/ContentFingerprint.h"
+#include "Workers/FilePrefetcher.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+class FilePrefetcherTest : public juce::UnitTest {
+  public:
+    FilePrefetcherTest() : juce::UnitTest("File Prefetcher Testing") {
+    }
+
+    void runTest() override {
+        const juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getChildFile("audiofiler_file_prefetcher_test");
+        tempDir.deleteRecursively();
+        tempDir.createDirectory();
+
+        const juce::File first = tempDir.getChildFile("first.wav");
+        const juce::File second = tempDir.getChildFile("second.wav");
+        expect(writeWav(first, 20000, 1));
+        expect(writeWav(second, 30000, 2));
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        AnalysisCache cache(tempDir.getChildFile("cache"));
+        FilePrefetcher prefetcher(formatManager, cache);
+        const auto never = [] { return false; };
+
+        beginTest("A prefetched file has its envelope and waveform cached");
+        {
+            expect(prefetcher.prefetchFile(first, never));
+
+            const juce::String key =
+                ContentFingerprint::compute(first, ContentFingerprint::Mode::Sampled, never);
+            AnalysisCache::Entry entry;
+            expect(cache.load(key, entry));
+            expect(entry.envelope != nullptr);
+            if (entry.envelope != nullptr)
+                expectEquals(entry.envelope->getLengthInSamples(), (juce::int64)20000);
+            expectEquals(entry.metadata.hash, key);
+            expectWithinAbsoluteError(entry.metadata.cutOut, 20000.0 / 44100.0, 1.0e-9);
+
+            juce::MemoryBlock thumbnailData;
+            expect(cache.loadThumbnailData(key, thumbnailData));
+            expect(thumbnailData.getSize() > 0);
+        }
+
+        beginTest("Cut points already stored for the content are kept");
+        {
+            const juce::String key =
+                ContentFingerprint::compute(first, ContentFingerprint::Mode::Sampled, never);
+            FileMetadata metadata;
+            metadata.cutIn = 0.1;
+            metadata.cutOut = 0.2;
+            metadata.hash = key;
+            expect(cache.storeMetadata(key, metadata));
+
+            expect(prefetcher.prefetchFile(first, never));
+            AnalysisCache::Entry entry;
+            expect(cache.load(key, entry));
+            expect(entry.envelope != nullptr);
+            expectEquals(entry.metadata.cutIn, 0.1);
+            expectEquals(entry.metadata.cutOut, 0.2);
+        }
+
+        beginTest("A stopped prefetch stores nothing");
+        {
+            expect(!prefetcher.prefetchFile(second, [] { return true; }));
+            const juce::String key =
+                ContentFingerprint::compute(second, ContentFingerprint::Mode::Sampled, never);
+            AnalysisCache::Entry entry;
+            expect(!cache.load(key, entry));
+            expect(!prefetcher.prefetchFile(tempDir.getChildFile("missing.wav"), never));
+        }
+
+        beginTest("Queued files are prepared in the background");
+        {
+            prefetcher.prefetch({second});
+            const double deadline = juce::Time::getMillisecondCounterHiRes() + 10000.0;
+            while (!prefetcher.isPrefetched(second) &&
+                   juce::Time::getMillisecondCounterHiRes() < deadline)
+                juce::Thread::sleep(5);
+            expect(prefetcher.isPrefetched(second));
+            expect(!prefetcher.isBusy());
+            expect(!prefetcher.isPrefetched(first));
+        }
+
+        tempDir.deleteRecursively();
+    }
+
+  private:
+    /** Writes a 16-bit stereo WAV of noise; `seed` makes the contents differ. */
+    static bool writeWav(const juce::File &file, int numFrames, int seed) {
+        juce::Random random(seed);
+        return TestWavWriter::write(file, 2, 44100, numFrames, [&random](int, int) {
+            return (short)random.nextInt(65536);
+        });
+    }
+};
+
+static FilePrefetcherTest filePrefetcherTest;
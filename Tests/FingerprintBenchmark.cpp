@@ -0,0 +1,59 @@
+#include "Utils/ContentFingerprint.h"
+#include <juce_core/juce_core.h>
+
+class FingerprintBenchmark : public juce::UnitTest {
+  public:
+    FingerprintBenchmark() : juce::UnitTest("Content Fingerprint Benchmark", "Benchmarks") {
+    }
+
+    void runTest() override {
+        // Roughly 25 minutes of 48 kHz 24-bit stereo.
+        const size_t size = (size_t)256 * 1024 * 1024;
+        juce::MemoryBlock content(size);
+        auto *bytes = static_cast<juce::uint8 *>(content.getData());
+        for (size_t i = 0; i < size; ++i)
+            bytes[i] = (juce::uint8)((i * 2654435761u) >> 13);
+
+        beginTest("In-memory XXH64 throughput");
+        {
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            const juce::uint64 hash = ContentFingerprint::hash64(content.getData(), size);
+            const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+            expect(hash != 0);
+            report("hash64", size, elapsedMs);
+        }
+
+        const juce::File file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                    .getChildFile("audiofiler_fingerprint_benchmark.bin");
+        expect(file.replaceWithData(content.getData(), size));
+
+        beginTest("File fingerprint per mode");
+        {
+            // The first run warms the page cache, so both modes are measured from memory.
+            runMode(file, ContentFingerprint::Mode::Full, "Full (warm-up)");
+            runMode(file, ContentFingerprint::Mode::Full, "Full");
+            runMode(file, ContentFingerprint::Mode::Sampled, "Sampled");
+        }
+
+        file.deleteFile();
+    }
+
+  private:
+    void runMode(const juce::File &file, ContentFingerprint::Mode mode, const juce::String &name) {
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        const juce::String key = ContentFingerprint::compute(file, mode);
+        const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+        expect(key.isNotEmpty(), name + " produced no key");
+        report(name, (size_t)file.getSize(), elapsedMs);
+    }
+
+    void report(const juce::String &name, size_t numBytes, double elapsedMs) {
+        // Effective rate: file bytes identified per second, not bytes actually read.
+        const double gigabytesPerSecond =
+            elapsedMs > 0.0 ? ((double)numBytes / 1.0e9) / (elapsedMs / 1000.0) : 0.0;
+        logMessage(name.paddedRight(' ', 20) + juce::String(elapsedMs, 3) + " ms  (" +
+                   juce::String(gigabytesPerSecond, 2) + " GB/s)");
+    }
+};
+
+static FingerprintBenchmark fingerprintBenchmark;
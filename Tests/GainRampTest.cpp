@@ -0,0 +1,90 @@
+#include "Core/GainRamp.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+class GainRampTest : public juce::UnitTest {
+  public:
+    GainRampTest() : juce::UnitTest("Gain Ramp Testing") {
+    }
+
+    void runTest() override {
+        using Curve = Config::Audio::FadeCurve;
+
+        beginTest("Fades rise and fall monotonically");
+        {
+            for (const Curve curve : {Curve::Linear, Curve::EqualPower, Curve::RaisedCosine}) {
+                const GainRamp ramp(64, curve);
+                const auto in = faded(ramp, true);
+                const auto out = faded(ramp, false);
+
+                bool monotonic = true;
+                for (int i = 1; i < 64; ++i)
+                    monotonic = monotonic && in.getSample(0, i) > in.getSample(0, i - 1) &&
+                                out.getSample(0, i) < out.getSample(0, i - 1);
+
+                expect(monotonic);
+                expect(in.getSample(0, 0) > 0.0f && in.getSample(0, 63) < 1.0f);
+                expectWithinAbsoluteError(in.getSample(0, 10), out.getSample(0, 53), 1.0e-6f);
+            }
+        }
+
+        beginTest("Crossfades keep gain or power constant");
+        {
+            const GainRamp linear(32, Curve::Linear);
+            const GainRamp equalPower(32, Curve::EqualPower);
+            const auto linearIn = faded(linear, true);
+            const auto linearOut = faded(linear, false);
+            const auto powerIn = faded(equalPower, true);
+            const auto powerOut = faded(equalPower, false);
+
+            for (int i = 0; i < 32; ++i) {
+                expectWithinAbsoluteError(linearIn.getSample(0, i) + linearOut.getSample(0, i),
+                                          1.0f, 1.0e-5f);
+                const float power = powerIn.getSample(0, i) * powerIn.getSample(0, i) +
+                                    powerOut.getSample(0, i) * powerOut.getSample(0, i);
+                expectWithinAbsoluteError(power, 1.0f, 1.0e-5f);
+            }
+        }
+
+        beginTest("A fade split across calls matches one applied whole");
+        {
+            const GainRamp ramp(48, Curve::RaisedCosine);
+            const auto whole = faded(ramp, true);
+
+            juce::AudioBuffer<float> split(2, 48);
+            fillWithOnes(split);
+            ramp.applyFadeIn(split, 0, 20, 0);
+            ramp.applyFadeIn(split, 20, 28, 20);
+
+            bool same = true;
+            for (int i = 0; i < 48; ++i)
+                same = same && split.getSample(1, i) == whole.getSample(0, i);
+            expect(same);
+
+            juce::AudioBuffer<float> mixed(2, 48);
+            mixed.clear();
+            ramp.addFadedIn(mixed, 0, whole, 48, 0);
+            expectWithinAbsoluteError(mixed.getSample(0, 47),
+                                      whole.getSample(0, 47) * whole.getSample(0, 47), 1.0e-6f);
+        }
+    }
+
+  private:
+    static void fillWithOnes(juce::AudioBuffer<float> &buffer) {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(channel), 1.0f,
+                                              buffer.getNumSamples());
+    }
+
+    static juce::AudioBuffer<float> faded(const GainRamp &ramp, bool fadeIn) {
+        juce::AudioBuffer<float> buffer(2, ramp.getLength());
+        fillWithOnes(buffer);
+        if (fadeIn)
+            ramp.applyFadeIn(buffer, 0, ramp.getLength(), 0);
+        else
+            ramp.applyFadeOut(buffer, 0, ramp.getLength(), 0);
+        return buffer;
+    }
+};
+
+static GainRampTest gainRampTest;
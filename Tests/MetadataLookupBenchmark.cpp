@@ -0,0 +1,95 @@
+#include "Core/MetadataStore.h"
+#include <juce_core/juce_core.h>
+
+#include <map>
+#include <vector>
+
+class MetadataLookupBenchmark : public juce::UnitTest {
+  public:
+    MetadataLookupBenchmark() : juce::UnitTest("Metadata Lookup Benchmark", "Benchmarks") {
+    }
+
+    void runTest() override {
+        constexpr int kNumFiles = 50000;
+        std::vector<juce::String> paths;
+        for (int i = 0; i < kNumFiles; ++i)
+            paths.push_back("/Users/someone/Music/Library/Artist " + juce::String(i % 500) +
+                            "/Album " + juce::String(i % 37) + "/Track " + juce::String(i) +
+                            ".wav");
+
+        FileMetadata metadata;
+        metadata.cutOut = 60.0;
+        metadata.hash = "fp1-0123456789abcdef";
+
+        beginTest("Load pattern: has, get, set per file");
+        {
+            // The previous model: full-path keys in an ordered map.
+            std::map<juce::String, FileMetadata> ordered;
+            for (const auto &path : paths)
+                ordered[path] = metadata;
+
+            double checksum = 0.0;
+            double start = juce::Time::getMillisecondCounterHiRes();
+            for (const auto &path : paths) {
+                if (ordered.find(path) != ordered.end()) {
+                    const FileMetadata cached = ordered.find(path)->second;
+                    ordered[path] = cached;
+                    checksum += cached.cutOut;
+                }
+            }
+            report("std::map by path", kNumFiles, juce::Time::getMillisecondCounterHiRes() - start);
+
+            MetadataStore store;
+            for (const auto &path : paths)
+                store.put(path, metadata);
+
+            start = juce::Time::getMillisecondCounterHiRes();
+            for (const auto &path : paths) {
+                const FileId id = store.intern(path);
+                FileMetadata cached;
+                if (store.get(id, cached)) {
+                    store.put(id, cached);
+                    checksum += cached.cutOut;
+                }
+            }
+            report("Interned handle", kNumFiles, juce::Time::getMillisecondCounterHiRes() - start);
+            expectEquals(checksum, 2.0 * 60.0 * kNumFiles);
+        }
+
+        beginTest("Cut point edits on the current file");
+        {
+            constexpr int kNumEdits = 1000000;
+            std::map<juce::String, FileMetadata> ordered;
+            for (const auto &path : paths)
+                ordered[path] = metadata;
+            const juce::String &current = paths[(size_t)kNumFiles / 2];
+
+            double start = juce::Time::getMillisecondCounterHiRes();
+            for (int i = 0; i < kNumEdits; ++i)
+                ordered[current].cutIn = (double)i;
+            report("std::map by path", kNumEdits, juce::Time::getMillisecondCounterHiRes() - start);
+
+            MetadataStore store;
+            for (const auto &path : paths)
+                store.put(path, metadata);
+            const FileId id = store.intern(current);
+
+            start = juce::Time::getMillisecondCounterHiRes();
+            for (int i = 0; i < kNumEdits; ++i)
+                store.update(id, [i](MetadataStore::Record &record) { record.cutIn = (double)i; });
+            report("Interned handle", kNumEdits, juce::Time::getMillisecondCounterHiRes() - start);
+
+            FileMetadata edited;
+            expect(store.get(id, edited));
+            expectEquals(edited.cutIn, ordered[current].cutIn);
+        }
+    }
+
+  private:
+    void report(const juce::String &name, int numOperations, double elapsedMs) {
+        logMessage(name.paddedRight(' ', 20) +
+                   juce::String(elapsedMs * 1.0e6 / numOperations, 1) + " ns per file");
+    }
+};
+
+static MetadataLookupBenchmark metadataLookupBenchmark;
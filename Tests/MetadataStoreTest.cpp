@@ -0,0 +1,223 @@
+#include "Core/MetadataStore.h"
+#include <juce_core/juce_core.h>
+
+class MetadataStoreTest : public juce::UnitTest {
+  public:
+    MetadataStoreTest() : juce::UnitTest("Metadata Store Testing") {
+    }
+
+    void runTest() override {
+        const juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getChildFile("audiofiler_metadata_store_test");
+
+        beginTest("An in-memory store keeps what was put");
+        {
+            MetadataStore store;
+            FileMetadata metadata;
+            expect(!store.get("a.wav", metadata));
+
+            store.put("a.wav", makeMetadata(1.0, 2.0));
+            expect(store.get("a.wav", metadata));
+            expectEquals(metadata.cutIn, 1.0);
+            expectEquals(metadata.hash, juce::String("key"));
+            expect(!store.contains("b.wav"));
+        }
+
+        beginTest("Handles read and update the same record as paths");
+        {
+            MetadataStore store;
+            const FileId id = store.intern("a.wav");
+            FileMetadata metadata;
+            expect(!store.get(id, metadata));
+
+            store.update(id, [](MetadataStore::Record &record) { record.cutOut = 4.0; });
+            expect(store.get("a.wav", metadata));
+            expectEquals(metadata.cutOut, 4.0);
+            expect(metadata.hash.isEmpty());
+
+            store.put(id, makeMetadata(1.0, 2.0));
+            expectEquals((int)store.intern("a.wav"), (int)id);
+            expect(store.get(id, metadata));
+            expectEquals(metadata.cutOut, 2.0);
+            expectEquals(metadata.hash, juce::String("key"));
+        }
+
+        beginTest("Flushed changes survive reopening");
+        {
+            tempDir.deleteRecursively();
+            {
+                MetadataStore store(tempDir);
+                store.put("a.wav", makeMetadata(1.0, 2.0));
+                store.put("a.wav", makeMetadata(1.5, 2.0));
+                store.put("b.wav", makeMetadata(3.0, 4.0));
+                store.flush();
+                expectEquals(store.getNumJournalRecords(), 2);
+
+                store.put("b.wav", makeMetadata(3.0, 4.0));
+                store.flush();
+                expectEquals(store.getNumJournalRecords(), 2);
+            }
+
+            MetadataStore reopened(tempDir);
+            expectStored(reopened, "a.wav", 1.5, 2.0);
+            expectStored(reopened, "b.wav", 3.0, 4.0);
+        }
+
+        beginTest("Compaction empties the journal and keeps every value");
+        {
+            tempDir.deleteRecursively();
+            {
+                MetadataStore store(tempDir);
+                store.put("a.wav", makeMetadata(1.0, 2.0));
+                store.put("b.wav", makeMetadata(3.0, 4.0));
+                store.compact();
+                expectEquals(store.getNumJournalRecords(), 0);
+                expect(store.getTableFile().existsAsFile());
+                expectStored(store, "a.wav", 1.0, 2.0);
+
+                store.put("a.wav", makeMetadata(5.0, 6.0));
+                store.flush();
+                expectEquals(store.getNumJournalRecords(), 1);
+            }
+
+            MetadataStore reopened(tempDir);
+            expectStored(reopened, "a.wav", 5.0, 6.0);
+            expectStored(reopened, "b.wav", 3.0, 4.0);
+        }
+
+        beginTest("A change made during compaction survives a crash at any step");
+        {
+            tempDir.deleteRecursively();
+            const juce::File afterSwap = tempDir.getSiblingFile(tempDir.getFileName() + "_swap");
+            const juce::File afterJournal =
+                tempDir.getSiblingFile(tempDir.getFileName() + "_journal");
+            {
+                MetadataStore store(tempDir);
+                store.put("a.wav", makeMetadata(1.0, 2.0));
+                store.put("b.wav", makeMetadata(3.0, 4.0));
+                store.compact();
+                store.put("a.wav", makeMetadata(5.0, 6.0));
+                store.flush();
+
+                // a.wav is journaled, then changed again before the compaction copies it.
+                const auto copyFiles = [&store](const juce::File &target) {
+                    target.deleteRecursively();
+                    target.createDirectory();
+                    store.getTableFile().copyFileTo(
+                        target.getChildFile(store.getTableFile().getFileName()));
+                    store.getJournalFile().copyFileTo(
+                        target.getChildFile(store.getJournalFile().getFileName()));
+                };
+                store.setCompactionHookForTesting([&](MetadataStore::CompactionStep step) {
+                    if (step == MetadataStore::CompactionStep::started)
+                        store.put("a.wav", makeMetadata(7.0, 8.0));
+                    else if (step == MetadataStore::CompactionStep::tableSwapped)
+                        copyFiles(afterSwap);
+                    else
+                        copyFiles(afterJournal);
+                });
+                store.compact();
+                store.setCompactionHookForTesting(nullptr);
+            }
+
+            // Crashing with the new table and the old journal replays the journaled value.
+            {
+                MetadataStore crashed(afterSwap);
+                expectStored(crashed, "a.wav", 5.0, 6.0);
+                expectStored(crashed, "b.wav", 3.0, 4.0);
+            }
+            // Once the journal is replaced it already holds the change made meanwhile.
+            {
+                MetadataStore crashed(afterJournal);
+                expectStored(crashed, "a.wav", 7.0, 8.0);
+                expectStored(crashed, "b.wav", 3.0, 4.0);
+            }
+            afterSwap.deleteRecursively();
+            afterJournal.deleteRecursively();
+        }
+
+        beginTest("A torn record at the end of the journal is dropped, earlier ones kept");
+        {
+            tempDir.deleteRecursively();
+            juce::File journalFile;
+            {
+                MetadataStore store(tempDir);
+                store.put("a.wav", makeMetadata(1.0, 2.0));
+                store.flush();
+                journalFile = store.getJournalFile();
+            }
+
+            const juce::int64 intactBytes = journalFile.getSize();
+            {
+                juce::FileOutputStream out(journalFile);
+                out.writeInt(24);
+                out.writeInt(12345);
+                out.writeDouble(7.0);
+            }
+
+            {
+                MetadataStore reopened(tempDir);
+                expectStored(reopened, "a.wav", 1.0, 2.0);
+                expectEquals(reopened.getNumJournalRecords(), 1);
+                expectEquals(journalFile.getSize(), intactBytes);
+
+                reopened.put("b.wav", makeMetadata(3.0, 4.0));
+            }
+
+            MetadataStore again(tempDir);
+            expectStored(again, "a.wav", 1.0, 2.0);
+            expectStored(again, "b.wav", 3.0, 4.0);
+        }
+
+        beginTest("Tens of thousands of paths are found after compaction and reopening");
+        {
+            tempDir.deleteRecursively();
+            constexpr int kNumPaths = 20000;
+            {
+                MetadataStore store(tempDir);
+                for (int i = 0; i < kNumPaths; ++i)
+                    store.put(pathFor(i), makeMetadata((double)i, (double)i + 1.0));
+                store.compact();
+            }
+
+            MetadataStore reopened(tempDir);
+            expectEquals(reopened.getNumJournalRecords(), 0);
+            int numFound = 0;
+            for (int i = 0; i < kNumPaths; ++i) {
+                FileMetadata metadata;
+                if (reopened.get(pathFor(i), metadata) && metadata.cutIn == (double)i)
+                    ++numFound;
+            }
+            expectEquals(numFound, kNumPaths);
+            expect(!reopened.contains(pathFor(kNumPaths)));
+        }
+
+        tempDir.deleteRecursively();
+    }
+
+  private:
+    static FileMetadata makeMetadata(double cutIn, double cutOut) {
+        FileMetadata metadata;
+        metadata.cutIn = cutIn;
+        metadata.cutOut = cutOut;
+        metadata.isAnalyzed = true;
+        metadata.hash = "key";
+        return metadata;
+    }
+
+    static juce::String pathFor(int index) {
+        return "/music/album " + juce::String(index / 100) + "/track " + juce::String(index) +
+               ".wav";
+    }
+
+    void expectStored(const MetadataStore &store, const juce::String &path, double cutIn,
+                      double cutOut) {
+        FileMetadata metadata;
+        expect(store.get(path, metadata), path + " is missing");
+        expectEquals(metadata.cutIn, cutIn);
+        expectEquals(metadata.cutOut, cutOut);
+        expect(metadata.isAnalyzed);
+    }
+};
+
+static MetadataStoreTest metadataStoreTest;
@@ -0,0 +1,124 @@
+#include "Utils/Config.h"
+#include "Workers/ParallelSilenceScanner.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// Silent mock reader with isolated spikes of (position, channel).
+class SpikeMockReader : public juce::AudioFormatReader {
+  public:
+    SpikeMockReader(juce::int64 length, std::vector<std::pair<juce::int64, int>> spikesIn)
+        : juce::AudioFormatReader(nullptr, "SpikeMockReader"), spikes(std::move(spikesIn)) {
+        lengthInSamples = length;
+        numChannels = 2;
+        sampleRate = 48000.0;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        for (int ch = 0; ch < numDestChannels; ++ch) {
+            if (destSamples[ch] == nullptr)
+                continue;
+            float *dest = (float *)destSamples[ch] + startOffsetInDestBuffer;
+            juce::FloatVectorOperations::clear(dest, numSamples);
+            for (const auto &spike : spikes) {
+                if (spike.second == ch && spike.first >= startSampleInFile &&
+                    spike.first < startSampleInFile + numSamples)
+                    dest[spike.first - startSampleInFile] = 0.5f;
+            }
+        }
+        return true;
+    }
+
+  private:
+    std::vector<std::pair<juce::int64, int>> spikes;
+};
+
+class ParallelSilenceScanTest : public juce::UnitTest {
+  public:
+    ParallelSilenceScanTest() : juce::UnitTest("Parallel Silence Scan Testing") {
+    }
+
+    void runTest() override {
+        const juce::int64 minSegment = Config::Audio::parallelScanMinSegmentSamples;
+        const juce::int64 length = minSegment * 12 + 4321;
+        juce::ThreadPool pool(4);
+
+        beginTest("Segments tile the file");
+        {
+            const auto segments = ParallelSilenceScanner::makeSegments(length, 4);
+            expectEquals((int)segments.size(), 12);
+            expectEquals(segments.front().getStart(), (juce::int64)0);
+            expectEquals(segments.back().getEnd(), length);
+            for (size_t i = 1; i < segments.size(); ++i)
+                expectEquals(segments[i].getStart(), segments[i - 1].getEnd());
+
+            expectEquals((int)ParallelSilenceScanner::makeSegments(minSegment / 2, 16).size(), 1);
+            expect(ParallelSilenceScanner::makeSegments(0, 4).empty());
+            expectEquals((int)ParallelSilenceScanner::makeSegments(length, 1).size(),
+                         Config::Audio::parallelScanSegmentsPerThread);
+        }
+
+        beginTest("Matches the serial scan");
+        {
+            const auto segments = ParallelSilenceScanner::makeSegments(length, 4);
+            const juce::int64 boundary = segments[5].getStart();
+            const std::vector<std::pair<juce::int64, int>> spikes = {
+                {boundary - 1, 1}, {boundary, 0}, {segments[9].getStart() + 77, 1},
+                {length - 3, 0}};
+
+            std::atomic<int> readersOpened{0};
+            ParallelSilenceScanner scanner(pool, [&] {
+                ++readersOpened;
+                return std::make_unique<SpikeMockReader>(length, spikes);
+            });
+
+            SpikeMockReader serial(length, spikes);
+            expectEquals(scanner.findSilenceIn(0.1f),
+                         SilenceAnalysisAlgorithms::findSilenceIn(serial, 0.1f));
+            expectEquals(scanner.findSilenceIn(0.1f), boundary - 1);
+            expectEquals(scanner.findSilenceOut(0.1f),
+                         SilenceAnalysisAlgorithms::findSilenceOut(serial, 0.1f));
+            expectEquals(scanner.findSilenceOut(0.1f), length - 3);
+            expect(readersOpened.load() > 1);
+        }
+
+        beginTest("Worst case: single hit at the far end");
+        {
+            ParallelSilenceScanner scanner(pool, [&] {
+                return std::make_unique<SpikeMockReader>(
+                    length, std::vector<std::pair<juce::int64, int>>{{length - 10, 1}});
+            });
+            expectEquals(scanner.findSilenceIn(0.1f), length - 10);
+
+            ParallelSilenceScanner reverse(pool, [&] {
+                return std::make_unique<SpikeMockReader>(
+                    length, std::vector<std::pair<juce::int64, int>>{{10, 0}});
+            });
+            expectEquals(reverse.findSilenceOut(0.1f), (juce::int64)10);
+        }
+
+        beginTest("No hit, cancellation and missing reader");
+        {
+            ParallelSilenceScanner silent(pool, [&] {
+                return std::make_unique<SpikeMockReader>(
+                    length, std::vector<std::pair<juce::int64, int>>{});
+            });
+            expectEquals(silent.findSilenceIn(0.1f), (juce::int64)-1);
+            expectEquals(silent.findSilenceOut(0.1f), (juce::int64)-1);
+            expectEquals(silent.findSilenceIn(0.1f, [] { return true; }), (juce::int64)-1);
+
+            ParallelSilenceScanner unreadable(
+                pool, [] { return std::unique_ptr<juce::AudioFormatReader>(); });
+            expectEquals(unreadable.findSilenceIn(0.1f), (juce::int64)-1);
+        }
+    }
+};
+
+static ParallelSilenceScanTest parallelSilenceScanTest;
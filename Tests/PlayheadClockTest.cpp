@@ -0,0 +1,85 @@
+#include "Core/PlayheadClock.h"
+#include <juce_core/juce_core.h>
+
+#include <cmath>
+
+class PlayheadClockTest : public juce::UnitTest {
+  public:
+    PlayheadClockTest() : juce::UnitTest("Playhead Clock Testing") {
+    }
+
+    void runTest() override {
+        beginTest("Only a running transport is predicted");
+        {
+            PlayheadClock clock;
+            double position = -1.0;
+            expect(!clock.predict(0.0, position));
+
+            clock.publish(clock.beginBlock(), 1.0, kBlockSeconds, false, 100.0);
+            expect(!clock.predict(105.0, position));
+            expectEquals(position, -1.0);
+        }
+
+        beginTest("Predictions advance with time but stop shortly after the last block");
+        {
+            PlayheadClock clock;
+            clock.publish(clock.beginBlock(), 1.0, kBlockSeconds, true, 100.0);
+
+            double position = 0.0;
+            expect(clock.predict(104.0, position));
+            expectWithinAbsoluteError(position, 1.004, 1.0e-9);
+
+            expect(clock.predict(90.0, position));
+            expectWithinAbsoluteError(position, 1.0, 1.0e-9);
+
+            expect(clock.predict(1000.0, position));
+            expectWithinAbsoluteError(position, 1.0 + 2.0 * kBlockSeconds, 1.0e-9);
+        }
+
+        beginTest("A seek retires the last stamp and blocks that raced it");
+        {
+            PlayheadClock clock;
+            clock.publish(clock.beginBlock(), 1.0, kBlockSeconds, true, 100.0);
+
+            const auto racing = clock.beginBlock();
+            clock.invalidate();
+            double position = 0.0;
+            expect(!clock.predict(101.0, position));
+
+            clock.publish(racing, 1.01, kBlockSeconds, true, 110.0);
+            expect(!clock.predict(111.0, position));
+
+            clock.publish(clock.beginBlock(), 5.0, kBlockSeconds, true, 120.0);
+            expect(clock.predict(121.0, position));
+            expectWithinAbsoluteError(position, 5.001, 1.0e-9);
+        }
+
+        beginTest("Callback jitter is filtered out of the prediction");
+        {
+            PlayheadClock clock;
+            const double jitterMs = 2.0;
+            double worstErrorMs = 0.0;
+
+            for (int block = 0; block < 200; ++block) {
+                const double idealMs = 1000.0 + block * kBlockSeconds * 1000.0;
+                const double callbackMs = idealMs + (block % 2 == 0 ? jitterMs : -jitterMs);
+                clock.publish(clock.beginBlock(), block * kBlockSeconds, kBlockSeconds, true,
+                              callbackMs);
+
+                const double queryMs = idealMs + 5.0;
+                double position = 0.0;
+                expect(clock.predict(queryMs, position));
+                if (block >= 100)
+                    worstErrorMs =
+                        juce::jmax(worstErrorMs, std::abs(position * 1000.0 - (queryMs - 1000.0)));
+            }
+
+            expectLessThan(worstErrorMs, 0.5);
+        }
+    }
+
+  private:
+    static constexpr double kBlockSeconds = 0.01;
+};
+
+static PlayheadClockTest playheadClockTest;
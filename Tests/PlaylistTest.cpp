@@ -0,0 +1,82 @@
+#include "Core/Playlist.h"
+#include <juce_core/juce_core.h>
+
+class PlaylistTest : public juce::UnitTest {
+  public:
+    PlaylistTest() : juce::UnitTest("Playlist Testing") {
+    }
+
+    void runTest() override {
+        const juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getChildFile("audiofiler_playlist_test");
+        tempDir.deleteRecursively();
+        tempDir.createDirectory();
+
+        const juce::File a = tempDir.getChildFile("a.wav");
+        const juce::File b = tempDir.getChildFile("b.wav");
+        const juce::File c = tempDir.getChildFile("c.wav");
+        const juce::File d = tempDir.getChildFile("d.wav");
+
+        beginTest("Files are sorted, deduplicated and start at the given file");
+        {
+            Playlist playlist;
+            expect(playlist.getCurrent() == juce::File());
+            expectEquals(playlist.getCurrentIndex(), -1);
+
+            playlist.setFiles({c, a, b, a}, b);
+            expectEquals(playlist.size(), 3);
+            expectEquals(playlist.getCurrentIndex(), 1);
+            expect(playlist.getCurrent() == b);
+
+            playlist.setFiles({c, a});
+            expect(playlist.getCurrent() == a);
+        }
+
+        beginTest("Stepping stops at both ends");
+        {
+            Playlist playlist;
+            playlist.setFiles({a, b}, a);
+            expect(!playlist.hasPrevious());
+            expect(playlist.moveToPrevious() == juce::File());
+            expect(playlist.getCurrent() == a);
+
+            expect(playlist.moveToNext() == b);
+            expect(!playlist.hasNext());
+            expect(playlist.moveToNext() == juce::File());
+            expect(playlist.getCurrent() == b);
+            expect(playlist.moveToPrevious() == a);
+        }
+
+        beginTest("Upcoming files follow the current one, nearest first");
+        {
+            Playlist playlist;
+            playlist.setFiles({a, b, c, d}, b);
+            const auto upcoming = playlist.getUpcoming(2);
+            expectEquals(upcoming.size(), 2);
+            expect(upcoming[0] == c);
+            expect(upcoming[1] == d);
+            expectEquals(playlist.getUpcoming(10).size(), 2);
+
+            playlist.moveToNext();
+            playlist.moveToNext();
+            expect(playlist.getUpcoming(3).isEmpty());
+        }
+
+        beginTest("A single file brings the matching files of its folder");
+        {
+            for (const auto &file : {a, b, c})
+                expect(file.replaceWithText("x"));
+            expect(tempDir.getChildFile("notes.txt").replaceWithText("x"));
+
+            Playlist playlist;
+            playlist.setFiles(Playlist::listFolderOf(b, "*.wav;*.aiff"), b);
+            expectEquals(playlist.size(), 3);
+            expect(playlist.getCurrent() == b);
+            expect(playlist.getUpcoming(5) == juce::Array<juce::File>{c});
+        }
+
+        tempDir.deleteRecursively();
+    }
+};
+
+static PlaylistTest playlistTest;
@@ -0,0 +1,145 @@
+#include "Core/ReadAheadBuffer.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+// Every sample is its own position: positive on the left channel, negative on the right.
+class RampSource : public juce::PositionableAudioSource {
+  public:
+    explicit RampSource(juce::int64 length) : lengthInSamples(length) {
+    }
+
+    void setNextReadPosition(juce::int64 newPosition) override {
+        position = newPosition;
+    }
+    juce::int64 getNextReadPosition() const override {
+        return position;
+    }
+    juce::int64 getTotalLength() const override {
+        return lengthInSamples;
+    }
+    bool isLooping() const override {
+        return false;
+    }
+    void setLooping(bool) override {
+    }
+    void prepareToPlay(int, double) override {
+    }
+    void releaseResources() override {
+    }
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) override {
+        for (int i = 0; i < bufferToFill.numSamples; ++i) {
+            const auto value = (float)(position + i);
+            for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+                bufferToFill.buffer->setSample(channel, bufferToFill.startSample + i,
+                                               channel == 0 ? value : -value);
+        }
+        position += bufferToFill.numSamples;
+    }
+
+    juce::int64 lengthInSamples;
+    juce::int64 position = 0;
+};
+
+class ReadAheadBufferTest : public juce::UnitTest {
+  public:
+    ReadAheadBufferTest() : juce::UnitTest("Read-Ahead Buffer Testing") {
+    }
+
+    void runTest() override {
+        juce::TimeSliceThread thread("ReadAheadBufferTest");
+        thread.startThread();
+
+        beginTest("Reads the source in order across the end of the ring");
+        {
+            RampSource source(100000);
+            ReadAheadBuffer buffer(source, thread, 2, kRingSize, 100);
+            juce::AudioBuffer<float> block(2, kBlockSize);
+
+            bool inOrder = true;
+            for (int i = 0; i < 20; ++i) {
+                expect(waitForReady(buffer, kBlockSize));
+                buffer.getNextAudioBlock(juce::AudioSourceChannelInfo(&block, 0, kBlockSize));
+                inOrder = inOrder && holdsRamp(block, kBlockSize, 100 + i * kBlockSize);
+            }
+            expect(inOrder);
+            expectEquals(buffer.getPosition(), (juce::int64)(100 + 20 * kBlockSize));
+        }
+
+        beginTest("A seek is pending until the reader takes it");
+        {
+            RampSource source(100000);
+            ReadAheadBuffer buffer(source, thread, 2, kRingSize, 0);
+            expect(waitForReady(buffer, kBlockSize));
+
+            buffer.seek(40000);
+            expectEquals(buffer.getPosition(), (juce::int64)40000);
+            expect(buffer.takeSeek());
+            expect(!buffer.takeSeek());
+
+            juce::AudioBuffer<float> block(2, kBlockSize);
+            expect(waitForReady(buffer, kBlockSize));
+            buffer.getNextAudioBlock(juce::AudioSourceChannelInfo(&block, 0, kBlockSize));
+            expect(holdsRamp(block, kBlockSize, 40000));
+            expectEquals(buffer.getPosition(), (juce::int64)(40000 + kBlockSize));
+        }
+
+        beginTest("An empty ring plays silence and does not move");
+        {
+            juce::TimeSliceThread idleThread("ReadAheadBufferIdle");
+            RampSource source(100000);
+            ReadAheadBuffer buffer(source, idleThread, 2, kRingSize, 500);
+            expectEquals(buffer.getNumReady(), 0);
+
+            juce::AudioBuffer<float> block(2, kBlockSize);
+            for (int channel = 0; channel < 2; ++channel)
+                juce::FloatVectorOperations::fill(block.getWritePointer(channel), 1.0f,
+                                                  kBlockSize);
+            buffer.getNextAudioBlock(juce::AudioSourceChannelInfo(&block, 0, kBlockSize));
+            expectEquals(block.getMagnitude(0, kBlockSize), 0.0f);
+            expectEquals(buffer.getPosition(), (juce::int64)500);
+        }
+
+        beginTest("Playback ends with the source");
+        {
+            RampSource source(3000);
+            ReadAheadBuffer buffer(source, thread, 2, kRingSize, 2500);
+            juce::AudioBuffer<float> block(2, kBlockSize);
+
+            expect(waitForReady(buffer, 500));
+            expect(!buffer.isFinished());
+            buffer.getNextAudioBlock(juce::AudioSourceChannelInfo(&block, 0, kBlockSize));
+            buffer.getNextAudioBlock(juce::AudioSourceChannelInfo(&block, 0, kBlockSize));
+            expect(buffer.isFinished());
+            expectEquals(buffer.getPosition(), (juce::int64)3000);
+            expectEquals(block.getSample(0, 500 - kBlockSize - 1), 2999.0f);
+            expectEquals(block.getMagnitude(500 - kBlockSize, 2 * kBlockSize - 500), 0.0f);
+        }
+
+        thread.stopThread(1000);
+    }
+
+  private:
+    static constexpr int kRingSize = 1000;
+    static constexpr int kBlockSize = 256;
+
+    static bool waitForReady(const ReadAheadBuffer &buffer, int numSamples) {
+        for (int attempt = 0; attempt < 500; ++attempt) {
+            if (buffer.getNumReady() >= numSamples)
+                return true;
+            juce::Thread::sleep(10);
+        }
+        return false;
+    }
+
+    static bool holdsRamp(const juce::AudioBuffer<float> &block, int numSamples,
+                          juce::int64 firstPosition) {
+        for (int i = 0; i < numSamples; ++i) {
+            const auto expected = (float)(firstPosition + i);
+            if (block.getSample(0, i) != expected || block.getSample(1, i) != -expected)
+                return false;
+        }
+        return true;
+    }
+};
+
+static ReadAheadBufferTest readAheadBufferTest;
@@ -0,0 +1,144 @@
+#include "Core/RegionRenderer.h"
+#include "TestWavWriter.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <cstring>
+#include <limits>
+
+class RegionRendererTest : public juce::UnitTest {
+  public:
+    RegionRendererTest() : juce::UnitTest("Region Renderer Testing") {
+    }
+
+    void runTest() override {
+        const juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getChildFile("audiofiler_region_renderer_test");
+        tempDir.deleteRecursively();
+        tempDir.createDirectory();
+
+        const juce::File source = tempDir.getChildFile("ramp.wav");
+        expect(writeRampWav(source, 1000));
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        RegionRenderer renderer(formatManager);
+
+        beginTest("WAV trims copy the PCM frames verbatim");
+        {
+            RegionRenderer::Request request = requestFor(source, tempDir.getChildFile("copy.wav"));
+            request.startSample = 100;
+            request.endSample = 400;
+            expect(RegionRenderer::canCopyBytes(request));
+            expect(renderer.render(request).wasOk());
+
+            juce::MemoryBlock sourceBytes, copyBytes;
+            expect(source.loadFileAsData(sourceBytes));
+            expect(request.destination.loadFileAsData(copyBytes));
+            expectEquals((int)copyBytes.getSize(), kHeaderBytes + 300 * kBytesPerFrame);
+            if (copyBytes.getSize() != (size_t)(kHeaderBytes + 300 * kBytesPerFrame))
+                return;
+
+            const auto *src = static_cast<const char *>(sourceBytes.getData());
+            const auto *dst = static_cast<const char *>(copyBytes.getData());
+            expectEquals((int)juce::ByteOrder::littleEndianInt(dst + 4),
+                         kHeaderBytes - 8 + 300 * kBytesPerFrame);
+            expect(std::memcmp(src + 12, dst + 12, 24) == 0, "fmt chunk was not kept");
+            expectEquals((int)juce::ByteOrder::littleEndianInt(dst + 40), 300 * kBytesPerFrame);
+            expect(std::memcmp(src + kHeaderBytes + 100 * kBytesPerFrame, dst + kHeaderBytes,
+                               300 * kBytesPerFrame) == 0,
+                   "PCM frames differ");
+        }
+
+        beginTest("The region is clamped to the file");
+        {
+            RegionRenderer::Request request = requestFor(source, tempDir.getChildFile("end.wav"));
+            request.startSample = 900;
+            request.endSample = 5000;
+            expect(renderer.render(request).wasOk());
+            expectEquals(request.destination.getSize(),
+                         (juce::int64)(kHeaderBytes + 100 * kBytesPerFrame));
+
+            request.startSample = 2000;
+            expect(renderer.render(request).failed());
+        }
+
+        beginTest("Fades, other formats and other sources decode");
+        {
+            RegionRenderer::Request request = requestFor(source, tempDir.getChildFile("a.wav"));
+            request.fadeInSamples = 10;
+            expect(!RegionRenderer::canCopyBytes(request));
+
+            const juce::File flac = tempDir.getChildFile("a.flac");
+            expect(!RegionRenderer::canCopyBytes(requestFor(source, flac)));
+            expect(!RegionRenderer::canCopyBytes(
+                requestFor(tempDir.getChildFile("a.aiff"), tempDir.getChildFile("b.wav"))));
+        }
+
+        beginTest("Cancelled renders leave no file and never overwrite the source");
+        {
+            const juce::File cancelled = tempDir.getChildFile("cancelled.wav");
+            RegionRenderer::Request request = requestFor(source, cancelled);
+            expect(renderer.render(request, [] { return true; }).failed());
+            expect(!cancelled.existsAsFile());
+
+            request.fadeOutSamples = 10;
+            expect(renderer.render(request, [] { return true; }).failed());
+            expect(!cancelled.existsAsFile());
+
+            juce::MemoryBlock before, after;
+            expect(source.loadFileAsData(before));
+            expect(renderer.render(requestFor(source, source)).failed());
+            expect(source.loadFileAsData(after) && after == before);
+        }
+
+        beginTest("Encoded renders fade both ends of the region");
+        {
+            RegionRenderer::Request request = requestFor(source, tempDir.getChildFile("fade.wav"));
+            request.startSample = 100;
+            request.endSample = 400;
+            request.fadeInSamples = request.fadeOutSamples = 10;
+            request.fadeCurve = Config::Audio::FadeCurve::Linear;
+            expect(renderer.render(request).wasOk());
+
+            std::unique_ptr<juce::AudioFormatReader> reader(
+                formatManager.createReaderFor(request.destination));
+            expect(reader != nullptr);
+            if (reader == nullptr)
+                return;
+
+            expectEquals(reader->lengthInSamples, (juce::int64)300);
+            juce::AudioBuffer<float> rendered(1, 300);
+            reader->read(&rendered, 0, 300, 0, true, false);
+
+            const float step = 1.0f / 32768.0f;
+            expectWithinAbsoluteError(rendered.getSample(0, 0), 100.0f * step * 0.05f, step);
+            expectWithinAbsoluteError(rendered.getSample(0, 150), 250.0f * step, step);
+            expectWithinAbsoluteError(rendered.getSample(0, 299), 399.0f * step * 0.05f, step);
+        }
+
+        tempDir.deleteRecursively();
+    }
+
+  private:
+    static constexpr int kHeaderBytes = TestWavWriter::headerBytes;
+    static constexpr int kBytesPerFrame = 4;
+
+    static RegionRenderer::Request requestFor(const juce::File &source,
+                                              const juce::File &destination) {
+        RegionRenderer::Request request;
+        request.source = source;
+        request.destination = destination;
+        request.endSample = std::numeric_limits<juce::int64>::max();
+        return request;
+    }
+
+    /** Writes a 16-bit stereo PCM WAV holding the frame index left and its negation right. */
+    static bool writeRampWav(const juce::File &file, int numFrames) {
+        return TestWavWriter::write(file, 2, 44100, numFrames, [](int frame, int channel) {
+            return (short)(channel == 0 ? frame : -frame);
+        });
+    }
+};
+
+static RegionRendererTest regionRendererTest;
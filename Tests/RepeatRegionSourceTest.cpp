@@ -0,0 +1,171 @@
+#include "Core/RepeatRegionSource.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+// Every sample holds its own file position, so any output reveals where it was read from.
+class RampMockReader : public juce::AudioFormatReader {
+  public:
+    explicit RampMockReader(juce::int64 length)
+        : juce::AudioFormatReader(nullptr, "RampMockReader") {
+        lengthInSamples = length;
+        numChannels = 2;
+        sampleRate = 44100.0;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        for (int ch = 0; ch < numDestChannels; ++ch) {
+            if (destSamples[ch] == nullptr)
+                continue;
+            float *dest = (float *)destSamples[ch] + startOffsetInDestBuffer;
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = (float)(startSampleInFile + i);
+        }
+        return true;
+    }
+};
+
+class RepeatRegionSourceTest : public juce::UnitTest {
+  public:
+    RepeatRegionSourceTest() : juce::UnitTest("Repeat Region Source Testing") {
+    }
+
+    void runTest() override {
+        beginTest("Without a region the file plays through and ends");
+        {
+            RepeatRegionSource source(new RampMockReader(10000), true, 0, kLinear);
+            expectEquals(source.getTotalLength(), (juce::int64)10000);
+
+            source.setNextReadPosition(9990);
+            const auto block = render(source, 20);
+            expectEquals(block.getSample(0, 9), 9999.0f);
+            expectEquals(block.getSample(0, 10), 0.0f);
+            expectEquals(block.getSample(1, 19), 0.0f);
+        }
+
+        beginTest("A bounded region ends on the exact cut-out sample");
+        {
+            RepeatRegionSource source(new RampMockReader(10000), true, 0, kLinear);
+            source.setRegion(region(false, 100, 1000), 0);
+            source.restartAt(100);
+            source.setNextReadPosition(100);
+            expectEquals(source.getTotalLength(), (juce::int64)1000);
+
+            const auto block = render(source, 1024);
+            expectEquals(block.getSample(0, 0), 100.0f);
+            expectEquals(block.getSample(0, 899), 999.0f);
+            expectEquals(block.getSample(0, 900), 0.0f);
+            expectEquals(block.getSample(1, 1023), 0.0f);
+        }
+
+        beginTest("Repeats splice inside a block without seeking the timeline");
+        {
+            RepeatRegionSource source(new RampMockReader(10000), true, 0, kLinear);
+            source.setRegion(region(true, 100, 1000), 0);
+            source.restartAt(100);
+            source.setNextReadPosition(100);
+
+            bool seamless = true;
+            juce::int64 timeline = 100;
+            for (int blockIndex = 0; blockIndex < 10; ++blockIndex) {
+                const auto block = render(source, 300);
+                for (int i = 0; i < 300; ++i, ++timeline)
+                    seamless = seamless && block.getSample(1, i) == (float)expectedAt(timeline);
+            }
+
+            expect(seamless, "A repeat left a gap or a jump");
+            expectEquals(source.getNextReadPosition(), timeline);
+            expect(source.getTotalLength() > timeline);
+            expectEquals(source.toFilePosition(100 + 950), (juce::int64)150);
+        }
+
+        beginTest("Cut boundaries fade in and out");
+        {
+            RepeatRegionSource source(new RampMockReader(10000), true, 10, kLinear);
+            source.setRegion(region(false, 100, 1000), 0);
+            source.restartAt(100);
+            source.setNextReadPosition(100);
+
+            const auto block = render(source, 1000);
+            expectWithinAbsoluteError(block.getSample(0, 0), 100.0f * 0.05f, 1.0e-3f);
+            expectWithinAbsoluteError(block.getSample(1, 9), 109.0f * 0.95f, 1.0e-3f);
+            expectEquals(block.getSample(0, 10), 110.0f);
+            expectEquals(block.getSample(0, 889), 989.0f);
+            expectWithinAbsoluteError(block.getSample(0, 890), 990.0f * 0.95f, 1.0e-3f);
+            expectWithinAbsoluteError(block.getSample(1, 899), 999.0f * 0.05f, 1.0e-3f);
+            expectEquals(block.getSample(0, 900), 0.0f);
+        }
+
+        beginTest("Playback entered mid-region does not fade in");
+        {
+            RepeatRegionSource source(new RampMockReader(10000), true, 10, kLinear);
+            source.setRegion(region(false, 100, 1000), 0);
+            source.restartAt(500);
+            source.setNextReadPosition(500);
+            expectEquals(render(source, 4).getSample(0, 0), 500.0f);
+        }
+
+        beginTest("The crossfade mixes the tail into the cut-in region");
+        {
+            RepeatRegionSource source(new RampMockReader(10000), true, 10, kLinear);
+            source.setRegion(region(true, 100, 1000), 0);
+            source.restartAt(100);
+            source.setNextReadPosition(100);
+
+            // A fade split across blocks continues where it stopped.
+            const auto first = render(source, 893);
+            const auto second = render(source, 107);
+            expectEquals(first.getSample(0, 889), 989.0f);
+            expectWithinAbsoluteError(first.getSample(0, 890), 990.0f * 0.95f + 100.0f * 0.05f,
+                                      1.0e-3f);
+            expectWithinAbsoluteError(second.getSample(0, 2), 995.0f * 0.45f + 105.0f * 0.55f,
+                                      1.0e-3f);
+            expectEquals(second.getSample(0, 7), 110.0f);
+            expectEquals(source.toFilePosition(100 + 895), (juce::int64)995);
+        }
+
+        beginTest("A new region applies from the given position without a jump");
+        {
+            RepeatRegionSource source(new RampMockReader(10000), true, 0, kLinear);
+            render(source, 200);
+
+            source.setRegion(region(true, 0, 300), 200);
+            const auto block = render(source, 200);
+            expectEquals(block.getSample(0, 0), 200.0f);
+            expectEquals(block.getSample(0, 99), 299.0f);
+            expectEquals(block.getSample(0, 100), 0.0f);
+
+            // Turning repetition off ends the timeline at cutOut of the current pass.
+            source.setRegion(region(false, 0, 300), source.getNextReadPosition());
+            expectEquals(source.getTotalLength(), source.getNextReadPosition() + 200);
+        }
+    }
+
+  private:
+    static constexpr Config::Audio::FadeCurve kLinear = Config::Audio::FadeCurve::Linear;
+
+    static RepeatRegionSource::Region region(bool repeating, juce::int64 cutIn,
+                                             juce::int64 cutOut) {
+        RepeatRegionSource::Region r;
+        r.bounded = true;
+        r.repeating = repeating;
+        r.cutIn = cutIn;
+        r.cutOut = cutOut;
+        return r;
+    }
+
+    static juce::int64 expectedAt(juce::int64 timeline) {
+        return 100 + (timeline - 100) % 900;
+    }
+
+    static juce::AudioBuffer<float> render(RepeatRegionSource &source, int numSamples) {
+        juce::AudioBuffer<float> block(2, numSamples);
+        source.getNextAudioBlock(juce::AudioSourceChannelInfo(&block, 0, numSamples));
+        return block;
+    }
+};
+
+static RepeatRegionSourceTest repeatRegionSourceTest;
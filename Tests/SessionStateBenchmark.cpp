@@ -0,0 +1,121 @@
+#include "Core/SessionState.h"
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Burns a fixed time, like a listener that repaints or re-lays out on every change.
+static void spinFor(double microseconds) {
+    const double until = juce::Time::getMillisecondCounterHiRes() + microseconds / 1000.0;
+    while (juce::Time::getMillisecondCounterHiRes() < until) {
+    }
+}
+
+// The previous model: one lock for readers and writers, listeners called while it is held.
+class LockedSessionState {
+  public:
+    MainDomain::CutPreferences getCutPrefs() const {
+        const juce::ScopedLock lock(stateLock);
+        return cutPrefs;
+    }
+
+    void setCutIn(double value) {
+        const juce::ScopedLock lock(stateLock);
+        cutPrefs.cutIn = value;
+        spinFor(kListenerMicroseconds);
+    }
+
+    static constexpr double kListenerMicroseconds = 20.0;
+
+  private:
+    MainDomain::CutPreferences cutPrefs;
+    juce::CriticalSection stateLock;
+};
+
+class SlowListener : public SessionState::Listener {
+  public:
+    void cutPreferenceChanged(const MainDomain::CutPreferences &) override {
+        spinFor(LockedSessionState::kListenerMicroseconds);
+    }
+};
+
+class SessionStateBenchmark : public juce::UnitTest {
+  public:
+    SessionStateBenchmark() : juce::UnitTest("Session State Contention Benchmark", "Benchmarks") {
+    }
+
+    void runTest() override {
+        const int numReaders = juce::jmax(2, juce::SystemStats::getNumCpus() - 1);
+
+        beginTest("Reads per reader while one writer drags a cut point");
+        {
+            LockedSessionState locked;
+            runCase("Locked (legacy)", numReaders, [&locked] { return locked.getCutPrefs(); },
+                    [&locked](double value) { locked.setCutIn(value); });
+
+            SessionState state;
+            state.setTotalDuration(1.0e6);
+            state.setCutOut(1.0e6);
+            SlowListener listener;
+            state.addListener(&listener);
+            runCase("Snapshot", numReaders, [&state] { return state.getCutPrefs(); },
+                    [&state](double value) { state.setCutIn(value); });
+            state.removeListener(&listener);
+        }
+    }
+
+  private:
+    void runCase(const juce::String &name, int numReaders,
+                 const std::function<MainDomain::CutPreferences()> &read,
+                 const std::function<void(double)> &write) {
+        constexpr int kRunMs = 500;
+        std::atomic<bool> stop{false};
+        std::atomic<juce::int64> totalReads{0};
+        std::atomic<juce::int64> worstReadNs{0};
+        std::atomic<juce::int64> writes{0};
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < numReaders; ++i)
+            readers.emplace_back([&] {
+                juce::int64 reads = 0;
+                juce::int64 worst = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    juce::ignoreUnused(read());
+                    const auto ticks = juce::Time::getHighResolutionTicks() - start;
+                    worst = juce::jmax(worst, ticks);
+                    ++reads;
+                }
+                totalReads += reads;
+                const auto worstNs = (juce::int64)(juce::Time::highResolutionTicksToSeconds(worst) *
+                                                   1.0e9);
+                juce::int64 seen = worstReadNs.load();
+                while (worstNs > seen && !worstReadNs.compare_exchange_weak(seen, worstNs)) {
+                }
+            });
+
+        std::thread writer([&] {
+            for (double value = 0.0; !stop.load(std::memory_order_relaxed); value += 1.0) {
+                write(value);
+                ++writes;
+            }
+        });
+
+        juce::Thread::sleep(kRunMs);
+        stop = true;
+        writer.join();
+        for (auto &reader : readers)
+            reader.join();
+
+        expect(totalReads.load() > 0);
+        const double readsPerMs = (double)totalReads.load() / numReaders / kRunMs;
+        logMessage(name.paddedRight(' ', 20) + juce::String(readsPerMs, 1) +
+                   " reads/ms per reader, worst read " +
+                   juce::String((double)worstReadNs.load() / 1000.0, 1) + " us, " +
+                   juce::String(writes.load()) + " writes");
+    }
+};
+
+static SessionStateBenchmark sessionStateBenchmark;
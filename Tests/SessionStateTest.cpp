@@ -0,0 +1,208 @@
+#include "Core/SessionState.h"
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+class SessionStateTest : public juce::UnitTest {
+  public:
+    SessionStateTest() : juce::UnitTest("Session State Testing") {
+    }
+
+    void runTest() override {
+        beginTest("Cut points are clamped and listeners get the new values");
+        {
+            SessionState state;
+            RecordingListener listener;
+            state.addListener(&listener);
+            state.setTotalDuration(10.0);
+
+            state.setCutOut(12.0);
+            expectEquals(state.getCutOut(), 10.0);
+            state.setCutIn(11.0);
+            expectEquals(state.getCutIn(), 10.0);
+            expectEquals(listener.lastCutIn, 10.0);
+            expectEquals(listener.lastPrefs.cutOut, 10.0);
+
+            state.removeListener(&listener);
+        }
+
+        beginTest("Every change publishes a new version, and only changes do");
+        {
+            SessionState state;
+            const auto before = state.getSnapshot().version;
+            state.setCutActive(true);
+            const auto after = state.getSnapshot();
+            expect(after.version > before);
+            expect(after.cutPrefs.active);
+
+            state.setCutActive(true);
+            expectEquals((juce::int64)state.getSnapshot().version, (juce::int64)after.version);
+        }
+
+        beginTest("Metadata follows the current file");
+        {
+            SessionState state;
+            state.setTotalDuration(10.0);
+            FileMetadata metadata;
+            metadata.cutIn = 6.0;
+            metadata.cutOut = 2.0;
+            state.setMetadataForFile("a.wav", metadata);
+            expect(state.hasMetadataForFile("a.wav"));
+            expect(!state.hasMetadataForFile("b.wav"));
+
+            state.setCurrentFilePath("a.wav");
+            expectEquals(state.getCutIn(), 2.0);
+            expectEquals(state.getCutOut(), 6.0);
+
+            state.setCutIn(3.0);
+            expectEquals(state.getCurrentMetadata().cutIn, 3.0);
+            expectEquals(state.getMetadataForFile("a.wav").cutIn, 3.0);
+        }
+
+        beginTest("Listeners run outside the lock, so other threads are never held up");
+        {
+            SessionState state;
+            state.setTotalDuration(10.0);
+            BlockingListener listener(state);
+            state.addListener(&listener);
+
+            state.setCutActive(true);
+            expect(listener.otherThreadFinished);
+            expectEquals(state.getCutPrefs().autoCut.thresholdIn, 0.5f);
+
+            state.removeListener(&listener);
+        }
+
+        beginTest("Concurrent writers leave listeners on the final state");
+        {
+            SessionState state;
+            state.setTotalDuration(100.0);
+            LockedRecordingListener listener;
+            state.addListener(&listener);
+
+            const auto write = [&state](double offset) {
+                for (int i = 0; i < 2000; ++i) {
+                    const double base = offset + (double)(i % 40);
+                    state.setCutOut(base + 5.0);
+                    state.setCutIn(base);
+                    state.setThresholdIn((float)base / 100.0f);
+                }
+            };
+            std::thread first(write, 0.0);
+            std::thread second(write, 50.0);
+            first.join();
+            second.join();
+
+            const auto finalPrefs = state.getCutPrefs();
+            const auto delivered = listener.get();
+            expectEquals(delivered.prefs.cutIn, finalPrefs.cutIn);
+            expectEquals(delivered.prefs.cutOut, finalPrefs.cutOut);
+            expectEquals(delivered.prefs.autoCut.thresholdIn, finalPrefs.autoCut.thresholdIn);
+            expectEquals(delivered.cutIn, finalPrefs.cutIn);
+            expectEquals(delivered.cutOut, finalPrefs.cutOut);
+
+            state.removeListener(&listener);
+        }
+
+        beginTest("Concurrent readers always see a consistent cut region");
+        {
+            SessionState state;
+            state.setTotalDuration(100.0);
+            std::atomic<bool> stop{false};
+
+            std::thread writer([&state, &stop] {
+                for (int i = 0; !stop.load(); ++i) {
+                    const double base = (double)(i % 50);
+                    state.setCutOut(base + 10.0);
+                    state.setCutIn(base);
+                    state.setCutIn(0.0);
+                    state.setCutOut(base + 1.0);
+                }
+            });
+
+            bool consistent = true;
+            bool monotonic = true;
+            juce::uint64 lastVersion = 0;
+            for (int i = 0; i < 100000; ++i) {
+                const auto snapshot = state.getSnapshot();
+                consistent = consistent && snapshot.cutPrefs.cutIn <= snapshot.cutPrefs.cutOut;
+                monotonic = monotonic && snapshot.version >= lastVersion;
+                lastVersion = snapshot.version;
+            }
+
+            stop = true;
+            writer.join();
+            expect(consistent, "a reader saw cutIn after cutOut");
+            expect(monotonic, "a reader saw the version go backwards");
+        }
+    }
+
+  private:
+    struct RecordingListener : SessionState::Listener {
+        void cutPreferenceChanged(const MainDomain::CutPreferences &prefs) override {
+            lastPrefs = prefs;
+        }
+        void cutInChanged(double value) override {
+            lastCutIn = value;
+        }
+
+        MainDomain::CutPreferences lastPrefs;
+        double lastCutIn{-1.0};
+    };
+
+    /** Records the last values delivered, from whichever thread delivers them. */
+    struct LockedRecordingListener : SessionState::Listener {
+        struct Delivered {
+            MainDomain::CutPreferences prefs;
+            double cutIn{-1.0};
+            double cutOut{-1.0};
+        };
+
+        void cutPreferenceChanged(const MainDomain::CutPreferences &prefs) override {
+            const std::lock_guard<std::mutex> lock(mutex);
+            delivered.prefs = prefs;
+        }
+        void cutInChanged(double value) override {
+            const std::lock_guard<std::mutex> lock(mutex);
+            delivered.cutIn = value;
+        }
+        void cutOutChanged(double value) override {
+            const std::lock_guard<std::mutex> lock(mutex);
+            delivered.cutOut = value;
+        }
+
+        Delivered get() {
+            const std::lock_guard<std::mutex> lock(mutex);
+            return delivered;
+        }
+
+        std::mutex mutex;
+        Delivered delivered;
+    };
+
+    /** Waits in its callback for another thread that reads and writes the same state. */
+    struct BlockingListener : SessionState::Listener {
+        explicit BlockingListener(SessionState &stateIn) : state(stateIn) {
+        }
+
+        void cutPreferenceChanged(const MainDomain::CutPreferences &prefs) override {
+            if (!prefs.active || started.exchange(true))
+                return;
+
+            std::thread other([this] {
+                juce::ignoreUnused(state.getCutPrefs());
+                state.setThresholdIn(0.5f);
+                otherThreadFinished = true;
+            });
+            other.join();
+        }
+
+        SessionState &state;
+        std::atomic<bool> started{false};
+        std::atomic<bool> otherThreadFinished{false};
+    };
+};
+
+static SessionStateTest sessionStateTest;
@@ -1,6 +1,8 @@
+#include "Core/EnvelopeBuilder.h"
 #include "Workers/SilenceAnalysisAlgorithms.h"
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_core/juce_core.h>
+#include <vector>
 
 // Mock Reader that simulates a large file (e.g. 3 billion samples)
 class LargeFileMockReader : public juce::AudioFormatReader {
@@ -39,6 +41,38 @@ class LargeFileMockReader : public juce::AudioFormatReader {
     }
 };
 
+// Mock Reader backed by per-channel sample vectors
+class BufferMockReader : public juce::AudioFormatReader {
+  public:
+    BufferMockReader(std::vector<std::vector<float>> channelData)
+        : juce::AudioFormatReader(nullptr, "BufferMockReader"), data(std::move(channelData)) {
+        lengthInSamples = (juce::int64)data[0].size();
+        numChannels = (unsigned int)data.size();
+        sampleRate = 48000.0;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        for (int ch = 0; ch < numDestChannels; ++ch) {
+            if (destSamples[ch] == nullptr)
+                continue;
+            float *dest = (float *)destSamples[ch] + startOffsetInDestBuffer;
+            for (int i = 0; i < numSamples; ++i) {
+                const juce::int64 pos = startSampleInFile + i;
+                dest[i] = (ch < (int)data.size() && pos < lengthInSamples)
+                              ? data[(size_t)ch][(size_t)pos]
+                              : 0.0f;
+            }
+        }
+        return true;
+    }
+
+  private:
+    std::vector<std::vector<float>> data;
+};
+
 class SilenceAnalysisTest : public juce::UnitTest {
   public:
     SilenceAnalysisTest() : juce::UnitTest("Silence Analysis Large File Test") {
@@ -71,6 +105,77 @@ class SilenceAnalysisTest : public juce::UnitTest {
         // Short reader with same signal logic: signalPos is 2.5B, so it's outside range.
         // Should return -1.
         expect(SilenceAnalysisAlgorithms::findSilenceIn(shortReader, 0.1f) == -1);
+
+        beginTest("Threshold Kernel - Block Boundaries");
+        {
+            std::vector<float> samples(5000, 0.05f);
+            expectEquals(SilenceAnalysisAlgorithms::findFirstAboveThreshold(
+                             samples.data(), (int)samples.size(), 0.1f),
+                         -1);
+            expectEquals(SilenceAnalysisAlgorithms::findLastAboveThreshold(
+                             samples.data(), (int)samples.size(), 0.1f),
+                         -1);
+
+            // Negative excursions count, and hits straddle the 1024-sample sub-blocks.
+            samples[1023] = -0.5f;
+            samples[1024] = 0.5f;
+            samples[4999] = 0.2f;
+            expectEquals(SilenceAnalysisAlgorithms::findFirstAboveThreshold(
+                             samples.data(), (int)samples.size(), 0.1f),
+                         1023);
+            expectEquals(SilenceAnalysisAlgorithms::findLastAboveThreshold(
+                             samples.data(), (int)samples.size(), 0.1f),
+                         4999);
+            expectEquals(
+                SilenceAnalysisAlgorithms::findLastAboveThreshold(samples.data(), 4999, 0.1f),
+                1024);
+
+            // A sample exactly at the threshold is still silence.
+            std::vector<float> edge(10, 0.1f);
+            expectEquals(SilenceAnalysisAlgorithms::findFirstAboveThreshold(edge.data(), 10, 0.1f),
+                         -1);
+        }
+
+        beginTest("Multi-Channel Merge");
+        {
+            const size_t length = 200000; // spans several read chunks
+            std::vector<std::vector<float>> channels(3, std::vector<float>(length, 0.0f));
+            channels[0][150000] = 0.8f;
+            channels[1][70000] = -0.8f; // earliest, on a later channel
+            channels[2][90000] = 0.8f;
+            channels[0][100000] = 0.8f;
+            channels[2][180000] = -0.8f; // latest, on the last channel
+            BufferMockReader multiReader(channels);
+
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(multiReader, 0.1f),
+                         (juce::int64)70000);
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(multiReader, 0.1f),
+                         (juce::int64)180000);
+
+            beginTest("Envelope Fast Path Matches Full Scan");
+            auto envelope = EnvelopeBuilder::buildFromReader(multiReader);
+            expect(envelope != nullptr);
+            if (envelope != nullptr) {
+                for (float threshold : {0.05f, 0.5f, 0.79f, 0.8f}) {
+                    expectEquals(
+                        SilenceAnalysisAlgorithms::findSilenceIn(*envelope, multiReader, threshold),
+                        SilenceAnalysisAlgorithms::findSilenceIn(multiReader, threshold));
+                    expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(*envelope, multiReader,
+                                                                           threshold),
+                                 SilenceAnalysisAlgorithms::findSilenceOut(multiReader, threshold));
+                }
+
+                beginTest("Stale Envelope Reports A Mismatch Instead Of Scanning");
+                std::vector<std::vector<float>> silent(3, std::vector<float>(length, 0.0f));
+                BufferMockReader changedReader(silent);
+                expectEquals(
+                    SilenceAnalysisAlgorithms::findSilenceIn(*envelope, changedReader, 0.1f),
+                    SilenceAnalysisAlgorithms::envelopeMismatch);
+                expectEquals(
+                    SilenceAnalysisAlgorithms::findSilenceOut(*envelope, changedReader, 0.1f),
+                    SilenceAnalysisAlgorithms::envelopeMismatch);
+            }
+        }
     }
 };
 
@@ -0,0 +1,116 @@
+#include "Workers/ParallelSilenceScanner.h"
+#include "Workers/ScanScheduler.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+// Silent mock reader with a single spike near the end, so the In scan walks the whole file.
+class SilentMockReader : public juce::AudioFormatReader {
+  public:
+    SilentMockReader(juce::int64 length, int channels, double rate)
+        : juce::AudioFormatReader(nullptr, "SilentMockReader") {
+        lengthInSamples = length;
+        numChannels = (unsigned int)channels;
+        sampleRate = rate;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        const juce::int64 signalPos = lengthInSamples - 10;
+        for (int ch = 0; ch < numDestChannels; ++ch) {
+            if (destSamples[ch] == nullptr)
+                continue;
+            float *buffer = (float *)destSamples[ch] + startOffsetInDestBuffer;
+            juce::FloatVectorOperations::clear(buffer, numSamples);
+            if (signalPos >= startSampleInFile && signalPos < startSampleInFile + numSamples)
+                buffer[signalPos - startSampleInFile] = 1.0f;
+        }
+        return true;
+    }
+};
+
+// Runs one scan on its own thread so the OS priority of the policy is actually applied.
+class ScanBenchmarkThread : public juce::Thread {
+  public:
+    ScanBenchmarkThread(juce::AudioFormatReader &readerIn, AppEnums::ScanPolicy policyIn,
+                        bool emulateLegacySleep)
+        : juce::Thread("ScanBenchmark"), reader(readerIn), policy(policyIn),
+          legacySleep(emulateLegacySleep) {
+    }
+
+    void run() override {
+        // The legacy throttle slept 1 ms per chunk; emulate it through the exit predicate.
+        ScanScheduler scheduler(policy, [this] {
+            if (legacySleep)
+                juce::Thread::sleep(1);
+            return threadShouldExit();
+        });
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        result = SilenceAnalysisAlgorithms::findSilenceIn(reader, 0.1f, &scheduler);
+        elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+        numYields = scheduler.getNumYields();
+    }
+
+    juce::AudioFormatReader &reader;
+    AppEnums::ScanPolicy policy;
+    bool legacySleep;
+    juce::int64 result{-1};
+    double elapsedMs{0.0};
+    int numYields{0};
+};
+
+class SilenceScanBenchmark : public juce::UnitTest {
+  public:
+    SilenceScanBenchmark() : juce::UnitTest("Silence Scan Scheduling Benchmark", "Benchmarks") {
+    }
+
+    void runTest() override {
+        // 10 minutes of 48 kHz stereo: ~440 chunks of 65536 samples.
+        const juce::int64 length = (juce::int64)48000 * 60 * 10;
+        SilentMockReader reader(length, 2, 48000.0);
+
+        beginTest("Scan wall-time per scheduling policy");
+        runCase(reader, "Legacy 1 ms sleep", AppEnums::ScanPolicy::FullSpeed, true);
+        runCase(reader, "FullSpeed", AppEnums::ScanPolicy::FullSpeed, false);
+        runCase(reader, "Background", AppEnums::ScanPolicy::Background, false);
+        runCase(reader, "TimeBudgeted", AppEnums::ScanPolicy::TimeBudgeted, false);
+
+        beginTest("Worst-case scan wall-time, serial vs parallel segments");
+        runParallelCase(length, 1);
+        runParallelCase(length, juce::SystemStats::getNumCpus());
+    }
+
+  private:
+    void runParallelCase(juce::int64 length, int numThreads) {
+        juce::ThreadPool pool(numThreads);
+        ParallelSilenceScanner scanner(
+            pool, [length] { return std::make_unique<SilentMockReader>(length, 2, 48000.0); });
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        expectEquals(scanner.findSilenceIn(0.1f), length - 10);
+        const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+
+        const juce::String name = "Parallel x" + juce::String(numThreads);
+        logMessage(name.paddedRight(' ', 20) + juce::String(elapsedMs, 2) + " ms");
+    }
+
+    void runCase(juce::AudioFormatReader &reader, const juce::String &name,
+                 AppEnums::ScanPolicy policy, bool legacySleep) {
+        ScanBenchmarkThread thread(reader, policy, legacySleep);
+        thread.startThread(ScanScheduler::priorityFor(policy));
+        expect(thread.waitForThreadToExit(60000), name + " scan did not finish");
+
+        expectEquals(thread.result, reader.lengthInSamples - 10);
+
+        const double audioSeconds = (double)reader.lengthInSamples / reader.sampleRate;
+        const double msPerSecondOfAudio = thread.elapsedMs / audioSeconds;
+        logMessage(name.paddedRight(' ', 20) + juce::String(thread.elapsedMs, 2) + " ms  (" +
+                   juce::String(msPerSecondOfAudio, 4) + " ms per audio second, " +
+                   juce::String(thread.numYields) + " yields)");
+    }
+};
+
+static SilenceScanBenchmark silenceScanBenchmark;
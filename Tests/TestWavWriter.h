@@ -0,0 +1,46 @@
+#ifndef AUDIOFILER_TESTWAVWRITER_H
+#define AUDIOFILER_TESTWAVWRITER_H
+
+#include <juce_core/juce_core.h>
+
+#include <functional>
+
+/**
+ * @brief Writes test fixtures as canonical 16-bit PCM WAV files.
+ * @details The file is laid out by hand (a 44-byte header followed by interleaved frames), so
+ *          tests can rely on exact byte offsets and do not depend on the writer under test.
+ */
+class TestWavWriter {
+  public:
+    /** Returns the sample of `channel` in frame `frame`. */
+    using SampleGenerator = std::function<short(int frame, int channel)>;
+
+    static constexpr int headerBytes = 44;
+
+    static bool write(const juce::File &file, int numChannels, int sampleRate, int numFrames,
+                      const SampleGenerator &sampleAt) {
+        const int bytesPerFrame = numChannels * 2;
+        const int dataBytes = numFrames * bytesPerFrame;
+
+        juce::MemoryOutputStream out;
+        out.write("RIFF", 4);
+        out.writeInt(headerBytes - 8 + dataBytes);
+        out.write("WAVEfmt ", 8);
+        out.writeInt(16);
+        out.writeShort(1);
+        out.writeShort((short)numChannels);
+        out.writeInt(sampleRate);
+        out.writeInt(sampleRate * bytesPerFrame);
+        out.writeShort((short)bytesPerFrame);
+        out.writeShort(16);
+        out.write("data", 4);
+        out.writeInt(dataBytes);
+        for (int frame = 0; frame < numFrames; ++frame)
+            for (int channel = 0; channel < numChannels; ++channel)
+                out.writeShort(sampleAt(frame, channel));
+
+        return file.replaceWithData(out.getData(), out.getDataSize());
+    }
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "Core/WaveformLod.h"
+#include "Utils/Config.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+class WaveformLodBenchmark : public juce::UnitTest {
+  public:
+    WaveformLodBenchmark() : juce::UnitTest("Waveform LOD Benchmark", "Benchmarks") {
+    }
+
+    void runTest() override {
+        // One hour of 48 kHz stereo, drawn across a 4K display.
+        const juce::int64 length = (juce::int64)48000 * 3600;
+        const int chunk = Config::Audio::envelopeReadChunkSize;
+        const int numColumns = 3840;
+
+        juce::AudioBuffer<float> buffer(2, chunk);
+        juce::Random random(42);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < chunk; ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        WaveformLod lod(2, length, 48000.0);
+
+        beginTest("Pyramid build");
+        {
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            for (juce::int64 position = 0; position < length; position += chunk) {
+                const auto numSamples = juce::jmin((juce::int64)chunk, length - position);
+                lod.addBlock(position, buffer, (int)numSamples);
+            }
+            const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+            expectEquals(lod.getNumSamplesReady(), length);
+            logMessage(juce::String("build").paddedRight(' ', 20) + juce::String(elapsedMs, 3) +
+                       " ms");
+        }
+
+        beginTest("Column queries for a full repaint");
+        {
+            std::vector<float> mins((size_t)numColumns), maxs((size_t)numColumns);
+            const double views[] = {(double)length, (double)length / 64.0, 48000.0};
+            for (const double viewSamples : views) {
+                const double start = juce::Time::getMillisecondCounterHiRes();
+                for (int channel = 0; channel < 2; ++channel)
+                    lod.getColumns(channel, 0.0, viewSamples / numColumns, numColumns,
+                                   mins.data(), maxs.data());
+                const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - start;
+                expect(maxs[0] > 0.0f);
+                logMessage((juce::String((juce::int64)viewSamples) + " samples")
+                               .paddedRight(' ', 20) +
+                           juce::String(elapsedMs, 3) + " ms");
+            }
+        }
+    }
+};
+
+static WaveformLodBenchmark waveformLodBenchmark;
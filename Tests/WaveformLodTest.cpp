@@ -0,0 +1,181 @@
+#include "Core/WaveformLod.h"
+#include "Utils/Config.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+// Mono reader whose samples are a constant level that changes every `segmentLength` samples.
+class SteppedMockReader : public juce::AudioFormatReader {
+  public:
+    SteppedMockReader(juce::int64 length, juce::int64 segmentLengthIn)
+        : juce::AudioFormatReader(nullptr, "SteppedMockReader"), segmentLength(segmentLengthIn) {
+        lengthInSamples = length;
+        numChannels = 1;
+        sampleRate = 48000.0;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    static float levelAt(juce::int64 sample, juce::int64 segmentLength) {
+        return (float)((sample / segmentLength) % 4 + 1) * 0.2f;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        ++numReads;
+        for (int ch = 0; ch < numDestChannels; ++ch) {
+            if (destSamples[ch] == nullptr)
+                continue;
+            float *dest = (float *)destSamples[ch] + startOffsetInDestBuffer;
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = levelAt(startSampleInFile + i, segmentLength);
+        }
+        return true;
+    }
+
+    int numReads{0};
+
+  private:
+    juce::int64 segmentLength;
+};
+
+class WaveformLodTest : public juce::UnitTest {
+  public:
+    WaveformLodTest() : juce::UnitTest("Waveform LOD Testing") {
+    }
+
+    void runTest() override {
+        const int baseBlock = Config::Audio::waveformLodBaseBlockSize;
+        const int chunk = Config::Audio::envelopeReadChunkSize;
+        // Two full decode chunks and a partial one, so every level ends with a partial block.
+        const int length = chunk * 2 + baseBlock * 3 + 5;
+
+        juce::AudioBuffer<float> buffer(2, length);
+        buffer.clear();
+        buffer.setSample(0, baseBlock * 9 + 3, 0.5f);
+        buffer.setSample(1, chunk + baseBlock * 2, -0.75f);
+        buffer.setSample(0, length - 1, 0.25f);
+
+        WaveformLod lod(2, length, 48000.0);
+
+        beginTest("Columns stay empty until their audio arrives");
+        {
+            lod.addBlock(0, buffer, chunk);
+            expectEquals(lod.getNumSamplesReady(), (juce::int64)chunk);
+            expectEquals(lod.getMinMax(0, 0, chunk).getEnd(), 0.5f);
+            expectEquals(lod.getMinMax(1, 0, length).getStart(), 0.0f);
+        }
+
+        juce::AudioBuffer<float> rest(2, length - chunk);
+        for (int channel = 0; channel < 2; ++channel)
+            rest.copyFrom(channel, 0, buffer, channel, chunk, length - chunk);
+        lod.addBlock(chunk, rest, length - chunk);
+
+        beginTest("Every level agrees with the audio");
+        {
+            expectEquals(lod.getNumSamplesReady(), (juce::int64)length);
+            expectEquals(lod.getMinMax(1, 0, length).getStart(), -0.75f);
+            expectEquals(lod.getMinMax(0, 0, length).getEnd(), 0.5f);
+            expectEquals(lod.getMinMax(0, length - 1, 1).getEnd(), 0.25f);
+            expectEquals(lod.getMinMax(0, baseBlock * 10, baseBlock).getEnd(), 0.0f);
+        }
+
+        beginTest("Columns pick up peaks at every zoom");
+        {
+            std::vector<float> mins(64), maxs(64);
+            // Fine columns: one base block each.
+            lod.getColumns(0, 0.0, baseBlock, 16, mins.data(), maxs.data());
+            expectEquals(maxs[9], 0.5f);
+            expectEquals(maxs[8], 0.0f);
+
+            // Coarse columns: the whole file in a few pixels.
+            lod.getColumns(1, 0.0, length / 4.0, 4, mins.data(), maxs.data());
+            float lowest = 0.0f;
+            for (int column = 0; column < 4; ++column)
+                lowest = juce::jmin(lowest, mins[(size_t)column]);
+            expectEquals(lowest, -0.75f);
+
+            // Columns past the end of the file are empty.
+            lod.getColumns(0, (double)length, baseBlock, 4, mins.data(), maxs.data());
+            expectEquals(maxs[0], 0.0f);
+        }
+
+        beginTest("Serialised pyramids round-trip and reject foreign data");
+        {
+            juce::MemoryBlock data;
+            lod.saveTo(data);
+            auto restored = WaveformLod::fromData(data);
+            expect(restored != nullptr);
+            if (restored != nullptr) {
+                expectEquals(restored->getNumSamplesReady(), (juce::int64)length);
+                expectEquals(restored->getMinMax(1, 0, length).getStart(), -0.75f);
+                expectEquals(restored->getSampleRate(), 48000.0);
+            }
+
+            juce::MemoryBlock truncated(data.getData(), data.getSize() - 4);
+            expect(WaveformLod::fromData(truncated) == nullptr);
+
+            juce::MemoryBlock corrupted(data);
+            static_cast<char *>(corrupted.getData())[0] = 'X';
+            expect(WaveformLod::fromData(corrupted) == nullptr);
+            expect(WaveformLod::fromData(juce::MemoryBlock()) == nullptr);
+        }
+
+        beginTest("The preview shows the whole file before the decode, coarse pass first");
+        {
+            const int coarseBlock = coarsestBlockSize();
+            const juce::int64 numBlocks = Config::Audio::waveformPreviewFirstPassProbes * 8;
+            const juce::int64 previewLength = numBlocks * coarseBlock;
+            // Each level lasts 16 coarse blocks, so even the first pass samples all four.
+            const juce::int64 segment = (juce::int64)coarseBlock * 16;
+            SteppedMockReader reader(previewLength, segment);
+            WaveformLod preview(1, previewLength, 48000.0);
+
+            std::vector<float> mins(8), maxs(8);
+            preview.getColumns(0, 0.0, (double)previewLength / 8.0, 8, mins.data(), maxs.data());
+            expectEquals(maxs[7], 0.0f);
+
+            std::vector<int> readsPerPass;
+            preview.buildPreview(reader, {}, [&] { readsPerPass.push_back(reader.numReads); });
+            expectEquals((int)readsPerPass.size(), Config::Audio::waveformPreviewNumPasses);
+            expectEquals(readsPerPass.front(), (int)numBlocks / 8);
+            expectEquals(readsPerPass.back(), (int)numBlocks);
+            expectEquals(preview.getNumSamplesReady(), (juce::int64)0);
+
+            // A column one segment wide sees exactly that segment's level.
+            preview.getColumns(0, (double)segment * 2, (double)segment, 1, mins.data(),
+                               maxs.data());
+            expectWithinAbsoluteError(maxs[0], 0.6f, 1.0e-6f);
+            expectWithinAbsoluteError(mins[0], 0.6f, 1.0e-6f);
+
+            // Decoded audio replaces the estimate.
+            juce::AudioBuffer<float> silence(1, chunk);
+            silence.clear();
+            preview.addBlock(0, silence, chunk);
+            preview.getColumns(0, 0.0, (double)chunk, 1, mins.data(), maxs.data());
+            expectEquals(maxs[0], 0.0f);
+        }
+
+        beginTest("A cancelled preview publishes nothing");
+        {
+            SteppedMockReader reader(length, baseBlock);
+            WaveformLod preview(1, length, 48000.0);
+            int passes = 0;
+            preview.buildPreview(reader, [] { return true; }, [&] { ++passes; });
+            expectEquals(passes, 0);
+            expectEquals(reader.numReads, 0);
+        }
+    }
+
+  private:
+    static int coarsestBlockSize() {
+        int blockSize = Config::Audio::waveformLodBaseBlockSize;
+        for (int level = 1; level < Config::Audio::waveformLodNumLevels; ++level)
+            blockSize *= Config::Audio::waveformLodLevelRatio;
+        return blockSize;
+    }
+};
+
+static WaveformLodTest waveformLodTest;